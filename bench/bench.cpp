@@ -0,0 +1,625 @@
+/*
+benchmarks for the hot paths of the game, build with 'make bench'. Results are written one json object per line to the
+-out file (default bench.json) so runs can be diffed or fed to a script, progress goes to stdout.
+
+usage: game_bench [-filter substring] [-min_time seconds] [-content dir] [-maps count] [-out filepath]
+
+every benchmark runs on a handful of synthetic worlds at different sizes and block densities, and then on the maps
+found in the content directory.
+*/
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+
+#include "log.h"
+#include "defines.h"
+#include "conversion.h"
+#include "world.h"
+#include "block_utils.h"
+#include "portal_exit.h"
+#include "map_format.h"
+#include "demo.h"
+#include "undo.h"
+#include "camera.h"
+#include "utils.h"
+#include "frame_arena.h"
+#include "solver.h"
+
+#define BENCH_DEFAULT_MIN_TIME 0.1
+#define BENCH_MAX_ITERATIONS (1 << 24)
+#define BENCH_MAX_NAME_LEN 128
+#define BENCH_SYNTHETIC_DEMO_ENTRIES 4096
+
+struct BenchOptions_t{
+     const char* filter = nullptr;
+     const char* content_dir = "content";
+     const char* out_filepath = "bench.json";
+     F64 min_time = BENCH_DEFAULT_MIN_TIME;
+     S32 max_maps = -1;
+};
+
+struct Bench_t{
+     BenchOptions_t options;
+     FILE* out = nullptr;
+     S32 run_count = 0;
+};
+
+// world plus everything a benchmark might want to cycle through between iterations
+struct BenchWorld_t{
+     char name[BENCH_MAX_NAME_LEN];
+     World_t world;
+     Undo_t undo;
+     Camera_t camera;
+     Coord_t player_start;
+     ObjectArray_t<S16> portals;
+     S32 cycle = 0;
+};
+
+typedef void BenchFunc_t(BenchWorld_t* bench_world);
+
+// keeps the optimizer from throwing away results we never look at
+static volatile S64 bench_sink = 0;
+
+static U32 bench_random_state = 0;
+
+static U32 bench_random(){
+     // xorshift, we only need the same sequence every run
+     bench_random_state ^= bench_random_state << 13;
+     bench_random_state ^= bench_random_state >> 17;
+     bench_random_state ^= bench_random_state << 5;
+     return bench_random_state;
+}
+
+static F64 bench_now(){
+     auto now = std::chrono::steady_clock::now().time_since_epoch();
+     return std::chrono::duration<F64>(now).count();
+}
+
+static void bench_write_json_string(FILE* file, const char* string){
+     fputc('"', file);
+     for(const char* c = string; *c; c++){
+          if(*c == '"' || *c == '\\') fputc('\\', file);
+          fputc(*c, file);
+     }
+     fputc('"', file);
+}
+
+static void bench_run(Bench_t* bench, const char* bench_name, BenchWorld_t* bench_world, BenchFunc_t* func){
+     if(bench->options.filter && !strstr(bench_name, bench->options.filter)) return;
+
+     // keep doubling the iterations until a batch takes long enough to trust the clock
+     S64 iterations = 1;
+     F64 elapsed = 0;
+     while(true){
+          F64 start = bench_now();
+          for(S64 i = 0; i < iterations; i++){
+               func(bench_world);
+               frame_arena_reset();
+          }
+          elapsed = bench_now() - start;
+
+          if(elapsed >= bench->options.min_time || iterations >= BENCH_MAX_ITERATIONS) break;
+          iterations *= 2;
+     }
+
+     F64 ns_per_iter = (elapsed * 1.0e9) / (F64)(iterations);
+
+     fprintf(bench->out, "{\"bench\":");
+     bench_write_json_string(bench->out, bench_name);
+     fprintf(bench->out, ",\"map\":");
+     bench_write_json_string(bench->out, bench_world->name);
+     fprintf(bench->out, ",\"width\":%d,\"height\":%d,\"blocks\":%d,\"interactives\":%d,\"iterations\":%ld,"
+             "\"total_ns\":%.0f,\"ns_per_iter\":%.2f}\n",
+             bench_world->world.tilemap.width, bench_world->world.tilemap.height, bench_world->world.blocks.count,
+             bench_world->world.interactives.count, (long)(iterations), elapsed * 1.0e9, ns_per_iter);
+     fflush(bench->out);
+
+     printf("%-28s %-32s %10ld iterations %14.2f ns/iter\n", bench_name, bench_world->name, (long)(iterations),
+            ns_per_iter);
+     bench->run_count++;
+}
+
+static S16 bench_cycle(BenchWorld_t* bench_world, S16 count){
+     if(count <= 0) return 0;
+     S16 index = (S16)(bench_world->cycle % count);
+     bench_world->cycle++;
+     return index;
+}
+
+// skips the dummy block at index 0 if the world has any other blocks
+static Block_t* bench_cycle_block(BenchWorld_t* bench_world){
+     World_t* world = &bench_world->world;
+     if(world->blocks.count <= 1) return world->blocks.count ? world->blocks.elements : nullptr;
+     return world->blocks.elements + 1 + bench_cycle(bench_world, world->blocks.count - 1);
+}
+
+static void bench_quad_tree_build(BenchWorld_t* bench_world){
+     auto* block_qt = quad_tree_build(&bench_world->world.blocks);
+     auto* interactive_qt = quad_tree_build(&bench_world->world.interactives);
+     bench_sink += (block_qt != nullptr) + (interactive_qt != nullptr);
+     quad_tree_free(block_qt);
+     quad_tree_free(interactive_qt);
+}
+
+static void bench_quad_tree_find_in(BenchWorld_t* bench_world){
+     Block_t* block = bench_cycle_block(bench_world);
+     if(!block) return;
+
+     Rect_t rect = rect_to_check_surrounding_blocks(block_center_pixel(block));
+     S16 block_count = 0;
+     Block_t* blocks[BLOCK_QUAD_TREE_MAX_QUERY];
+     quad_tree_find_in(bench_world->world.block_qt, rect, blocks, &block_count, BLOCK_QUAD_TREE_MAX_QUERY);
+     bench_sink += block_count;
+}
+
+static void bench_quad_tree_find_at(BenchWorld_t* bench_world){
+     TileMap_t* tilemap = &bench_world->world.tilemap;
+     S32 tile_count = (S32)(tilemap->width) * (S32)(tilemap->height);
+     S32 index = bench_world->cycle % tile_count;
+     bench_world->cycle++;
+
+     Interactive_t* interactive = quad_tree_find_at(bench_world->world.interactive_qt, (S16)(index % tilemap->width),
+                                                    (S16)(index / tilemap->width));
+     bench_sink += (interactive != nullptr);
+}
+
+static void bench_illuminate(BenchWorld_t* bench_world){
+     World_t* world = &bench_world->world;
+     reset_tilemap_light(world);
+     Coord_t center {(S16)(world->tilemap.width / 2), (S16)(world->tilemap.height / 2)};
+     illuminate(center, 255, world);
+     bench_sink += tilemap_tile(&world->tilemap, center.x, center.y)->light;
+}
+
+static void bench_find_portal_exits(BenchWorld_t* bench_world){
+     World_t* world = &bench_world->world;
+     S16 portal_index = bench_world->portals.elements[bench_cycle(bench_world, bench_world->portals.count)];
+     Interactive_t* portal = world->interactives.elements + portal_index;
+     PortalExit_t portal_exits = find_portal_exits(portal->coord, &world->tilemap, world->interactive_qt);
+     bench_sink += portal_exit_count(&portal_exits);
+}
+
+static void bench_check_block_collision(BenchWorld_t* bench_world){
+     Block_t* block = bench_cycle_block(bench_world);
+     if(!block) return;
+
+     // pretend the block is sliding a couple pixels to the right this frame
+     Block_t saved_block = *block;
+     block->pos_delta = Vec_t{PIXEL_SIZE * 2.0f, 0};
+     block->vel = Vec_t{PIXEL_SIZE * 2.0f, 0};
+     CheckBlockCollisionResult_t result = check_block_collision(&bench_world->world, block);
+     bench_sink += result.collided;
+     *block = saved_block;
+}
+
+static void bench_block_push(BenchWorld_t* bench_world){
+     Block_t* block = bench_cycle_block(bench_world);
+     if(!block) return;
+
+     Block_t saved_block = *block;
+     Direction_t direction = (Direction_t)(bench_world->cycle % DIRECTION_COUNT);
+     BlockPushResult_t result = block_push(block, direction, &bench_world->world, false, 1.0f, NULL, NULL, 1, false);
+     bench_sink += result.pushed;
+     *block = saved_block;
+}
+
+#define BENCH_POSITION_BATCH 256
+
+static Position_t bench_positions[BENCH_POSITION_BATCH];
+static Vec_t bench_position_deltas[BENCH_POSITION_BATCH];
+static Coord_t bench_position_coords[BENCH_POSITION_BATCH];
+
+// slide every block a fraction of a pixel like a frame of movement would, then find the tiles they ended up on
+static void bench_positions_batch(BenchWorld_t* bench_world){
+     World_t* world = &bench_world->world;
+     S32 count = MINIMUM(world->blocks.count, BENCH_POSITION_BATCH);
+     for(S32 i = 0; i < count; i++){
+          bench_positions[i] = world->blocks.elements[i].pos;
+          bench_position_deltas[i] = Vec_t{PIXEL_SIZE * 0.75f, -PIXEL_SIZE * 0.25f};
+     }
+
+     positions_add(bench_positions, bench_position_deltas, count);
+     pos_to_coords(bench_positions, bench_position_coords, count);
+     for(S32 i = 0; i < count; i++) bench_sink += bench_position_coords[i].x + bench_position_coords[i].y;
+}
+
+static void bench_undo_commit(BenchWorld_t* bench_world){
+     World_t* world = &bench_world->world;
+     Block_t* block = bench_cycle_block(bench_world);
+     if(!block) return;
+
+     // nudge a block each time so there is always something to diff
+     Block_t saved_block = *block;
+     block->pos.pixel.x += (bench_world->cycle & 1) ? 1 : -1;
+     undo_commit(&bench_world->undo, &world->players, &world->tilemap, &world->blocks, &world->interactives, true);
+     *block = saved_block;
+}
+
+static void bench_solver_hash_world(BenchWorld_t* bench_world){
+     bench_sink += (S64)(solver_hash_world(&bench_world->world));
+}
+
+static bool bench_destroy_world(World_t* world){
+     destroy(&world->tilemap);
+     destroy(&world->players);
+     destroy(&world->blocks);
+     destroy(&world->interactives);
+     destroy(&world->rooms);
+     destroy(&world->exits);
+     destroy(&world->awake_blocks);
+     quad_tree_free(world->interactive_qt);
+     quad_tree_free(world->block_qt);
+     world->interactive_qt = NULL;
+     world->block_qt = NULL;
+     return true;
+}
+
+static void bench_destroy(BenchWorld_t* bench_world){
+     bench_destroy_world(&bench_world->world);
+     destroy(&bench_world->undo);
+     destroy(&bench_world->portals);
+}
+
+static void bench_finish_world(BenchWorld_t* bench_world){
+     World_t* world = &bench_world->world;
+     reset_map(bench_world->player_start, world, &bench_world->undo, &bench_world->camera);
+
+     S16 portal_count = 0;
+     for(S16 i = 0; i < world->interactives.count; i++){
+          if(world->interactives.elements[i].type == INTERACTIVE_TYPE_PORTAL) portal_count++;
+     }
+
+     init(&bench_world->portals, portal_count);
+     portal_count = 0;
+     for(S16 i = 0; i < world->interactives.count; i++){
+          if(world->interactives.elements[i].type == INTERACTIVE_TYPE_PORTAL) bench_world->portals.elements[portal_count++] = i;
+     }
+}
+
+static void bench_add_portal(World_t* world, S16 index, Coord_t coord, Direction_t face){
+     Interactive_t* interactive = world->interactives.elements + index;
+     *interactive = {};
+     interactive->type = INTERACTIVE_TYPE_PORTAL;
+     interactive->coord = coord;
+     interactive->portal.face = face;
+     interactive->portal.on = true;
+}
+
+// a walled in room with blocks scattered across 'block_percent' of the floor and pressure plates on half as many tiles
+// as that again, the portals in the middle of each wall all face into the room so they are connected to each other
+static bool bench_build_synthetic_world(BenchWorld_t* bench_world, S16 size, S32 block_percent){
+     World_t* world = &bench_world->world;
+     snprintf(bench_world->name, BENCH_MAX_NAME_LEN, "synthetic_%dx%d_%d%%", size, size, block_percent);
+     bench_random_state = 0x1234567u + (U32)(size * 101 + block_percent);
+
+     if(!init(&world->tilemap, size, size)) return false;
+     for(S16 y = 0; y < size; y++){
+          for(S16 x = 0; x < size; x++){
+               if(x == 0 || y == 0 || x == size - 1 || y == size - 1){
+                    tilemap_tile(&world->tilemap, x, y)->flags |= TILE_FLAG_SOLID;
+               }
+          }
+     }
+     tilemap_build_flag_planes(&world->tilemap);
+
+     S32 floor_count = (S32)(size - 2) * (S32)(size - 2);
+     S32 block_count = (floor_count * block_percent) / 100;
+     S32 plate_count = block_count / 2;
+
+     // entry 0 of each array is a dummy that is out of the map, like in setup_default_room()
+     if(!init(&world->blocks, (S16)(block_count + 1))) return false;
+     if(!init(&world->interactives, (S16)(plate_count + 5))) return false;
+     init(&world->rooms, 0);
+     init(&world->exits, 0);
+
+     default_block(world->blocks.elements);
+     world->blocks.elements[0].pos = coord_to_pos(Coord_t{-1, -1});
+
+     world->interactives.elements[0] = {};
+     world->interactives.elements[0].coord = Coord_t{-1, -1};
+
+     S16 mid = size / 2;
+     bench_add_portal(world, 1, Coord_t{0, mid}, DIRECTION_RIGHT);
+     bench_add_portal(world, 2, Coord_t{(S16)(size - 1), mid}, DIRECTION_LEFT);
+     bench_add_portal(world, 3, Coord_t{mid, 0}, DIRECTION_UP);
+     bench_add_portal(world, 4, Coord_t{mid, (S16)(size - 1)}, DIRECTION_DOWN);
+
+     // deal floor tiles out without repeats so the densities are exact
+     S16* floor_coords = (S16*)(malloc(floor_count * sizeof(*floor_coords)));
+     if(!floor_coords){
+          LOG("%s() failed to allocate %d floor coords\n", __FUNCTION__, floor_count);
+          return false;
+     }
+     for(S32 i = 0; i < floor_count; i++) floor_coords[i] = (S16)(i);
+     for(S32 i = floor_count - 1; i > 0; i--){
+          S32 swap = (S32)(bench_random() % (U32)(i + 1));
+          S16 tmp = floor_coords[i];
+          floor_coords[i] = floor_coords[swap];
+          floor_coords[swap] = tmp;
+     }
+
+     S16 floor_width = size - 2;
+     for(S32 i = 0; i < block_count; i++){
+          Block_t* block = world->blocks.elements + 1 + i;
+          default_block(block);
+          block->pos = coord_to_pos(Coord_t{(S16)(1 + floor_coords[i] % floor_width), (S16)(1 + floor_coords[i] / floor_width)});
+          block->held_up = BLOCK_HELD_BY_FLOOR;
+          if((i % 4) == 0) block->element = ELEMENT_ICE;
+     }
+
+     for(S32 i = 0; i < plate_count; i++){
+          S32 floor_index = floor_coords[block_count + i];
+          Interactive_t* interactive = world->interactives.elements + 5 + i;
+          *interactive = {};
+          interactive->type = INTERACTIVE_TYPE_PRESSURE_PLATE;
+          interactive->coord = Coord_t{(S16)(1 + floor_index % floor_width), (S16)(1 + floor_index / floor_width)};
+     }
+
+     // the player starts on a free tile if there is one
+     S32 start_index = (block_count + plate_count < floor_count) ? floor_coords[block_count + plate_count] : 0;
+     bench_world->player_start = Coord_t{(S16)(1 + start_index % floor_width), (S16)(1 + start_index / floor_width)};
+     free(floor_coords);
+
+     bench_finish_world(bench_world);
+     return true;
+}
+
+static bool bench_load_world(BenchWorld_t* bench_world, const char* filepath){
+     World_t* world = &bench_world->world;
+     snprintf(bench_world->name, BENCH_MAX_NAME_LEN, "%s", filepath);
+     if(!load_map(filepath, &bench_world->player_start, &world->tilemap, &world->blocks, &world->interactives,
+                  &world->rooms, &world->exits)){
+          return false;
+     }
+     bench_finish_world(bench_world);
+     return true;
+}
+
+static void bench_world_runs(Bench_t* bench, BenchWorld_t* bench_world){
+     bench_run(bench, "quad_tree_build", bench_world, bench_quad_tree_build);
+     bench_run(bench, "quad_tree_find_in", bench_world, bench_quad_tree_find_in);
+     bench_run(bench, "quad_tree_find_at", bench_world, bench_quad_tree_find_at);
+     bench_run(bench, "illuminate", bench_world, bench_illuminate);
+     if(bench_world->portals.count) bench_run(bench, "find_portal_exits", bench_world, bench_find_portal_exits);
+     bench_run(bench, "check_block_collision", bench_world, bench_check_block_collision);
+     bench_run(bench, "block_push", bench_world, bench_block_push);
+     bench_run(bench, "undo_commit", bench_world, bench_undo_commit);
+     bench_run(bench, "solver_hash_world", bench_world, bench_solver_hash_world);
+     bench_run(bench, "positions_batch", bench_world, bench_positions_batch);
+}
+
+// load_map_from_file() is run against a copy of the map in a temporary file so every iteration reads the same bytes
+// regardless of which map version the original is
+static FILE* bench_map_tmpfile(BenchWorld_t* bench_world){
+     FILE* file = tmpfile();
+     if(!file){
+          LOG("%s() failed to create temporary file\n", __FUNCTION__);
+          return nullptr;
+     }
+
+     World_t* world = &bench_world->world;
+     if(!save_map_to_file(file, bench_world->player_start, &world->tilemap, &world->blocks, &world->interactives,
+                          &world->rooms, &world->exits, NULL, NULL)){
+          fclose(file);
+          return nullptr;
+     }
+     return file;
+}
+
+static FILE* bench_map_file = nullptr;
+
+static void bench_load_map_from_file(BenchWorld_t* bench_world){
+     World_t loaded {};
+     Coord_t player_start;
+     rewind(bench_map_file);
+     bool success = load_map_from_file(bench_map_file, &player_start, &loaded.tilemap, &loaded.blocks,
+                                       &loaded.interactives, &loaded.rooms, &loaded.exits, bench_world->name);
+     bench_sink += success + loaded.blocks.count;
+     bench_destroy_world(&loaded);
+}
+
+static void bench_load_map(Bench_t* bench, BenchWorld_t* bench_world){
+     if(bench->options.filter && !strstr("load_map_from_file", bench->options.filter)) return;
+
+     bench_map_file = bench_map_tmpfile(bench_world);
+     if(!bench_map_file) return;
+     bench_run(bench, "load_map_from_file", bench_world, bench_load_map_from_file);
+     fclose(bench_map_file);
+     bench_map_file = nullptr;
+}
+
+static FILE* bench_demo_file = nullptr;
+static S32 bench_demo_version = 0;
+static long bench_demo_entries_offset = 0;
+
+static void bench_demo_entries_get(BenchWorld_t*){
+     fseek(bench_demo_file, bench_demo_entries_offset, SEEK_SET);
+     DemoEntries_t entries = demo_entries_get(bench_demo_file, bench_demo_version);
+     bench_sink += entries.count;
+     free(entries.entries);
+}
+
+static void bench_demo(Bench_t* bench, BenchWorld_t* bench_world, FILE* file){
+     bench_demo_file = file;
+     rewind(bench_demo_file);
+     if(fread(&bench_demo_version, sizeof(bench_demo_version), 1, bench_demo_file) != 1){
+          LOG("%s() failed to read demo version of %s\n", __FUNCTION__, bench_world->name);
+          return;
+     }
+     bench_demo_entries_offset = ftell(bench_demo_file);
+     bench_run(bench, "demo_entries_get", bench_world, bench_demo_entries_get);
+     bench_demo_file = nullptr;
+}
+
+static void bench_synthetic_demo(Bench_t* bench, BenchWorld_t* bench_world){
+     if(bench->options.filter && !strstr("demo_entries_get", bench->options.filter)) return;
+
+     Demo_t demo {};
+     demo.mode = DEMO_MODE_RECORD;
+     demo.version = DEMO_VERSION;
+     demo.file = tmpfile();
+     if(!demo.file){
+          LOG("%s() failed to create temporary file\n", __FUNCTION__);
+          return;
+     }
+     fwrite(&demo.version, sizeof(demo.version), 1, demo.file);
+
+     // alternate starting and stopping moves every few frames like a player would, then end the demo which flushes
+     bench_random_state = 0x89abcdefu;
+     S64 frame = 0;
+     for(S32 i = 0; i < BENCH_SYNTHETIC_DEMO_ENTRIES; i++){
+          frame += 1 + (bench_random() % 20);
+          DemoEntry_t entry {frame, (PlayerActionType_t)(bench_random() % PLAYER_ACTION_TYPE_END_DEMO)};
+          demo_write_entry(&demo, &entry);
+     }
+     DemoEntry_t end_entry {frame + 1, PLAYER_ACTION_TYPE_END_DEMO};
+     demo_write_entry(&demo, &end_entry);
+     demo_flush(&demo);
+
+     snprintf(bench_world->name, BENCH_MAX_NAME_LEN, "synthetic_demo_%d_entries", BENCH_SYNTHETIC_DEMO_ENTRIES + 1);
+     bench_demo(bench, bench_world, demo.file);
+     fclose(demo.file);
+}
+
+static bool bench_has_extension(const char* filename, const char* extension){
+     size_t filename_len = strlen(filename);
+     size_t extension_len = strlen(extension);
+     if(filename_len < extension_len) return false;
+     return strcmp(filename + filename_len - extension_len, extension) == 0;
+}
+
+static int bench_compare_strings(const void* a, const void* b){
+     return strcmp(*(const char**)(a), *(const char**)(b));
+}
+
+// sorted so runs on different machines cover the maps in the same order
+static S32 bench_find_content(const char* content_dir, const char* extension, char*** filepaths){
+     *filepaths = nullptr;
+     DIR* dir = opendir(content_dir);
+     if(!dir) return 0;
+
+     S32 count = 0;
+     S32 capacity = 0;
+     while(struct dirent* entry = readdir(dir)){
+          if(!bench_has_extension(entry->d_name, extension)) continue;
+          if(count >= capacity){
+               capacity = capacity ? capacity * 2 : 64;
+               char** new_filepaths = (char**)(realloc(*filepaths, capacity * sizeof(**filepaths)));
+               if(!new_filepaths) break;
+               *filepaths = new_filepaths;
+          }
+          size_t len = strlen(content_dir) + strlen(entry->d_name) + 2;
+          char* filepath = (char*)(malloc(len));
+          snprintf(filepath, len, "%s/%s", content_dir, entry->d_name);
+          (*filepaths)[count++] = filepath;
+     }
+     closedir(dir);
+
+     if(count) qsort(*filepaths, count, sizeof(**filepaths), bench_compare_strings);
+     return count;
+}
+
+static void bench_free_content(char** filepaths, S32 count){
+     for(S32 i = 0; i < count; i++) free(filepaths[i]);
+     free(filepaths);
+}
+
+int main(int argc, char** argv){
+     Bench_t bench {};
+
+     for(int i = 1; i < argc; i++){
+          int next = i + 1;
+          if(strcmp(argv[i], "-filter") == 0){
+               if(next >= argc) continue;
+               bench.options.filter = argv[next];
+               i++;
+          }else if(strcmp(argv[i], "-min_time") == 0){
+               if(next >= argc) continue;
+               bench.options.min_time = atof(argv[next]);
+               i++;
+          }else if(strcmp(argv[i], "-content") == 0){
+               if(next >= argc) continue;
+               bench.options.content_dir = argv[next];
+               i++;
+          }else if(strcmp(argv[i], "-maps") == 0){
+               if(next >= argc) continue;
+               bench.options.max_maps = atoi(argv[next]);
+               i++;
+          }else if(strcmp(argv[i], "-out") == 0){
+               if(next >= argc) continue;
+               bench.options.out_filepath = argv[next];
+               i++;
+          }else{
+               printf("unknown option %s\n", argv[i]);
+               printf("usage: %s [-filter substring] [-min_time seconds] [-content dir] [-maps count] [-out filepath]\n",
+                      argv[0]);
+               return 1;
+          }
+     }
+
+     if(!Log_t::create("bench.log")){
+          return 1;
+     }
+
+     bench.out = fopen(bench.options.out_filepath, "w");
+     if(!bench.out){
+          LOG("failed to open %s for writing results\n", bench.options.out_filepath);
+          Log_t::destroy();
+          return 1;
+     }
+
+     const S16 synthetic_sizes[] = {32, 128};
+     const S32 synthetic_block_percents[] = {5, 25, 50};
+     for(auto size : synthetic_sizes){
+          for(auto block_percent : synthetic_block_percents){
+               BenchWorld_t bench_world {};
+               if(bench_build_synthetic_world(&bench_world, size, block_percent)){
+                    bench_world_runs(&bench, &bench_world);
+                    bench_load_map(&bench, &bench_world);
+               }
+               bench_destroy(&bench_world);
+          }
+     }
+
+     {
+          BenchWorld_t bench_world {};
+          bench_synthetic_demo(&bench, &bench_world);
+     }
+
+     char** map_filepaths = nullptr;
+     S32 map_file_count = bench_find_content(bench.options.content_dir, ".bm", &map_filepaths);
+     S32 map_count = map_file_count;
+     if(bench.options.max_maps >= 0 && map_count > bench.options.max_maps) map_count = bench.options.max_maps;
+     for(S32 i = 0; i < map_count; i++){
+          BenchWorld_t bench_world {};
+          if(bench_load_world(&bench_world, map_filepaths[i])){
+               bench_world_runs(&bench, &bench_world);
+               bench_load_map(&bench, &bench_world);
+          }
+          bench_destroy(&bench_world);
+     }
+     bench_free_content(map_filepaths, map_file_count);
+
+     char** demo_filepaths = nullptr;
+     S32 demo_file_count = bench_find_content(bench.options.content_dir, ".bd", &demo_filepaths);
+     S32 demo_count = demo_file_count;
+     if(bench.options.max_maps >= 0 && demo_count > bench.options.max_maps) demo_count = bench.options.max_maps;
+     for(S32 i = 0; i < demo_count; i++){
+          FILE* file = fopen(demo_filepaths[i], "rb");
+          if(!file) continue;
+          BenchWorld_t bench_world {};
+          snprintf(bench_world.name, BENCH_MAX_NAME_LEN, "%s", demo_filepaths[i]);
+          bench_demo(&bench, &bench_world, file);
+          fclose(file);
+     }
+     bench_free_content(demo_filepaths, demo_file_count);
+
+     printf("%d benchmarks written to %s\n", bench.run_count, bench.options.out_filepath);
+
+     fclose(bench.out);
+     Log_t::destroy();
+     return 0;
+}
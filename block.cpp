@@ -5,6 +5,15 @@
 
 #include <cstring>
 
+BlockHandle_t block_handle(ObjectArray_t<Block_t>* blocks, Block_t* block){
+     if(!block) return BlockHandle_t{};
+     return object_handle(blocks, (S16)(block - blocks->elements));
+}
+
+Block_t* block_from_handle(ObjectArray_t<Block_t>* blocks, BlockHandle_t handle){
+     return object_from_handle(blocks, handle);
+}
+
 void default_block(Block_t* block){
      memset(block, 0, sizeof(*block));
      block->entangle_index = -1;
@@ -374,30 +383,6 @@ const char* block_corner_to_string(BlockCorner_t corner){
      return "BLOCK_CORNER_UNKNOWN";
 }
 
-void block_add_horizontal_momentum(Block_t* block, BlockMomentumType_t type, F32 momentum){
-     if(block->horizontal_momentum == BLOCK_MOMENTUM_NONE){
-          block->horizontal_momentum = BLOCK_MOMENTUM_SUM;
-     }
-
-     if(type == BLOCK_MOMENTUM_TYPE_IMPACT){
-          block->impact_momentum.x += momentum;
-     }else if(type == BLOCK_MOMENTUM_TYPE_KICKBACK){
-          block->kickback_momentum.x += momentum;
-     }
-}
-
-void block_add_vertical_momentum(Block_t* block, BlockMomentumType_t type, F32 momentum){
-     if(block->vertical_momentum == BLOCK_MOMENTUM_NONE){
-          block->vertical_momentum = BLOCK_MOMENTUM_SUM;
-     }
-
-     if(type == BLOCK_MOMENTUM_TYPE_IMPACT){
-          block->impact_momentum.y += momentum;
-     }else if(type == BLOCK_MOMENTUM_TYPE_KICKBACK){
-          block->kickback_momentum.y += momentum;
-     }
-}
-
 bool block_equal(Block_t* a, Block_t* b){
      return (a->pos.pixel == b->pos.pixel &&
              a->pos.z == b->pos.z &&
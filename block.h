@@ -9,6 +9,7 @@
 #include "coord.h"
 #include "rect.h"
 #include "carried_pos_delta.h"
+#include "object_array.h"
 
 enum BlockCoast_t{
      BLOCK_COAST_NONE,
@@ -105,8 +106,19 @@ struct Block_t : public GridMotion_t{
      Vec_t kickback_momentum;
 
      bool over_pit = false;
+
+     // blocks at rest for BLOCK_SLEEP_FRAMES frames are skipped by the simulation until something wakes them up
+     bool asleep = false;
+     S8 rest_frames = 0;
 };
 
+// compact reference to a block in the world's block array, it survives the array being resized and goes stale instead
+// of dangling when the block, or the last block that remove() moved into its place, is removed
+using BlockHandle_t = ObjectHandle_t;
+
+BlockHandle_t block_handle(ObjectArray_t<Block_t>* blocks, Block_t* block);
+Block_t* block_from_handle(ObjectArray_t<Block_t>* blocks, BlockHandle_t handle);
+
 void default_block(Block_t* block);
 S16 get_object_x(Block_t* block);
 S16 get_object_y(Block_t* block);
@@ -168,15 +180,13 @@ Direction_t block_axis_move(Block_t* block, bool x);
 
 const char* block_corner_to_string(BlockCorner_t corner);
 
-void block_add_horizontal_momentum(Block_t* block, BlockMomentumType_t type, F32 momentum);
-void block_add_vertical_momentum(Block_t* block, BlockMomentumType_t type, F32 momentum);
 
 bool block_equal(Block_t* a, Block_t* b);
 
 #define MAX_BLOCKS_IN_LIST 128
 
 struct BlockEntry_t{
-     Block_t* block = nullptr;
+     BlockHandle_t block;
      S8 rotations_through_portal = 0;
      bool counted = false;
 };
@@ -185,7 +195,7 @@ struct BlockList_t{
      BlockEntry_t entries[MAX_BLOCKS_IN_LIST];
      S16 count = 0;
 
-     bool add(Block_t* block, S8 rotations_through_portal){
+     bool add(BlockHandle_t block, S8 rotations_through_portal){
           if(count >= MAX_BLOCKS_IN_LIST) return false;
           entries[count].block = block;
           entries[count].rotations_through_portal = rotations_through_portal;
@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <math.h>
 #include <float.h>
+#include <string.h>
 
 struct VecMaskCollisionEntry_t{
      S8 mask;
@@ -47,14 +48,22 @@ static int sort_collision_by_time_comparer(const void* a, const void* b){
 }
 
 bool CheckBlockCollisions_t::init(S32 block_count){
-    collisions = (CheckBlockCollisionResult_t*)malloc(block_count * block_count * sizeof(*collisions));
+    collisions = frame_arena_alloc_array<CheckBlockCollisionResult_t>(block_count);
     if(collisions == NULL) return false;
     allocated = block_count;
     return true;
 }
 
+// blocks can be added mid pass when they are split across a portal, so block_count at init is only a starting size
 bool CheckBlockCollisions_t::add_collision(CheckBlockCollisionResult_t* collision){
-    if(count >= allocated) return false;
+    if(count >= allocated){
+         S32 new_allocated = allocated ? allocated * 2 : 8;
+         auto* new_collisions = frame_arena_alloc_array<CheckBlockCollisionResult_t>(new_allocated);
+         if(new_collisions == NULL) return false;
+         if(count) memcpy(new_collisions, collisions, count * sizeof(*collisions));
+         collisions = new_collisions;
+         allocated = new_allocated;
+    }
     collisions[count] = *collision;
     count++;
     return true;
@@ -65,7 +74,7 @@ void CheckBlockCollisions_t::reset(){
 }
 
 void CheckBlockCollisions_t::clear(){
-    free(collisions);
+    // the collisions belong to the frame arena
     collisions = NULL;
     count = 0;
     allocated = 0;
@@ -9,7 +9,7 @@
 #include <math.h>
 #include <string.h>
 
-void add_block_held(BlockHeldResult_t* result, Block_t* block, Rect_t rect){
+void add_block_held(BlockHeldResult_t* result, BlockHandle_t block, Rect_t rect){
      if(result->count < MAX_HELD_BLOCKS){
           result->blocks_held[result->count].block = block;
           result->blocks_held[result->count].rect = rect;
@@ -182,7 +182,8 @@ Block_t* block_against_block_in_list(Position_t pos, BlockCut_t cut, Block_t** b
 }
 
 BlockAgainstOthersResult_t block_against_other_blocks(Position_t pos, BlockCut_t cut, Direction_t direction, QuadTreeNode_t<Block_t>* block_qt,
-                                                      QuadTreeNode_t<Interactive_t>* interactive_qt, TileMap_t* tilemap, bool require_portal_on){
+                                                      ObjectArray_t<Block_t>* blocks_array, QuadTreeNode_t<Interactive_t>* interactive_qt,
+                                                      TileMap_t* tilemap, bool require_portal_on){
      BlockAgainstOthersResult_t result;
 
      auto block_center = block_get_center(pos, cut);
@@ -199,7 +200,7 @@ BlockAgainstOthersResult_t block_against_other_blocks(Position_t pos, BlockCut_t
           // lol at me misusing this function, but watevs
           if(block_against_block_in_list(pos, cut, blocks + i, 1, direction, portal_offsets)){
                BlockAgainstOther_t against_other {};
-               against_other.block = blocks[i];
+               against_other.block = block_handle(blocks_array, blocks[i]);
                result.insert(&against_other);
           }
      }
@@ -212,7 +213,7 @@ BlockAgainstOthersResult_t block_against_other_blocks(Position_t pos, BlockCut_t
 
          if(block_against_block(pos, cut, blocks[i], found_block->rotated_cut, direction, portal_offsets[i])){
               BlockAgainstOther_t against_other {};
-              against_other.block = blocks[i];
+              against_other.block = block_handle(blocks_array, blocks[i]);
               against_other.rotations_through_portal = found_block->rotations_between_portals;
               against_other.through_portal = true;
               result.insert(&against_other);
@@ -222,8 +223,41 @@ BlockAgainstOthersResult_t block_against_other_blocks(Position_t pos, BlockCut_t
      return result;
 }
 
+// looks from the block's final position, while the block query cache is active the answer is kept as edges in the
+// touching block graph so each block and direction is only looked up once per cache scope
+BlockAgainstOthersResult_t block_against_other_blocks(Block_t* block, Direction_t direction, World_t* world){
+     auto* cache = &world->block_query_cache;
+     S32 index = block - world->blocks.elements;
+     bool use_graph = cache->against_counts && index >= 0 && index < cache->block_count && direction < DIRECTION_COUNT;
+     S32 edges_index = index * DIRECTION_COUNT + direction;
+
+     BlockAgainstOthersResult_t result;
+
+     if(use_graph && cache->against_counts[edges_index] >= 0){
+          BlockAgainstOther_t* edges = cache->againsts + edges_index * MAX_BLOCKS_AGAINST_BLOCK;
+          for(S8 i = 0; i < cache->against_counts[edges_index]; i++){
+               result.insert(edges + i);
+          }
+          return result;
+     }
+
+     result = block_against_other_blocks(block_get_final_position(block), block_get_cut(block), direction, world->block_qt,
+                                         &world->blocks, world->interactive_qt, &world->tilemap);
+
+     if(use_graph){
+          BlockAgainstOther_t* edges = cache->againsts + edges_index * MAX_BLOCKS_AGAINST_BLOCK;
+          for(S16 i = 0; i < result.count; i++){
+               edges[i] = result.objects[i];
+          }
+          cache->against_counts[edges_index] = (S8)(result.count);
+     }
+
+     return result;
+}
+
 BlockAgainstOther_t block_diagonally_against_block(Position_t pos, BlockCut_t cut, DirectionMask_t directions, TileMap_t* tilemap,
-                                                   QuadTreeNode_t<Interactive_t>* interactive_qt, QuadTreeNode_t<Block_t>* block_qt){
+                                                   QuadTreeNode_t<Interactive_t>* interactive_qt, QuadTreeNode_t<Block_t>* block_qt,
+                                                   ObjectArray_t<Block_t>* blocks_array){
      BlockAgainstOther_t result {};
      Pixel_t pixel_to_check;
      BlockCorner_t corner_to_check;
@@ -261,7 +295,7 @@ BlockAgainstOther_t block_diagonally_against_block(Position_t pos, BlockCut_t cu
      for(S16 i = 0; i < block_count; i++){
           Pixel_t corner_pixel = block_get_corner_pixel(blocks[i], corner_to_check);
           if(corner_pixel == pixel_to_check){
-               result.block = blocks[i];
+               result.block = block_handle(blocks_array, blocks[i]);
                return result;
           }
      }
@@ -273,7 +307,7 @@ BlockAgainstOther_t block_diagonally_against_block(Position_t pos, BlockCut_t cu
           BlockCut_t rotated_cut = block_cut_rotate_clockwise(found_block_cut, found_block->portal_rotations);
           Pixel_t corner_pixel = block_get_corner_pixel(found_block->position.pixel, rotated_cut, corner_to_check);
           if(corner_pixel == pixel_to_check){
-               result.block = found_block->block;
+               result.block = block_handle(blocks_array, found_block->block);
                result.rotations_through_portal = found_block->portal_rotations;
                result.through_portal = true;
                return result;
@@ -840,8 +874,9 @@ InteractiveHeldResult_t block_held_up_by_popup(Position_t block_pos, BlockCut_t
      return result;
 }
 
+// blocks_array may be NULL if the caller only cares about the rects, the handles are left invalid then
 static BlockHeldResult_t block_at_height_in_block_rect(Pixel_t block_to_check_pixel, BlockCut_t cut, QuadTreeNode_t<Block_t>* block_qt,
-                                                       S8 expected_height, QuadTreeNode_t<Interactive_t>* interactive_qt,
+                                                       ObjectArray_t<Block_t>* blocks_array, S8 expected_height, QuadTreeNode_t<Interactive_t>* interactive_qt,
                                                        TileMap_t* tilemap, S16 min_area = 0, bool include_pos_delta = true){
      BlockHeldResult_t result;
 
@@ -869,7 +904,7 @@ static BlockHeldResult_t block_at_height_in_block_rect(Pixel_t block_to_check_pi
                auto block_rect = block_get_inclusive_rect(block_pos.pixel, block_cut);
                auto intserection_area = rect_intersecting_area(block_rect, check_rect);
                if(intserection_area >= min_area){
-                    add_block_held(&result, block, block_rect);
+                    add_block_held(&result, block_handle(blocks_array, block), block_rect);
                }
           }
      }
@@ -889,7 +924,7 @@ static BlockHeldResult_t block_at_height_in_block_rect(Pixel_t block_to_check_pi
               auto block_rect = block_get_inclusive_rect(found_block->position.pixel, found_block->rotated_cut);
               auto intserection_area = rect_intersecting_area(block_rect, check_rect);
               if(intserection_area >= min_area){
-                   add_block_held(&result, found_block->block, block_rect);
+                   add_block_held(&result, block_handle(blocks_array, found_block->block), block_rect);
               }
          }
      }
@@ -897,44 +932,44 @@ static BlockHeldResult_t block_at_height_in_block_rect(Pixel_t block_to_check_pi
      return result;
 }
 
-BlockHeldResult_t block_held_up_by_another_block(Block_t* block, QuadTreeNode_t<Block_t>* block_qt,
+BlockHeldResult_t block_held_up_by_another_block(Block_t* block, QuadTreeNode_t<Block_t>* block_qt, ObjectArray_t<Block_t>* blocks_array,
                                                  QuadTreeNode_t<Interactive_t>* interactive_qt, TileMap_t* tilemap, S16 min_area){
      if(block->teleport){
           auto final_pos = block->teleport_pos + block->teleport_pos_delta;
           final_pos.pixel.x = passes_over_pixel(block->teleport_pos.pixel.x, final_pos.pixel.x);
           final_pos.pixel.y = passes_over_pixel(block->teleport_pos.pixel.y, final_pos.pixel.y);
-          return block_at_height_in_block_rect(final_pos.pixel, block->teleport_cut, block_qt,
+          return block_at_height_in_block_rect(final_pos.pixel, block->teleport_cut, block_qt, blocks_array,
                                                block->teleport_pos.z - HEIGHT_INTERVAL, interactive_qt, tilemap, min_area);
      }
 
      auto final_pos = block->pos + block->pos_delta;
      final_pos.pixel.x = passes_over_pixel(block->pos.pixel.x, final_pos.pixel.x);
      final_pos.pixel.y = passes_over_pixel(block->pos.pixel.y, final_pos.pixel.y);
-     return block_at_height_in_block_rect(final_pos.pixel, block->cut, block_qt,
+     return block_at_height_in_block_rect(final_pos.pixel, block->cut, block_qt, blocks_array,
                                           block->pos.z - HEIGHT_INTERVAL, interactive_qt, tilemap, min_area);
 }
 
-BlockHeldResult_t block_held_down_by_another_block(Block_t* block, QuadTreeNode_t<Block_t>* block_qt,
+BlockHeldResult_t block_held_down_by_another_block(Block_t* block, QuadTreeNode_t<Block_t>* block_qt, ObjectArray_t<Block_t>* blocks_array,
                                                    QuadTreeNode_t<Interactive_t>* interactive_qt, TileMap_t* tilemap, S16 min_area){
      if(block->teleport){
           auto final_pos = block->teleport_pos + block->teleport_pos_delta;
           final_pos.pixel.x = passes_over_pixel(block->teleport_pos.pixel.x, final_pos.pixel.x);
           final_pos.pixel.y = passes_over_pixel(block->teleport_pos.pixel.y, final_pos.pixel.y);
-          return block_at_height_in_block_rect(final_pos.pixel, block->teleport_cut, block_qt,
+          return block_at_height_in_block_rect(final_pos.pixel, block->teleport_cut, block_qt, blocks_array,
                                                block->teleport_pos.z + HEIGHT_INTERVAL, interactive_qt, tilemap, min_area);
      }
 
      auto final_pos = block->pos + block->pos_delta;
      final_pos.pixel.x = passes_over_pixel(block->pos.pixel.x, final_pos.pixel.x);
      final_pos.pixel.y = passes_over_pixel(block->pos.pixel.y, final_pos.pixel.y);
-     return block_at_height_in_block_rect(final_pos.pixel, block->cut, block_qt,
+     return block_at_height_in_block_rect(final_pos.pixel, block->cut, block_qt, blocks_array,
                                           block->pos.z + HEIGHT_INTERVAL, interactive_qt, tilemap, min_area);
 }
 
 BlockHeldResult_t block_held_down_by_another_block(Pixel_t block_pixel, S8 block_z, BlockCut_t cut, QuadTreeNode_t<Block_t>* block_qt,
-                                                   QuadTreeNode_t<Interactive_t>* interactive_qt, TileMap_t* tilemap,
-                                                   S16 min_area, bool include_pos_delta){
-     return block_at_height_in_block_rect(block_pixel, cut, block_qt, block_z + HEIGHT_INTERVAL, interactive_qt, tilemap, min_area, include_pos_delta);
+                                                   ObjectArray_t<Block_t>* blocks_array, QuadTreeNode_t<Interactive_t>* interactive_qt,
+                                                   TileMap_t* tilemap, S16 min_area, bool include_pos_delta){
+     return block_at_height_in_block_rect(block_pixel, cut, block_qt, blocks_array, block_z + HEIGHT_INTERVAL, interactive_qt, tilemap, min_area, include_pos_delta);
 }
 
 bool block_on_ice(Position_t pos, Vec_t pos_delta, BlockCut_t cut, TileMap_t* tilemap, QuadTreeNode_t<Interactive_t>* interactive_qt,
@@ -989,7 +1024,7 @@ bool block_on_ice(Block_t* block, TileMap_t* tilemap, QuadTreeNode_t<Interactive
 static bool block_held_up_otherwise_on_air(Position_t pos, Vec_t pos_delta, BlockCut_t cut, TileMap_t* tilemap, QuadTreeNode_t<Interactive_t>* interactive_qt, QuadTreeNode_t<Block_t>* block_qt){
      auto final_pos = pos + pos_delta;
      auto block_center = block_center_pixel(final_pos, cut);
-     auto block_result = block_at_height_in_block_rect(final_pos.pixel, cut, block_qt,
+     auto block_result = block_at_height_in_block_rect(final_pos.pixel, cut, block_qt, NULL,
                                                        final_pos.z - HEIGHT_INTERVAL, interactive_qt, tilemap);
      for(S16 i = 0; i < block_result.count; i++){
           if(pixel_in_rect(block_center, block_result.blocks_held[i].rect)) return false;
@@ -1696,8 +1731,8 @@ TransferMomentum_t get_block_push_pusher_momentum(BlockMomentumPush_t* push, Wor
      return result;
 }
 
-BlockCollisionPushResult_t block_collision_push(BlockMomentumPush_t* push, World_t* world){
-     BlockCollisionPushResult_t result;
+void block_collision_push(BlockMomentumPush_t* push, World_t* world, BlockCollisionPushResult_t* result){
+     result->additional_block_pushes.clear();
 
      S8 total_push_rotations = (push->portal_rotations + push->entangle_rotations) % DIRECTION_COUNT;
 
@@ -1758,7 +1793,7 @@ BlockCollisionPushResult_t block_collision_push(BlockMomentumPush_t* push, World
           // go forward in the chain (towards the block we pushed) finding blocks that are going in the same direction as the chain, because we want those to
           // receive the force before the pusher
           Direction_t forward_chain_direction_to_check = pusher_direction;
-          auto chain_results = find_block_chain(block_receiving_force, forward_chain_direction_to_check, world->block_qt, world->interactive_qt, &world->tilemap, 0, nullptr);
+          auto chain_results = find_block_chain(block_receiving_force, forward_chain_direction_to_check, world, 0, nullptr);
           // TODO: handle across multiple chains
           if(chain_results.count > 0 && chain_results.objects[0].count > 0){
                // skip the first block, which is our pusher, and do not go all the way to the end of the chain,
@@ -1797,7 +1832,7 @@ BlockCollisionPushResult_t block_collision_push(BlockMomentumPush_t* push, World
           direction_to_check = direction_opposite(forward_chain_direction_to_check);
 
           // search backward in the chain to figure out which block absorbs the momentum kickback
-          chain_results = find_block_chain(block_receiving_force, direction_to_check, world->block_qt, world->interactive_qt, &world->tilemap, 0, nullptr);
+          chain_results = find_block_chain(block_receiving_force, direction_to_check, world, 0, nullptr);
           // TODO: handle across multiple chains
           if(chain_results.count > 0 && chain_results.objects[0].count > 0){
                // LOG("searching %s (backward) started at block %ld seeing chain %d blocks long\n", direction_to_string(direction_to_check),
@@ -1839,6 +1874,7 @@ BlockCollisionPushResult_t block_collision_push(BlockMomentumPush_t* push, World
           S16 block_receiving_force_index = get_block_index(world, block_receiving_force);
 
           if(push_result.collisions.count == 0 && !push_result.pushed){
+              world_wake_block(world, block_receiving_force_index);
               if(direction_is_horizontal(direction_to_check)){
                    // LOG("stopping block %d horizontally via kickback momentum\n", block_receiving_force_index);
                    block_receiving_force->horizontal_momentum = BLOCK_MOMENTUM_STOP;
@@ -1895,10 +1931,10 @@ BlockCollisionPushResult_t block_collision_push(BlockMomentumPush_t* push, World
               if(fabs(block_receiving_force_momentum.vel - elastic_result.first_final_velocity) >= FLT_EPSILON){
                    if(direction_is_horizontal(direction_to_check)){
                         // LOG("giving block %d: %f horizontal kickback momentum\n", block_receiving_force_index, (F32)(mass) * elastic_result.first_final_velocity);
-                        block_add_horizontal_momentum(block_receiving_force, BLOCK_MOMENTUM_TYPE_KICKBACK, (F32)(mass) * elastic_result.first_final_velocity);
+                        block_add_horizontal_momentum(world, block_receiving_force, BLOCK_MOMENTUM_TYPE_KICKBACK, (F32)(mass) * elastic_result.first_final_velocity);
                    }else{
                         // LOG("giving block %d: %f vertical kickback momentum\n", block_receiving_force_index, (F32)(mass) * elastic_result.first_final_velocity);
-                        block_add_vertical_momentum(block_receiving_force, BLOCK_MOMENTUM_TYPE_KICKBACK, (F32)(mass) * elastic_result.first_final_velocity);
+                        block_add_vertical_momentum(world, block_receiving_force, BLOCK_MOMENTUM_TYPE_KICKBACK, (F32)(mass) * elastic_result.first_final_velocity);
                    }
               }
           }
@@ -1908,8 +1944,6 @@ BlockCollisionPushResult_t block_collision_push(BlockMomentumPush_t* push, World
                push->pushers[p].momentum_kicked_back_in_shared_push_block_index = block_receiving_force - world->blocks.elements;
           }
      }
-
-     return result;
 }
 
 FindBlocksThroughPortalResult_t find_blocks_through_portals(Coord_t coord, TileMap_t* tilemap, QuadTreeNode_t<Interactive_t>* interactive_qt, QuadTreeNode_t<Block_t>* block_qt,
@@ -2000,15 +2034,10 @@ FindBlocksThroughPortalResult_t find_blocks_through_portals(Coord_t coord, TileM
      return result;
 }
 
-BlockChainsResult_t find_block_chain(Block_t* block, Direction_t direction, QuadTreeNode_t<Block_t>* block_qt,
-                                     QuadTreeNode_t<Interactive_t>* interactive_qt, TileMap_t* tilemap, S8 rotations, BlockChain_t* my_chain){
+BlockChainsResult_t find_block_chain(Block_t* block, Direction_t direction, World_t* world, S8 rotations, BlockChain_t* my_chain){
      BlockChainsResult_t result;
 
-     Position_t block_pos = block_get_position(block);
-     Vec_t block_pos_delta = block_get_pos_delta(block);
-     auto block_cut = block_get_cut(block);
-
-     auto against_result = block_against_other_blocks(block_pos + block_pos_delta, block_cut, direction, block_qt, interactive_qt, tilemap);
+     auto against_result = block_against_other_blocks(block, direction, world);
 
      BlockChain_t first_chain {};
 
@@ -2024,6 +2053,7 @@ BlockChainsResult_t find_block_chain(Block_t* block, Direction_t direction, Quad
 
      for(S16 i = 0; i < against_result.count; i++){
           BlockAgainstOther_t* against_entry = against_result.objects + i;
+          Block_t* against_block = block_from_handle(&world->blocks, against_entry->block);
           Direction_t against_direction = direction_rotate_clockwise(direction, against_entry->rotations_through_portal);
 
           S8 against_rotations = (rotations + against_entry->rotations_through_portal) % DIRECTION_COUNT;
@@ -2039,12 +2069,11 @@ BlockChainsResult_t find_block_chain(Block_t* block, Direction_t direction, Quad
           }
 
           BlockChainEntry_t block_chain_entry {};
-          block_chain_entry.block = against_entry->block;
+          block_chain_entry.block = against_block;
           block_chain_entry.rotations_through_portal = against_entry->rotations_through_portal;
           current_chain->insert(&block_chain_entry);
 
-          auto merge_result = find_block_chain(against_entry->block, against_direction,
-                                               block_qt, interactive_qt, tilemap, against_rotations, current_chain);
+          auto merge_result = find_block_chain(against_block, against_direction, world, against_rotations, current_chain);
 
           if(merge_result.count == 0){
                result.insert(current_chain);
@@ -2166,12 +2195,13 @@ void copy_block_collision_results(Block_t* block, CheckBlockCollisionResult_t* r
 }
 
 void raise_above_blocks(World_t* world, Block_t* block){
-     auto result = block_held_down_by_another_block(block, world->block_qt, world->interactive_qt, &world->tilemap);
+     auto result = block_held_down_by_another_block(block, world->block_qt, &world->blocks, world->interactive_qt, &world->tilemap);
      for(S16 i = 0; i < result.count; i++){
-          Block_t* above_block = result.blocks_held[i].block;
+          Block_t* above_block = block_from_handle(&world->blocks, result.blocks_held[i].block);
           raise_above_blocks(world, above_block);
           above_block->pos.z++;
           above_block->held_up = BLOCK_HELD_BY_SOLID;
+          world_clear_block_query_cache(world);
           raise_entangled_blocks(world, above_block);
      }
 }
@@ -2190,7 +2220,7 @@ void raise_entangled_blocks(World_t* world, Block_t* block){
      }
 }
 
-bool block_pushes_are_the_same_collision(BlockMomentumPushes_t<128>* block_pushes, S16 start_index, S16 end_index, S16 block_index){
+bool block_pushes_are_the_same_collision(BlockMomentumPushes_t* block_pushes, S16 start_index, S16 end_index, S16 block_index){
      if(start_index < 0 || start_index > block_pushes->count) return false;
      if(end_index < 0 || end_index > block_pushes->count) return false;
      if(start_index > end_index) return false;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "block.h"
+#include "frame_arena.h"
 #include "tile.h"
 #include "interactive.h"
 #include "player.h"
@@ -34,9 +35,7 @@ struct BlockInsideBlockResult_t{
      }
 };
 
-#define MAX_BLOCK_INSIDE_OTHERS_COUNT 16
-
-using BlockInsideOthersResult_t = StaticObjectArray_t<BlockInsideBlockResult_t, MAX_BLOCK_INSIDE_OTHERS_COUNT>;
+using BlockInsideOthersResult_t = FrameArray_t<BlockInsideBlockResult_t>;
 
 #define MAX_BLOCK_PUSHERS 4
 
@@ -100,23 +99,106 @@ struct BlockMomentumPush_t{
     }
 };
 
-template <S16 MAX_BLOCK_PUSHES>
+// hash of a pair of indices where the order doesn't matter, a pushing b is the same collision as b pushing a
+inline U32 block_push_pair_hash(S16 a, S16 b){
+     U32 low = (U16)(a < b ? a : b);
+     U32 high = (U16)(a < b ? b : a);
+     U32 hash = (high << 16) | low;
+     hash ^= hash >> 16;
+     hash *= 0x45d9f3b;
+     hash ^= hash >> 16;
+     return hash;
+}
+
+// open addressed multimap from a hash to push indices, it has at least twice as many slots as pushes so it never fills up
+struct BlockPushIndex_t{
+     S16* slots = NULL; // push index + 1, 0 means the slot is empty, in the frame arena
+     U32 mask = 0;
+
+     bool init(S32 max_pushes){
+          U32 slot_count = 16;
+          while(slot_count < (U32)(max_pushes) * 2) slot_count *= 2;
+          slots = frame_arena_alloc_array<S16>(slot_count);
+          if(!slots){
+               mask = 0;
+               return false;
+          }
+          memset(slots, 0, slot_count * sizeof(*slots));
+          mask = slot_count - 1;
+          return true;
+     }
+
+     void insert(U32 hash, S16 push_index){
+          U32 slot = hash & mask;
+          while(slots[slot]) slot = (slot + 1) & mask;
+          slots[slot] = push_index + 1;
+     }
+
+     // start with slot = hash & mask, returns each push index in the order they were inserted and -1 at the end
+     S16 next(U32* slot){
+          if(!slots || !slots[*slot]) return -1;
+          S16 push_index = slots[*slot] - 1;
+          *slot = (*slot + 1) & mask;
+          return push_index;
+     }
+
+     void clear(){
+          if(slots) memset(slots, 0, (mask + 1) * sizeof(*slots));
+     }
+};
+
+#define BLOCK_PUSHES_START_CAPACITY 32
+#define MAX_BLOCK_PUSHES 0x7FFF // count is an S16
+
+// pushes live in the frame arena and grow as needed, so they must not outlive the frame
 struct BlockMomentumPushes_t{
-     BlockMomentumPush_t pushes[MAX_BLOCK_PUSHES];
+     BlockMomentumPush_t* pushes = NULL;
      S16 count = 0;
+     S32 capacity = 0;
 
-     bool add(BlockMomentumPush_t* push){
-          if(count < MAX_BLOCK_PUSHES){
-               pushes[count] = *push;
-               count++;
-               return true;
+     // pushes indexed by their (pusher, pushee) pair, keyed on the push as it was added
+     BlockPushIndex_t pair_index;
+
+     BlockMomentumPushes_t() = default;
+
+     // a copy would share the storage of the original
+     BlockMomentumPushes_t(const BlockMomentumPushes_t&) = delete;
+     BlockMomentumPushes_t& operator=(const BlockMomentumPushes_t&) = delete;
+
+     void index_push(S16 push_index){
+          BlockMomentumPush_t* push = pushes + push_index;
+          if(push->pusher_count <= 0) return;
+          pair_index.insert(block_push_pair_hash(push->pushers[0].index, push->pushee_index), push_index);
+     }
+
+     bool grow(){
+          S32 new_capacity = capacity ? capacity * 2 : BLOCK_PUSHES_START_CAPACITY;
+          if(new_capacity > MAX_BLOCK_PUSHES) new_capacity = MAX_BLOCK_PUSHES;
+          if(new_capacity <= capacity){
+               LOG("%s() out of room for more than %d block pushes\n", __FUNCTION__, count);
+               return false;
           }
 
-          return false;
+          BlockMomentumPush_t* new_pushes = frame_arena_alloc_array<BlockMomentumPush_t>(new_capacity);
+          if(!new_pushes) return false;
+          if(count) memcpy((void*)(new_pushes), (void*)(pushes), count * sizeof(*pushes));
+          pushes = new_pushes;
+          capacity = new_capacity;
+
+          if(!pair_index.init(capacity)) return false;
+          for(S16 i = 0; i < count; i++) index_push(i);
+          return true;
      }
 
-     template <S16 ALTERNATE_MAX_BLOCK_PUSHES>
-     void merge(BlockMomentumPushes_t<ALTERNATE_MAX_BLOCK_PUSHES>* alternate_pushes){
+     bool add(BlockMomentumPush_t* push){
+          if(count >= capacity && !grow()) return false;
+          pushes[count] = *push;
+          index_push(count);
+          count++;
+          return true;
+     }
+
+     void merge(BlockMomentumPushes_t* alternate_pushes){
           for(S16 p = 0; p < alternate_pushes->count; p++){
                BlockMomentumPush_t* alternate = alternate_pushes->pushes + p;
                add(alternate);
@@ -124,7 +206,8 @@ struct BlockMomentumPushes_t{
      }
 
      bool push_already_exists(BlockMomentumPush_t* push){
-          for(S16 i = 0; i < count; i++){
+          U32 slot = block_push_pair_hash(push->pushers[0].index, push->pushee_index) & pair_index.mask;
+          for(S16 i = pair_index.next(&slot); i >= 0; i = pair_index.next(&slot)){
                BlockMomentumPush_t* check = pushes + i;
                if(check->executed) continue;
                if(check->pusher_count <= 0) continue;
@@ -141,6 +224,7 @@ struct BlockMomentumPushes_t{
      }
 
      void clear(){
+          if(count > 0) pair_index.clear();
           count = 0;
      }
 };
@@ -151,7 +235,7 @@ struct BlockCollidedWithBlock_t{
      S8 portal_rotations = 0;
 };
 
-using BlockCollidedWithBlocks_t = StaticObjectArray_t<BlockCollidedWithBlock_t, MAX_BLOCK_INSIDE_OTHERS_COUNT>;
+using BlockCollidedWithBlocks_t = FrameArray_t<BlockCollidedWithBlock_t>;
 
 struct CheckBlockCollisionResult_t{
      bool collided = false;
@@ -212,7 +296,7 @@ struct BlockCollidesWithItselfResult_t{
 #define MAX_HELD_BLOCKS 16
 
 struct BlockHeld_t{
-     Block_t* block = nullptr;
+     BlockHandle_t block;
      Rect_t rect;
 };
 
@@ -240,22 +324,20 @@ struct InteractiveHeldResult_t{
 #define MAX_BLOCKS_AGAINST_BLOCK 4
 
 struct BlockAgainstOther_t{
-     Block_t* block = nullptr;
+     BlockHandle_t block;
      S8 rotations_through_portal = 0;
      bool through_portal = false;
 };
 
 using BlockAgainstOthersResult_t = StaticObjectArray_t<BlockAgainstOther_t, MAX_BLOCKS_AGAINST_BLOCK>;
 
-#define MAX_BLOCKS_IN_CHAIN 16
-
 struct BlockChainEntry_t{
      Block_t* block = 0;
      S8 rotations_through_portal = 0;
 };
 
-using BlockChain_t = StaticObjectArray_t<BlockChainEntry_t, MAX_BLOCKS_IN_CHAIN>;
-using BlockChainsResult_t = StaticObjectArray_t<BlockChain_t, MAX_BLOCKS_AGAINST_BLOCK>;
+using BlockChain_t = FrameArray_t<BlockChainEntry_t>;
+using BlockChainsResult_t = FrameArray_t<BlockChain_t>;
 
 #define MAX_BLOCK_COLLISIONS 32
 
@@ -283,10 +365,8 @@ struct BlockMomentumCollision_t{
      }
 };
 
-#define MAX_BLOCK_PUSHES 128
-
 struct BlockCollisionPushResult_t{
-     BlockMomentumPushes_t<MAX_BLOCK_PUSHES> additional_block_pushes;
+     BlockMomentumPushes_t additional_block_pushes;
 };
 
 struct BlockThroughPortal_t{
@@ -305,7 +385,7 @@ struct BlockThroughPortal_t{
 
 using FindBlocksThroughPortalResult_t = StaticObjectArray_t<BlockThroughPortal_t, MAX_BLOCKS_FOUND_THROUGH_PORTALS>;
 
-void add_block_held(BlockHeldResult_t* result, Block_t* block, Rect_t rect);
+void add_block_held(BlockHeldResult_t* result, BlockHandle_t block, Rect_t rect);
 void add_interactive_held(InteractiveHeldResult_t* result, Interactive_t* interactive, Rect_t rect);
 
 bool block_adjacent_pixels_to_check(Position_t pos, Vec_t pos_delta, BlockCut_t cut, Direction_t direction, Pixel_t* a, Pixel_t* b);
@@ -314,9 +394,12 @@ Block_t* block_against_block_in_list(Position_t pos, BlockCut_t cut, Block_t** b
 Block_t* block_against_another_block(Position_t pos, BlockCut_t cut, Direction_t direction, QuadTreeNode_t<Block_t>* block_qt,
                                      QuadTreeNode_t<Interactive_t>* interactive_qt, TileMap_t* tilemap, Direction_t* push_dir);
 BlockAgainstOther_t block_diagonally_against_block(Position_t pos, BlockCut_t cut, DirectionMask_t directions, TileMap_t* tilemap,
-                                                   QuadTreeNode_t<Interactive_t>* interactive_qt, QuadTreeNode_t<Block_t>* block_qt);
+                                                   QuadTreeNode_t<Interactive_t>* interactive_qt, QuadTreeNode_t<Block_t>* block_qt,
+                                                   ObjectArray_t<Block_t>* blocks_array);
 BlockAgainstOthersResult_t block_against_other_blocks(Position_t pos, BlockCut_t cut, Direction_t direction, QuadTreeNode_t<Block_t>* block_qt,
-                                                      QuadTreeNode_t<Interactive_t>* interactive_qt, TileMap_t* tilemap, bool require_portal_on = true);
+                                                      ObjectArray_t<Block_t>* blocks_array, QuadTreeNode_t<Interactive_t>* interactive_qt,
+                                                      TileMap_t* tilemap, bool require_portal_on = true);
+BlockAgainstOthersResult_t block_against_other_blocks(Block_t* block, Direction_t direction, World_t* world);
 Block_t* rotated_entangled_blocks_against_centroid(Block_t* block, Direction_t direction, QuadTreeNode_t<Block_t>* block_qt,
                                                    ObjectArray_t<Block_t>* blocks_array,
                                                    QuadTreeNode_t<Interactive_t>* interactive_qt, TileMap_t* tilemap);
@@ -335,12 +418,13 @@ bool block_diagonally_against_solid(Position_t block_pos, Vec_t pos_delta, Block
 Player_t* block_against_player(Block_t* block_to_check, Direction_t direction, ObjectArray_t<Player_t>* players);
 
 InteractiveHeldResult_t block_held_up_by_popup(Position_t block_pos, BlockCut_t cut, QuadTreeNode_t<Interactive_t>* interactive_qt, S16 min_area = 0);
-BlockHeldResult_t block_held_up_by_another_block(Block_t* block, QuadTreeNode_t<Block_t>* block_qt,
+BlockHeldResult_t block_held_up_by_another_block(Block_t* block, QuadTreeNode_t<Block_t>* block_qt, ObjectArray_t<Block_t>* blocks_array,
                                                  QuadTreeNode_t<Interactive_t>* interactive_qt, TileMap_t* tilemap, S16 min_area = 0);
-BlockHeldResult_t block_held_down_by_another_block(Block_t* block, QuadTreeNode_t<Block_t>* block_qt,
+BlockHeldResult_t block_held_down_by_another_block(Block_t* block, QuadTreeNode_t<Block_t>* block_qt, ObjectArray_t<Block_t>* blocks_array,
                                                    QuadTreeNode_t<Interactive_t>* interactive_qt, TileMap_t* tilemap, S16 min_area = 0);
 BlockHeldResult_t block_held_down_by_another_block(Pixel_t block_pixel, S8 block_z, BlockCut_t cut,
-                                                   QuadTreeNode_t<Block_t>* block_qt, QuadTreeNode_t<Interactive_t>* interactive_qt,
+                                                   QuadTreeNode_t<Block_t>* block_qt, ObjectArray_t<Block_t>* blocks_array,
+                                                   QuadTreeNode_t<Interactive_t>* interactive_qt,
                                                    TileMap_t* tilemap, S16 min_area = 0, bool include_pos_delta = true);
 
 bool block_on_ice(Position_t pos, Vec_t pos_delta, BlockCut_t cut, TileMap_t* tilemap, QuadTreeNode_t<Interactive_t>* interactive_qt,
@@ -370,13 +454,13 @@ bool blocks_are_entangled(Block_t* a, Block_t* b, ObjectArray_t<Block_t>* blocks
 bool blocks_are_entangled(S16 a_index, S16 b_index, ObjectArray_t<Block_t>* blocks_array);
 
 TransferMomentum_t get_block_push_pusher_momentum(BlockMomentumPush_t* push, World_t* world, Direction_t push_direction);
-BlockCollisionPushResult_t block_collision_push(BlockMomentumPush_t* push, World_t* world);
+void block_collision_push(BlockMomentumPush_t* push, World_t* world, BlockCollisionPushResult_t* result);
 
 FindBlocksThroughPortalResult_t find_blocks_through_portals(Coord_t coord, TileMap_t* tilemap, QuadTreeNode_t<Interactive_t>* interactive_qt, QuadTreeNode_t<Block_t>* block_qt,
                                                             bool require_on = true);
 // LOL
-BlockChainsResult_t find_block_chain(Block_t* block, Direction_t direction, QuadTreeNode_t<Block_t>* block_qt,
-                                     QuadTreeNode_t<Interactive_t>* interactive_qt, TileMap_t* tilemap, S8 rotations = 0, BlockChain_t* my_chain = NULL);
+BlockChainsResult_t find_block_chain(Block_t* block, Direction_t direction, World_t* world, S8 rotations = 0,
+                                     BlockChain_t* my_chain = NULL);
 TransferMomentum_t get_block_push_pusher_momentum(BlockMomentumPush_t* push, World_t* world, Direction_t push_direction);
 
 CheckBlockCollisionResult_t check_block_collision(World_t* world, Block_t* block);
@@ -387,4 +471,4 @@ void copy_block_collision_results(Block_t* block, CheckBlockCollisionResult_t* r
 void raise_above_blocks(World_t* world, Block_t* block);
 void raise_entangled_blocks(World_t* world, Block_t* block);
 
-bool block_pushes_are_the_same_collision(BlockMomentumPushes_t<128>* block_pushes, S16 start_index, S16 end_index, S16 block_index);
+bool block_pushes_are_the_same_collision(BlockMomentumPushes_t* block_pushes, S16 start_index, S16 end_index, S16 block_index);
@@ -0,0 +1,226 @@
+#include "collision_island.h"
+#include "conversion.h"
+#include "defines.h"
+
+
+static S16 island_find(S16* parents, S16 slot){
+     while(parents[slot] != slot){
+          parents[slot] = parents[parents[slot]];
+          slot = parents[slot];
+     }
+     return slot;
+}
+
+static void island_union(S16* parents, S16 a, S16 b){
+     a = island_find(parents, a);
+     b = island_find(parents, b);
+     if(a == b) return;
+
+     // the lowest slot is the root, so islands come out in the order of their lowest block index
+     if(a < b){
+          parents[b] = a;
+     }else{
+          parents[a] = b;
+     }
+}
+
+static Rect_t island_rect(Pixel_t pixel){
+     S16 reach = TILE_SIZE_IN_PIXELS + BLOCK_WAKE_DISTANCE_IN_PIXELS;
+     return Rect_t{(S16)(pixel.x - reach), (S16)(pixel.y - reach), (S16)(pixel.x + reach), (S16)(pixel.y + reach)};
+}
+
+static bool island_reserve(CollisionIslands_t* islands, S16 block_count, S16 island_count){
+     if(block_count > islands->allocated_blocks){
+          S16* blocks = (S16*)(realloc(islands->blocks, block_count * sizeof(*islands->blocks)));
+          S16* parents = (S16*)(realloc(islands->parents, block_count * sizeof(*islands->parents)));
+          S16* block_slots = (S16*)(realloc(islands->block_slots, block_count * sizeof(*islands->block_slots)));
+          if(blocks) islands->blocks = blocks;
+          if(parents) islands->parents = parents;
+          if(block_slots) islands->block_slots = block_slots;
+          if(!blocks || !parents || !block_slots){
+               LOG("%s() failed to allocate %d island blocks\n", __FUNCTION__, block_count);
+               return false;
+          }
+          islands->allocated_blocks = block_count;
+     }
+
+     if(island_count > islands->allocated_islands){
+          CollisionIsland_t* new_islands = (CollisionIsland_t*)(realloc(islands->islands, island_count * sizeof(*islands->islands)));
+          if(!new_islands){
+               LOG("%s() failed to allocate %d islands\n", __FUNCTION__, island_count);
+               return false;
+          }
+          islands->islands = new_islands;
+          islands->allocated_islands = island_count;
+     }
+
+     return true;
+}
+
+static void build_single_island(CollisionIslands_t* islands, World_t* world){
+     islands->single = true;
+     islands->count = 1;
+     islands->islands[0].first_block = 0;
+     islands->islands[0].block_count = world_awake_block_count(world);
+     islands->islands[0].has_players = true;
+}
+
+bool CollisionIslands_t::build(World_t* world){
+     count = 0;
+     single = false;
+
+     awake_count = world_awake_block_count(world);
+
+     // one island per awake block at most, plus one for the players if they aren't near any blocks
+     if(!island_reserve(this, world->blocks.count > 0 ? world->blocks.count : 1, awake_count + 1)) return false;
+
+     // cloned players come and go mid frame as well
+     if(world->blocks_near_portals || world->players.count > 1){
+          build_single_island(this, world);
+          return true;
+     }
+
+     for(S16 i = 0; i < world->blocks.count; i++) block_slots[i] = -1;
+     for(S16 a = 0; a < awake_count; a++){
+          block_slots[world_awake_block_index(world, a)] = a;
+          parents[a] = a;
+     }
+
+     // blocks close enough to touch this frame or entangled with each other have to be solved together
+     for(S16 a = 0; a < awake_count; a++){
+          S16 block_index = world_awake_block_index(world, a);
+          Block_t* block = world->blocks.elements + block_index;
+
+          S16 found_count = 0;
+          Block_t* found_blocks[BLOCK_WAKE_MAX_QUERY];
+          quad_tree_find_in(world->block_qt, island_rect(block->pos.pixel), found_blocks, &found_count, BLOCK_WAKE_MAX_QUERY);
+          for(S16 b = 0; b < found_count; b++){
+               S16 slot = block_slots[get_block_index(world, found_blocks[b])];
+               if(slot >= 0) island_union(parents, a, slot);
+          }
+
+          S16 entangle_index = block->entangle_index;
+          while(entangle_index != block_index && entangle_index >= 0 && entangle_index < world->blocks.count){
+               S16 slot = block_slots[entangle_index];
+               if(slot >= 0) island_union(parents, a, slot);
+               entangle_index = world->blocks.elements[entangle_index].entangle_index;
+          }
+     }
+
+     // the player can push and ride on the blocks around them
+     S16 player_slot = -1;
+     if(world->players.count > 0){
+          Player_t* player = world->players.elements + 0;
+
+          S16 found_count = 0;
+          Block_t* found_blocks[BLOCK_WAKE_MAX_QUERY];
+          if(world->block_qt){
+               quad_tree_find_in(world->block_qt, island_rect(player->pos.pixel), found_blocks, &found_count, BLOCK_WAKE_MAX_QUERY);
+          }
+
+          for(S16 b = 0; b < found_count; b++){
+               S16 slot = block_slots[get_block_index(world, found_blocks[b])];
+               if(slot < 0) continue;
+               if(player_slot < 0){
+                    player_slot = slot;
+               }else{
+                    island_union(parents, player_slot, slot);
+               }
+          }
+
+          if(player->pushing_block >= 0 && player->pushing_block < world->blocks.count){
+               S16 slot = block_slots[player->pushing_block];
+               if(slot >= 0){
+                    if(player_slot < 0){
+                         player_slot = slot;
+                    }else{
+                         island_union(parents, player_slot, slot);
+                    }
+               }
+          }
+     }
+
+     // number the islands by their lowest block, the roots are always the lowest slot
+     for(S16 a = 0; a < awake_count; a++){
+          S16 root = island_find(parents, a);
+          if(root == a){
+               auto* island = islands + count;
+               island->first_block = 0;
+               island->block_count = 0;
+               island->has_players = false;
+               block_slots[world_awake_block_index(world, a)] = count;
+               count++;
+          }
+     }
+
+     // reuse the block slots to remember which island each root became
+     S16 first_block = 0;
+     for(S16 c = 0; c < count; c++) islands[c].block_count = 0;
+     for(S16 a = 0; a < awake_count; a++){
+          S16 root = island_find(parents, a);
+          S16 island_index = block_slots[world_awake_block_index(world, root)];
+          islands[island_index].block_count++;
+     }
+     for(S16 c = 0; c < count; c++){
+          islands[c].first_block = first_block;
+          first_block += islands[c].block_count;
+          islands[c].block_count = 0;
+     }
+     for(S16 a = 0; a < awake_count; a++){
+          S16 root = island_find(parents, a);
+          S16 island_index = block_slots[world_awake_block_index(world, root)];
+          auto* island = islands + island_index;
+          blocks[island->first_block + island->block_count] = world_awake_block_index(world, a);
+          island->block_count++;
+     }
+
+     if(world->players.count > 0){
+          if(player_slot >= 0){
+               S16 root = island_find(parents, player_slot);
+               islands[block_slots[world_awake_block_index(world, root)]].has_players = true;
+          }else{
+               auto* island = islands + count;
+               island->first_block = first_block;
+               island->block_count = 0;
+               island->has_players = true;
+               count++;
+          }
+     }
+
+     return true;
+}
+
+// a block woken while the islands are being solved is in none of them, it could be touching blocks in any island
+// that hasn't been solved yet, so solve everything that is awake as one island from then on
+bool CollisionIslands_t::fall_back_if_blocks_woke(World_t* world){
+     if(single || world_awake_block_count(world) == awake_count) return false;
+
+     world_sort_awake_blocks(world);
+     awake_count = world_awake_block_count(world);
+     build_single_island(this, world);
+     return true;
+}
+
+void CollisionIslands_t::clear(){
+     free(blocks);
+     free(parents);
+     free(block_slots);
+     free(islands);
+     blocks = NULL;
+     parents = NULL;
+     block_slots = NULL;
+     islands = NULL;
+     allocated_blocks = 0;
+     allocated_islands = 0;
+     count = 0;
+}
+
+S16 CollisionIslands_t::block_count(World_t* world, S16 island_index){
+     if(single) return world_awake_block_count(world);
+     return islands[island_index].block_count;
+}
+
+S16 CollisionIslands_t::block_index(World_t* world, S16 island_index, S16 island_block){
+     if(single) return world_awake_block_index(world, island_block);
+     return blocks[islands[island_index].first_block + island_block];
+}
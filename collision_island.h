@@ -0,0 +1,33 @@
+#pragma once
+
+#include "world.h"
+
+// a group of blocks (and maybe the players) that can only collide with each other this frame
+struct CollisionIsland_t{
+     S16 first_block; // into CollisionIslands_t::blocks
+     S16 block_count;
+     bool has_players;
+};
+
+struct CollisionIslands_t{
+     S16* blocks = NULL; // block indices grouped by island, ascending within an island
+     S16* parents = NULL;
+     S16* block_slots = NULL; // block index -> position in the awake list, -1 if the block is asleep
+     S16 allocated_blocks = 0;
+
+     CollisionIsland_t* islands = NULL;
+     S16 count = 0;
+     S16 allocated_islands = 0;
+
+     // when blocks may be cloned or split through portals, the block array changes mid frame, so everything is
+     // solved as a single island that follows the awake blocks just like the rest of the frame does
+     bool single = false;
+     S16 awake_count = 0; // how many blocks were awake when the islands were built
+
+     bool build(World_t* world);
+     bool fall_back_if_blocks_woke(World_t* world);
+     void clear();
+
+     S16 block_count(World_t* world, S16 island_index);
+     S16 block_index(World_t* world, S16 island_index, S16 island_block);
+};
@@ -3,18 +3,96 @@
 #include "position.h"
 #include "coord.h"
 
-Vec_t coord_to_vec(Coord_t c);
-Vec_t pos_to_vec(Position_t p);
-Vec_t pixel_to_vec(Pixel_t p);
-Coord_t vec_to_coord(Vec_t v);
-Coord_t pixel_to_coord(Pixel_t p);
-Coord_t pos_to_coord(Position_t p);
-Pixel_t vec_to_pixel(Vec_t v);
-Pixel_t coord_to_pixel(Coord_t c);
-Pixel_t coord_to_pixel_at_center(Coord_t c);
-Position_t coord_to_pos_at_tile_center(Coord_t c);
-Position_t coord_to_pos(Coord_t c);
-Position_t vec_to_pos(Vec_t v);
-Position_t pixel_to_pos(Pixel_t v);
-DirectionMask_t directions_between(Coord_t a, Coord_t b);
-Direction_t relative_quadrant(Pixel_t a, Pixel_t b);
+#include <cstdlib>
+#include <cassert>
+
+constexpr Vec_t coord_to_vec(Coord_t c){
+     return Vec_t{(F32)(c.x * TILE_SIZE_IN_PIXELS) * PIXEL_SIZE, (F32)(c.y * TILE_SIZE_IN_PIXELS) * PIXEL_SIZE};
+}
+
+constexpr Vec_t pos_to_vec(Position_t p){
+     return Vec_t{(F32)(p.pixel.x) * PIXEL_SIZE + p.decimal.x, (F32)(p.pixel.y) * PIXEL_SIZE + p.decimal.y};
+}
+
+constexpr Vec_t pixel_to_vec(Pixel_t p){
+     return Vec_t{(F32)(p.x) * PIXEL_SIZE, (F32)(p.y) * PIXEL_SIZE};
+}
+
+constexpr Coord_t vec_to_coord(Vec_t v){
+     return Coord_t{(S16)((S16)(v.x / PIXEL_SIZE) / TILE_SIZE_IN_PIXELS),
+                    (S16)((S16)(v.y / PIXEL_SIZE) / TILE_SIZE_IN_PIXELS)};
+}
+
+constexpr Coord_t pixel_to_coord(Pixel_t p){
+     return Coord_t{(S16)(p.x / TILE_SIZE_IN_PIXELS), (S16)(p.y / TILE_SIZE_IN_PIXELS)};
+}
+
+inline Coord_t pos_to_coord(Position_t p){
+     assert(p.decimal.x >= 0.0f && p.decimal.y >= 0.0f);
+     return pixel_to_coord(p.pixel);
+}
+
+constexpr Pixel_t vec_to_pixel(Vec_t v){
+     return Pixel_t{(S16)(v.x / PIXEL_SIZE), (S16)(v.y / PIXEL_SIZE)};
+}
+
+constexpr Pixel_t coord_to_pixel(Coord_t c){
+     return Pixel_t{(S16)(c.x * TILE_SIZE_IN_PIXELS), (S16)(c.y * TILE_SIZE_IN_PIXELS)};
+}
+
+constexpr Pixel_t coord_to_pixel_at_center(Coord_t c){
+     return Pixel_t{(S16)((c.x * TILE_SIZE_IN_PIXELS) + HALF_TILE_SIZE_IN_PIXELS),
+                    (S16)((c.y * TILE_SIZE_IN_PIXELS) + HALF_TILE_SIZE_IN_PIXELS)};
+}
+
+constexpr Position_t coord_to_pos_at_tile_center(Coord_t c){
+     return pixel_pos(coord_to_pixel(c) + HALF_TILE_SIZE_PIXEL);
+}
+
+constexpr Position_t coord_to_pos(Coord_t c){
+     return pixel_pos(coord_to_pixel(c));
+}
+
+inline Position_t vec_to_pos(Vec_t v){
+     Position_t p = {};
+     p.decimal = v;
+     canonicalize(&p);
+     return p;
+}
+
+inline Position_t pixel_to_pos(Pixel_t p){
+     Position_t pos = {};
+     pos.pixel = p;
+     canonicalize(&pos);
+     return pos;
+}
+
+inline DirectionMask_t directions_between(Coord_t a, Coord_t b){
+     Coord_t c = b - a;
+
+     DirectionMask_t mask {};
+     if(c.x < 0) mask = direction_mask_add(mask, DIRECTION_MASK_LEFT);
+     if(c.x > 0) mask = direction_mask_add(mask, DIRECTION_MASK_RIGHT);
+     if(c.y < 0) mask = direction_mask_add(mask, DIRECTION_MASK_DOWN);
+     if(c.y > 0) mask = direction_mask_add(mask, DIRECTION_MASK_UP);
+
+     return mask;
+}
+
+// TODO: consider reversing the output of this function
+inline Direction_t relative_quadrant(Pixel_t a, Pixel_t b){
+     Pixel_t c = b - a;
+
+     if(abs(c.x) > abs(c.y)){
+          if(c.x > 0) return DIRECTION_RIGHT;
+          return DIRECTION_LEFT;
+     }
+
+     if(c.y > 0) return DIRECTION_UP;
+     return DIRECTION_DOWN;
+}
+
+// batched version for arrays of positions
+inline void pos_to_coords(const Position_t* positions, Coord_t* coords, S32 count){
+     for(S32 i = 0; i < count; i++) coords[i] = pos_to_coord(positions[i]);
+}
@@ -0,0 +1,92 @@
+// gcc convert_demo.c -o convert_demo
+// converts a version 1 or 2 demo into a version 3 demo, the map and player positions are copied as is
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define END_DEMO_ACTION 12
+
+typedef struct{
+     int64_t frame;
+     int32_t action;
+}OldDemoEntry_t;
+
+static void write_varint(uint64_t value, FILE* file){
+     do{
+          uint8_t byte = value & 0x7F;
+          value >>= 7;
+          if(value) byte |= 0x80;
+          fwrite(&byte, sizeof(byte), 1, file);
+     }while(value);
+}
+
+int main(int argc, char** argv){
+     if(argc != 3){
+          printf("%s [src] [dst]\n", argv[0]);
+          return -1;
+     }
+
+     FILE* src_file = fopen(argv[1], "rb");
+     if(!src_file){
+          printf("failed to open %s\n", argv[1]);
+          return -1;
+     }
+
+     int32_t version = 0;
+     fread(&version, sizeof(version), 1, src_file);
+     if(version != 1 && version != 2){
+          printf("%s: unsupported demo version %d\n", argv[1], version);
+          fclose(src_file);
+          return -1;
+     }
+
+     FILE* dst_file = fopen(argv[2], "wb");
+     if(!dst_file){
+          printf("failed to open %s\n", argv[2]);
+          fclose(src_file);
+          return -1;
+     }
+
+     int32_t new_version = 3;
+     fwrite(&new_version, sizeof(new_version), 1, dst_file);
+
+     int64_t previous_frame = 0;
+     OldDemoEntry_t entry;
+     while(fread(&entry, sizeof(entry), 1, src_file) == 1){
+          int64_t delta = entry.frame - previous_frame;
+          uint64_t zigzag_delta = ((uint64_t)(delta) << 1) ^ (uint64_t)(delta >> 63);
+          uint8_t action = (uint8_t)(entry.action);
+
+          write_varint(zigzag_delta, dst_file);
+          fwrite(&action, sizeof(action), 1, dst_file);
+
+          previous_frame = entry.frame;
+          if(entry.action == END_DEMO_ACTION) break;
+     }
+
+     // the rest of the file is the map followed by the player pixels
+     long tail_start = ftell(src_file);
+     fseek(src_file, 0, SEEK_END);
+     long tail_size = ftell(src_file) - tail_start;
+     fseek(src_file, tail_start, SEEK_SET);
+
+     char* tail = (char*)(malloc(tail_size));
+     fread(tail, tail_size, 1, src_file);
+
+     if(version == 1){
+          // version 1 only stored a single player's pixel (2 S16s) with no count
+          long map_size = tail_size - 4;
+          int16_t player_count = 1;
+          fwrite(tail, map_size, 1, dst_file);
+          fwrite(&player_count, sizeof(player_count), 1, dst_file);
+          fwrite(tail + map_size, 4, 1, dst_file);
+     }else{
+          fwrite(tail, tail_size, 1, dst_file);
+     }
+
+     free(tail);
+     fclose(src_file);
+     fclose(dst_file);
+
+     return 0;
+}
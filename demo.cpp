@@ -1,5 +1,6 @@
 #include "demo.h"
 #include "map_format.h"
+#include "defines.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -9,6 +10,48 @@ struct DemoEntryNode_t{
      DemoEntryNode_t* next;
 };
 
+// version 3 entries are a zigzag varint of the frame delta from the previous entry followed by a one byte action
+#define DEMO_MAX_VARINT_SIZE 10
+#define DEMO_CHECKSUM_GROW_COUNT 64
+
+static U64 zigzag_encode(S64 value){
+     return ((U64)(value) << 1) ^ (U64)(value >> 63);
+}
+
+static S64 zigzag_decode(U64 value){
+     return (S64)(value >> 1) ^ -(S64)(value & 1);
+}
+
+static bool demo_read_varint(FILE* file, U64* value){
+     *value = 0;
+     for(S8 i = 0; i < DEMO_MAX_VARINT_SIZE; i++){
+          int byte = fgetc(file);
+          if(byte == EOF) return false;
+          *value |= (U64)(byte & 0x7F) << (7 * i);
+          if((byte & 0x80) == 0) return true;
+     }
+     return false;
+}
+
+static bool demo_entry_read(FILE* file, S32 version, S64 previous_frame, DemoEntry_t* entry){
+     switch(version){
+     default:
+          return fread(entry, sizeof(*entry), 1, file) == 1;
+     case 3:
+     case 4:
+     {
+          U64 frame_delta = 0;
+          if(!demo_read_varint(file, &frame_delta)) return false;
+          int action = fgetc(file);
+          if(action == EOF) return false;
+          entry->frame = previous_frame + zigzag_decode(frame_delta);
+          entry->player_action_type = (PlayerActionType_t)(action);
+     } break;
+     }
+
+     return true;
+}
+
 bool demo_begin(Demo_t* demo){
      switch(demo->mode){
      default:
@@ -19,7 +62,11 @@ bool demo_begin(Demo_t* demo){
                LOG("failed to open demo file: %s\n", demo->filepath);
                return false;
           }
-          demo->version = 2;
+          demo->version = DEMO_VERSION;
+          demo->write_buffer_used = 0;
+          demo->last_written_frame = 0;
+          free(demo->checksums.checksums);
+          demo->checksums = {};
           fwrite(&demo->version, sizeof(demo->version), 1, demo->file);
           break;
      case DEMO_MODE_PLAY:
@@ -29,7 +76,9 @@ bool demo_begin(Demo_t* demo){
                return false;
           }
           fread(&demo->version, sizeof(demo->version), 1, demo->file);
-          demo->entries = demo_entries_get(demo->file);
+          demo->entries = demo_entries_get(demo->file, demo->version);
+          demo->checksums = demo_checksums_get(demo->file, demo->version);
+          demo->checksum_mismatch_frame = -1;
           demo->last_frame = demo->entries.entries[demo->entries.count - 1].frame;
           LOG("playing demo %s: version %d with %" PRId64 " actions across %" PRId64 " frames\n", demo->filepath,
               demo->version, demo->entries.count, demo->last_frame);
@@ -39,8 +88,9 @@ bool demo_begin(Demo_t* demo){
      return true;
 }
 
-DemoEntries_t demo_entries_get(FILE* file){
+DemoEntries_t demo_entries_get(FILE* file, S32 version){
      S64 entry_count = 0;
+     S64 previous_frame = 0;
 
      // read into a linked list
      DemoEntryNode_t* head = nullptr;
@@ -53,7 +103,7 @@ DemoEntries_t demo_entries_get(FILE* file){
           itr->entry.player_action_type = PLAYER_ACTION_TYPE_MOVE_LEFT_START;
           itr->next = nullptr;
 
-          size_t read_count = fread(&itr->entry, sizeof(itr->entry), 1, file);
+          bool read_entry = demo_entry_read(file, version, previous_frame, &itr->entry);
           if(prev){
                prev->next = itr;
           }else{
@@ -63,9 +113,11 @@ DemoEntries_t demo_entries_get(FILE* file){
           prev = itr;
           entry_count++;
 
-          if(read_count != 1){
+          if(!read_entry){
                break;
           }
+
+          previous_frame = itr->entry.frame;
      }
 
      // allocate array
@@ -88,6 +140,233 @@ DemoEntries_t demo_entries_get(FILE* file){
      return entries;
 }
 
+void demo_flush(Demo_t* demo){
+     if(demo->write_buffer_used == 0) return;
+     fwrite(demo->write_buffer, demo->write_buffer_used, 1, demo->file);
+     demo->write_buffer_used = 0;
+}
+
+void demo_write_entry(Demo_t* demo, DemoEntry_t* entry){
+     U8 bytes[DEMO_MAX_VARINT_SIZE + 1];
+     U32 byte_count = 0;
+
+     U64 frame_delta = zigzag_encode(entry->frame - demo->last_written_frame);
+     do{
+          U8 byte = frame_delta & 0x7F;
+          frame_delta >>= 7;
+          if(frame_delta) byte |= 0x80;
+          bytes[byte_count] = byte;
+          byte_count++;
+     }while(frame_delta);
+
+     bytes[byte_count] = (U8)(entry->player_action_type);
+     byte_count++;
+
+     if(demo->write_buffer_used + byte_count > DEMO_WRITE_BUFFER_SIZE) demo_flush(demo);
+     memcpy(demo->write_buffer + demo->write_buffer_used, bytes, byte_count);
+     demo->write_buffer_used += byte_count;
+     demo->last_written_frame = entry->frame;
+
+     // the checksums, map and player positions are written directly to the file after the last entry
+     if(entry->player_action_type == PLAYER_ACTION_TYPE_END_DEMO){
+          demo_flush(demo);
+          fwrite(&demo->checksums.interval, sizeof(demo->checksums.interval), 1, demo->file);
+          fwrite(&demo->checksums.count, sizeof(demo->checksums.count), 1, demo->file);
+          if(demo->checksums.count > 0){
+               fwrite(demo->checksums.checksums, sizeof(*demo->checksums.checksums), demo->checksums.count, demo->file);
+          }
+     }
+}
+
+DemoChecksums_t demo_checksums_get(FILE* file, S32 version){
+     DemoChecksums_t checksums = {};
+     if(version < 4) return checksums;
+
+     fread(&checksums.interval, sizeof(checksums.interval), 1, file);
+     fread(&checksums.count, sizeof(checksums.count), 1, file);
+     if(checksums.count <= 0 || checksums.interval <= 0){
+          checksums.count = 0;
+          return checksums;
+     }
+
+     checksums.checksums = (DemoChecksum_t*)(malloc(checksums.count * sizeof(*checksums.checksums)));
+     if(!checksums.checksums){
+          LOG("failed to allocate %" PRId64 " demo checksums\n", checksums.count);
+          fseek(file, checksums.count * sizeof(*checksums.checksums), SEEK_CUR);
+          checksums.count = 0;
+          return checksums;
+     }
+
+     S64 read_count = (S64)(fread(checksums.checksums, sizeof(*checksums.checksums), checksums.count, file));
+     if(read_count != checksums.count){
+          LOG("only read %" PRId64 " of %" PRId64 " demo checksums\n", read_count, checksums.count);
+          checksums.count = read_count;
+     }
+
+     return checksums;
+}
+
+// fnv-1a, hashing each member separately so struct padding doesn't leak into the hash
+static U32 checksum_bytes(U32 hash, const void* data, size_t size){
+     const U8* bytes = (const U8*)(data);
+     for(size_t i = 0; i < size; i++){
+          hash ^= bytes[i];
+          hash *= 16777619;
+     }
+     return hash;
+}
+
+#define CHECKSUM_VALUE(hash, value) hash = checksum_bytes(hash, &(value), sizeof(value))
+
+static U32 checksum_position(U32 hash, Position_t* pos){
+     CHECKSUM_VALUE(hash, pos->pixel.x);
+     CHECKSUM_VALUE(hash, pos->pixel.y);
+     CHECKSUM_VALUE(hash, pos->decimal.x);
+     CHECKSUM_VALUE(hash, pos->decimal.y);
+     CHECKSUM_VALUE(hash, pos->z);
+     return hash;
+}
+
+static U32 checksum_lift(U32 hash, Lift_t* lift){
+     CHECKSUM_VALUE(hash, lift->ticks);
+     CHECKSUM_VALUE(hash, lift->up);
+     return hash;
+}
+
+DemoChecksum_t demo_checksum_world(World_t* world){
+     DemoChecksum_t checksum;
+     for(S8 f = 0; f < DEMO_CHECKSUM_FIELD_COUNT; f++){
+          checksum.fields[f] = 2166136261;
+     }
+
+     U32* block_positions = checksum.fields + DEMO_CHECKSUM_FIELD_BLOCK_POSITIONS;
+     U32* block_velocities = checksum.fields + DEMO_CHECKSUM_FIELD_BLOCK_VELOCITIES;
+     for(S16 i = 0; i < world->blocks.count; i++){
+          Block_t* block = world->blocks.elements + i;
+          *block_positions = checksum_position(*block_positions, &block->pos);
+          CHECKSUM_VALUE(*block_velocities, block->vel.x);
+          CHECKSUM_VALUE(*block_velocities, block->vel.y);
+     }
+
+     U32* tile_flags = checksum.fields + DEMO_CHECKSUM_FIELD_TILE_FLAGS;
+     S32 tile_count = tilemap_tile_count(&world->tilemap);
+     for(S32 i = 0; i < tile_count; i++){
+          CHECKSUM_VALUE(*tile_flags, world->tilemap.tiles[i].flags);
+     }
+
+     U32* interactives = checksum.fields + DEMO_CHECKSUM_FIELD_INTERACTIVES;
+     for(S16 i = 0; i < world->interactives.count; i++){
+          Interactive_t* interactive = world->interactives.elements + i;
+          CHECKSUM_VALUE(*interactives, interactive->type);
+
+          switch(interactive->type){
+          default:
+               break;
+          case INTERACTIVE_TYPE_PRESSURE_PLATE:
+               CHECKSUM_VALUE(*interactives, interactive->pressure_plate.down);
+               break;
+          case INTERACTIVE_TYPE_ICE_DETECTOR:
+          case INTERACTIVE_TYPE_LIGHT_DETECTOR:
+               CHECKSUM_VALUE(*interactives, interactive->detector.on);
+               break;
+          case INTERACTIVE_TYPE_POPUP:
+               CHECKSUM_VALUE(*interactives, interactive->popup.iced);
+               *interactives = checksum_lift(*interactives, &interactive->popup.lift);
+               break;
+          case INTERACTIVE_TYPE_DOOR:
+               *interactives = checksum_lift(*interactives, &interactive->door.lift);
+               break;
+          case INTERACTIVE_TYPE_PORTAL:
+               CHECKSUM_VALUE(*interactives, interactive->portal.on);
+               break;
+          case INTERACTIVE_TYPE_PIT:
+               CHECKSUM_VALUE(*interactives, interactive->pit.iced);
+               break;
+          case INTERACTIVE_TYPE_CHECKPOINT:
+               CHECKSUM_VALUE(*interactives, interactive->checkpoint);
+               break;
+          }
+     }
+
+     U32* players = checksum.fields + DEMO_CHECKSUM_FIELD_PLAYERS;
+     CHECKSUM_VALUE(*players, world->players.count);
+     for(S16 i = 0; i < world->players.count; i++){
+          Player_t* player = world->players.elements + i;
+          *players = checksum_position(*players, &player->pos);
+          CHECKSUM_VALUE(*players, player->vel.x);
+          CHECKSUM_VALUE(*players, player->vel.y);
+     }
+
+     return checksum;
+}
+
+void demo_record_checksum(Demo_t* demo, World_t* world, S64 frame_count){
+     if(frame_count <= 0 || (frame_count % demo->checksums.interval) != 0) return;
+
+     // frames are only recorded moving forward, so the checksum index always lines up with the frame
+     S64 index = (frame_count / demo->checksums.interval) - 1;
+     if(index != demo->checksums.count) return;
+
+     if((demo->checksums.count % DEMO_CHECKSUM_GROW_COUNT) == 0){
+          S64 new_capacity = demo->checksums.count + DEMO_CHECKSUM_GROW_COUNT;
+          DemoChecksum_t* checksums = (DemoChecksum_t*)(realloc(demo->checksums.checksums, new_capacity * sizeof(*checksums)));
+          if(!checksums){
+               LOG("failed to allocate %" PRId64 " demo checksums\n", new_capacity);
+               return;
+          }
+          demo->checksums.checksums = checksums;
+     }
+
+     demo->checksums.checksums[demo->checksums.count] = demo_checksum_world(world);
+     demo->checksums.count++;
+}
+
+bool demo_verify_checksum(Demo_t* demo, World_t* world, S64 frame_count){
+     if(demo->checksums.count == 0) return true;
+     if(frame_count <= 0 || (frame_count % demo->checksums.interval) != 0) return true;
+
+     S64 index = (frame_count / demo->checksums.interval) - 1;
+     if(index >= demo->checksums.count) return true;
+
+     DemoChecksum_t* expected = demo->checksums.checksums + index;
+     DemoChecksum_t actual = demo_checksum_world(world);
+
+     bool matches = true;
+     for(S8 f = 0; f < DEMO_CHECKSUM_FIELD_COUNT; f++){
+          if(expected->fields[f] == actual.fields[f]) continue;
+
+          // only report the first frame that diverges, everything after it is just noise
+          if(demo->checksum_mismatch_frame < 0 || demo->checksum_mismatch_frame == frame_count){
+               LOG("demo %s diverged on frame %" PRId64 ": mismatched '%s' checksum. demo '%u', actual '%u'\n",
+                   demo->filepath, frame_count, demo_checksum_field_to_string((DemoChecksumField_t)(f)),
+                   expected->fields[f], actual.fields[f]);
+               demo->checksum_mismatch_frame = frame_count;
+          }
+          matches = false;
+     }
+
+     return matches;
+}
+
+const char* demo_checksum_field_to_string(DemoChecksumField_t field){
+     switch(field){
+     default:
+          break;
+     case DEMO_CHECKSUM_FIELD_BLOCK_POSITIONS:
+          return "block positions";
+     case DEMO_CHECKSUM_FIELD_BLOCK_VELOCITIES:
+          return "block velocities";
+     case DEMO_CHECKSUM_FIELD_TILE_FLAGS:
+          return "tile flags";
+     case DEMO_CHECKSUM_FIELD_INTERACTIVES:
+          return "interactives";
+     case DEMO_CHECKSUM_FIELD_PLAYERS:
+          return "players";
+     }
+
+     return "unknown";
+}
+
 bool demo_play_frame(Demo_t* demo, PlayerAction_t* player_action, ObjectArray_t<Player_t>* players, S64 frame_count,
                      Demo_t* record_demo){
      if(demo->entries.entries[demo->entry_index].player_action_type == PLAYER_ACTION_TYPE_END_DEMO){
@@ -97,8 +376,8 @@ bool demo_play_frame(Demo_t* demo, PlayerAction_t* player_action, ObjectArray_t<
      }else{
           while(frame_count == demo->entries.entries[demo->entry_index].frame){
                player_action_perform(player_action, players,
-                                     demo->entries.entries[demo->entry_index].player_action_type, record_demo->mode,
-                                     record_demo->file, frame_count);
+                                     demo->entries.entries[demo->entry_index].player_action_type, record_demo,
+                                     frame_count);
                demo->entry_index++;
           }
      }
@@ -107,7 +386,7 @@ bool demo_play_frame(Demo_t* demo, PlayerAction_t* player_action, ObjectArray_t<
 }
 
 void player_action_perform(PlayerAction_t* player_action, ObjectArray_t<Player_t>* players, PlayerActionType_t player_action_type,
-                           DemoMode_t demo_mode, FILE* demo_file, S64 frame_count){
+                           Demo_t* record_demo, S64 frame_count){
      switch(player_action_type){
      default:
           break;
@@ -207,9 +486,9 @@ void player_action_perform(PlayerAction_t* player_action, ObjectArray_t<Player_t
           break;
      }
 
-     if(demo_mode == DEMO_MODE_RECORD){
+     if(record_demo->mode == DEMO_MODE_RECORD){
           DemoEntry_t demo_entry {frame_count, player_action_type};
-          fwrite(&demo_entry, sizeof(demo_entry), 1, demo_file);
+          demo_write_entry(record_demo, &demo_entry);
      }
 }
 
@@ -220,18 +499,12 @@ FILE* load_demo_number(S32 map_number, const char** demo_filepath){
      return fopen(*demo_filepath, "rb");
 }
 
-void cache_for_demo_seek(World_t* world, TileMap_t* demo_starting_tilemap, ObjectArray_t<Block_t>* demo_starting_blocks,
-                         ObjectArray_t<Interactive_t>* demo_starting_interactives){
-     deep_copy(&world->tilemap, demo_starting_tilemap);
-     deep_copy(&world->blocks, demo_starting_blocks);
-     deep_copy(&world->interactives, demo_starting_interactives);
+void cache_for_demo_seek(World_t* world, WorldSnapshot_t* demo_starting_world){
+     world_snapshot(world, demo_starting_world);
 }
 
-void fetch_cache_for_demo_seek(World_t* world, TileMap_t* demo_starting_tilemap, ObjectArray_t<Block_t>* demo_starting_blocks,
-                               ObjectArray_t<Interactive_t>* demo_starting_interactives){
-     deep_copy(demo_starting_tilemap, &world->tilemap);
-     deep_copy(demo_starting_blocks, &world->blocks);
-     deep_copy(demo_starting_interactives, &world->interactives);
+void fetch_cache_for_demo_seek(World_t* world, WorldSnapshot_t* demo_starting_world){
+     world_restore(demo_starting_world, world);
 }
 
 bool load_map_number_demo(Demo_t* demo, S16 map_number, S64* frame_count){
@@ -243,9 +516,12 @@ bool load_map_number_demo(Demo_t* demo, S16 map_number, S64* frame_count){
      }
 
      free(demo->entries.entries);
+     free(demo->checksums.checksums);
      demo->entry_index = 0;
      fread(&demo->version, sizeof(demo->version), 1, demo->file);
-     demo->entries = demo_entries_get(demo->file);
+     demo->entries = demo_entries_get(demo->file, demo->version);
+     demo->checksums = demo_checksums_get(demo->file, demo->version);
+     demo->checksum_mismatch_frame = -1;
      *frame_count = 0;
      demo->last_frame = demo->entries.entries[demo->entries.count - 1].frame;
      LOG("testing demo %s: version %d with %" PRId64 " actions across %" PRId64 " frames\n", demo->filepath,
@@ -264,6 +540,11 @@ bool load_map_number_demo(Demo_t* demo, S16 map_number, S64* frame_count){
 bool test_map_end_state(World_t* world, Demo_t* demo){
      bool test_passed = true;
 
+     if(demo->checksum_mismatch_frame >= 0){
+          LOG("world state first diverged from the recording on frame %" PRId64 "\n", demo->checksum_mismatch_frame);
+          test_passed = false;
+     }
+
      TileMap_t check_tilemap = {};
      ObjectArray_t<Block_t> check_block_array = {};
      ObjectArray_t<Interactive_t> check_interactives = {};
@@ -285,12 +566,13 @@ bool test_map_end_state(World_t* world, Demo_t* demo){
      }else if(check_tilemap.height != world->tilemap.height){
           LOG_MISMATCH("tilemap height", "%d", check_tilemap.height, world->tilemap.height);
      }else{
-          for(S16 j = 0; j < check_tilemap.height; j++){
-               for(S16 i = 0; i < check_tilemap.width; i++){
-                    if(check_tilemap.tiles[j][i].flags != world->tilemap.tiles[j][i].flags){
-                         snprintf(name, NAME_LEN, "tile %d, %d flags", i, j);
-                         LOG_MISMATCH(name, "%d", check_tilemap.tiles[j][i].flags, world->tilemap.tiles[j][i].flags);
-                    }
+          S32 tile_count = tilemap_tile_count(&check_tilemap);
+          for(S32 i = 0; i < tile_count; i++){
+               U16 check_flags = check_tilemap.tiles[i].flags;
+               U16 flags = world->tilemap.tiles[i].flags;
+               if(check_flags != flags){
+                    snprintf(name, NAME_LEN, "tile %d, %d flags", i % check_tilemap.width, i / check_tilemap.width);
+                    LOG_MISMATCH(name, "%d", check_flags, flags);
                }
           }
      }
@@ -306,6 +588,8 @@ bool test_map_end_state(World_t* world, Demo_t* demo){
           check_player_pixels = (Pixel_t*)(malloc(sizeof(*check_player_pixels)));
           break;
      case 2:
+     case 3:
+     case 4:
           fread(&check_player_pixel_count, sizeof(check_player_pixel_count), 1, demo->file);
           check_player_pixels = (Pixel_t*)(malloc(sizeof(*check_player_pixels) * check_player_pixel_count));
           break;
@@ -431,3 +715,142 @@ bool test_map_end_state(World_t* world, Demo_t* demo){
 
      return test_passed;
 }
+
+// when benching, every iteration of a map replaces the last one
+void demo_end_state_record(DemoEndStates_t* end_states, S16 map_number, World_t* world){
+     DemoEndState_t* end_state = nullptr;
+     if(end_states->maps.count > 0 && end_states->maps.elements[end_states->maps.count - 1].map_number == map_number){
+          end_state = end_states->maps.elements + end_states->maps.count - 1;
+     }else{
+          if(!resize(&end_states->maps, end_states->maps.count + 1)) return;
+          end_state = end_states->maps.elements + end_states->maps.count - 1;
+     }
+
+     end_state->map_number = map_number;
+     end_state->checksum = demo_checksum_world(world);
+}
+
+static bool demo_end_states_save(DemoEndStates_t* end_states){
+     FILE* file = fopen(end_states->filepath, "w");
+     if(!file){
+          LOG("%s(): failed to open '%s' for writing\n", __FUNCTION__, end_states->filepath);
+          return false;
+     }
+
+     fprintf(file, "# map block_positions block_velocities tile_flags interactives players\n");
+     for(S16 i = 0; i < end_states->maps.count; i++){
+          DemoEndState_t* end_state = end_states->maps.elements + i;
+          fprintf(file, "%03d", end_state->map_number);
+          for(S8 f = 0; f < DEMO_CHECKSUM_FIELD_COUNT; f++){
+               fprintf(file, " %u", end_state->checksum.fields[f]);
+          }
+          fprintf(file, "\n");
+     }
+
+     fclose(file);
+     LOG("saved end states of %d maps to '%s'\n", end_states->maps.count, end_states->filepath);
+     return true;
+}
+
+static bool demo_end_states_compare(DemoEndStates_t* end_states){
+     FILE* file = fopen(end_states->filepath, "r");
+     if(!file){
+          LOG("%s(): failed to open '%s'\n", __FUNCTION__, end_states->filepath);
+          return false;
+     }
+
+     S16 mismatch_count = 0;
+     S16 compared_count = 0;
+     char line[256];
+     while(fgets(line, sizeof(line), file)){
+          if(line[0] == '#') continue;
+
+          int map_number = 0;
+          DemoChecksum_t expected;
+          if(sscanf(line, "%d %u %u %u %u %u", &map_number, expected.fields + 0, expected.fields + 1,
+                    expected.fields + 2, expected.fields + 3, expected.fields + 4) != DEMO_CHECKSUM_FIELD_COUNT + 1){
+               continue;
+          }
+
+          for(S16 i = 0; i < end_states->maps.count; i++){
+               DemoEndState_t* end_state = end_states->maps.elements + i;
+               if(end_state->map_number != map_number) continue;
+
+               compared_count++;
+               bool matches = true;
+               for(S8 f = 0; f < DEMO_CHECKSUM_FIELD_COUNT; f++){
+                    if(expected.fields[f] == end_state->checksum.fields[f]) continue;
+                    LOG("map %03d end state changed: mismatched '%s' checksum. expected '%u', actual '%u'\n",
+                        map_number, demo_checksum_field_to_string((DemoChecksumField_t)(f)), expected.fields[f],
+                        end_state->checksum.fields[f]);
+                    matches = false;
+               }
+               if(!matches) mismatch_count++;
+               break;
+          }
+     }
+
+     fclose(file);
+
+     LOG("compared %d maps against end states '%s', %d changed\n", compared_count, end_states->filepath,
+         mismatch_count);
+     return mismatch_count == 0;
+}
+
+bool demo_end_states_report(DemoEndStates_t* end_states){
+     if(!end_states->filepath) return true;
+     if(end_states->save) return demo_end_states_save(end_states);
+     return demo_end_states_compare(end_states);
+}
+
+void destroy(DemoEndStates_t* end_states){
+     destroy(&end_states->maps);
+}
+
+// how long to wait between iterations of the main loop, in turbo the display stays at 60fps no matter the speed
+F32 demo_turbo_frame_time(DemoTurbo_t* turbo, F32 dt_scalar){
+     if(turbo->on && dt_scalar > 1.0f) return FRAME_TIME;
+     return FRAME_TIME / dt_scalar;
+}
+
+void demo_turbo_frame_begin(DemoTurbo_t* turbo, F32 dt_scalar){
+     if(!turbo->on || turbo->stepping) return;
+
+     turbo->frame_start = std::chrono::steady_clock::now();
+     turbo->frame_steps = 0;
+     if(dt_scalar > 1.0f) turbo->step_debt += dt_scalar;
+}
+
+// called after every simulation step, returns true if we should simulate again before rendering
+bool demo_turbo_step_again(DemoTurbo_t* turbo, F32 dt_scalar, bool paused){
+     if(!turbo->on) return false;
+
+     turbo->frame_steps++;
+     turbo->step_debt -= 1.0f;
+
+     auto now = std::chrono::steady_clock::now();
+
+     if(paused || dt_scalar <= 1.0f){
+          turbo->step_debt = 0;
+     }else{
+          std::chrono::duration<F64> elapsed = now - turbo->frame_start;
+          if(turbo->step_debt >= 1.0f && elapsed.count() + turbo->render_seconds < (F64)(FRAME_TIME)){
+               turbo->stepping = true;
+               return true;
+          }
+
+          // out of time, falling further behind every frame would only make the next frames choppier
+          if(turbo->step_debt >= 1.0f) turbo->step_debt = 0;
+     }
+
+     turbo->stepping = false;
+     turbo->render_start = now;
+     return false;
+}
+
+void demo_turbo_frame_end(DemoTurbo_t* turbo){
+     if(!turbo->on) return;
+
+     std::chrono::duration<F64> render_time = std::chrono::steady_clock::now() - turbo->render_start;
+     turbo->render_seconds = render_time.count();
+}
@@ -3,6 +3,11 @@
 #include "world.h"
 
 #include <stdio.h>
+#include <chrono>
+
+#define DEMO_VERSION 4
+#define DEMO_WRITE_BUFFER_SIZE 1024
+#define DEMO_CHECKSUM_INTERVAL 30
 
 enum PlayerActionType_t{
      PLAYER_ACTION_TYPE_MOVE_LEFT_START,
@@ -45,6 +50,39 @@ struct DemoEntries_t{
      S64 count = 0;
 };
 
+enum DemoChecksumField_t{
+     DEMO_CHECKSUM_FIELD_BLOCK_POSITIONS,
+     DEMO_CHECKSUM_FIELD_BLOCK_VELOCITIES,
+     DEMO_CHECKSUM_FIELD_TILE_FLAGS,
+     DEMO_CHECKSUM_FIELD_INTERACTIVES,
+     DEMO_CHECKSUM_FIELD_PLAYERS,
+     DEMO_CHECKSUM_FIELD_COUNT,
+};
+
+// a hash of each part of the world state, recorded every 'interval' frames starting at frame 'interval'
+struct DemoChecksum_t{
+     U32 fields[DEMO_CHECKSUM_FIELD_COUNT];
+};
+
+struct DemoChecksums_t{
+     DemoChecksum_t* checksums = nullptr;
+     S64 count = 0;
+     S32 interval = DEMO_CHECKSUM_INTERVAL;
+};
+
+struct DemoEndState_t{
+     S16 map_number;
+     DemoChecksum_t checksum;
+};
+
+// the checksum of the world at the end of every demo in a suite run. One build saves them and another compares against
+// them, so a change that should not affect the simulation can be shown to leave every end state bit identical
+struct DemoEndStates_t{
+     const char* filepath = nullptr;
+     bool save = false;
+     ObjectArray_t<DemoEndState_t> maps = {};
+};
+
 struct Demo_t{
      DemoMode_t mode = DEMO_MODE_NONE;
 
@@ -58,21 +96,56 @@ struct Demo_t{
      F32 dt_scalar = 1.0f;
      bool paused = false;
      DemoEntries_t entries;
+
+     // entries are buffered while recording and flushed when full or when the demo ends
+     U8 write_buffer[DEMO_WRITE_BUFFER_SIZE];
+     U32 write_buffer_used = 0;
+     S64 last_written_frame = 0;
+
+     DemoChecksums_t checksums;
+     S64 checksum_mismatch_frame = -1;
+};
+
+// in turbo, speeds above 1x simulate several frames for each rendered frame instead of rendering faster. The number of
+// steps follows dt_scalar until the simulation would eat into the time needed to draw, then the rest is dropped
+struct DemoTurbo_t{
+     bool on = false;
+     bool stepping = false; // more steps are owed before the next render
+     F32 step_debt = 0;
+     S32 frame_steps = 0;
+     F64 render_seconds = 0;
+     std::chrono::steady_clock::time_point frame_start;
+     std::chrono::steady_clock::time_point render_start;
 };
 
 bool demo_begin(Demo_t* demo);
-DemoEntries_t demo_entries_get(FILE* file);
+DemoEntries_t demo_entries_get(FILE* file, S32 version);
+void demo_write_entry(Demo_t* demo, DemoEntry_t* entry);
+void demo_flush(Demo_t* demo);
+
+DemoChecksums_t demo_checksums_get(FILE* file, S32 version);
+DemoChecksum_t demo_checksum_world(World_t* world);
+void demo_record_checksum(Demo_t* demo, World_t* world, S64 frame_count);
+bool demo_verify_checksum(Demo_t* demo, World_t* world, S64 frame_count);
+const char* demo_checksum_field_to_string(DemoChecksumField_t field);
 bool demo_play_frame(Demo_t* demo, PlayerAction_t* player_action, ObjectArray_t<Player_t>* players, S64 frame_count,
                      Demo_t* record_demo);
 
 void player_action_perform(PlayerAction_t* player_action, ObjectArray_t<Player_t>* players, PlayerActionType_t player_action_type,
-                           DemoMode_t demo_mode, FILE* demo_file, S64 frame_count);
+                           Demo_t* record_demo, S64 frame_count);
 
 FILE* load_demo_number(S32 map_number, const char** demo_filepath);
-void cache_for_demo_seek(World_t* world, TileMap_t* demo_starting_tilemap, ObjectArray_t<Block_t>* demo_starting_blocks,
-                         ObjectArray_t<Interactive_t>* demo_starting_interactives);
-void fetch_cache_for_demo_seek(World_t* world, TileMap_t* demo_starting_tilemap, ObjectArray_t<Block_t>* demo_starting_blocks,
-                               ObjectArray_t<Interactive_t>* demo_starting_interactives);
+void cache_for_demo_seek(World_t* world, WorldSnapshot_t* demo_starting_world);
+void fetch_cache_for_demo_seek(World_t* world, WorldSnapshot_t* demo_starting_world);
 bool load_map_number_demo(Demo_t* demo, S16 map_number, S64* frame_count);
 
 bool test_map_end_state(World_t* world, Demo_t* demo);
+
+void demo_end_state_record(DemoEndStates_t* end_states, S16 map_number, World_t* world);
+bool demo_end_states_report(DemoEndStates_t* end_states); // returns false if any end state differs from the file
+void destroy(DemoEndStates_t* end_states);
+
+F32 demo_turbo_frame_time(DemoTurbo_t* turbo, F32 dt_scalar);
+void demo_turbo_frame_begin(DemoTurbo_t* turbo, F32 dt_scalar);
+bool demo_turbo_step_again(DemoTurbo_t* turbo, F32 dt_scalar, bool paused);
+void demo_turbo_frame_end(DemoTurbo_t* turbo);
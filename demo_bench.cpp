@@ -0,0 +1,176 @@
+#include "demo_bench.h"
+#include "log.h"
+
+#include <stdlib.h>
+#include <inttypes.h>
+
+#ifndef WIN32
+     #include <sys/resource.h>
+#endif
+
+#define DEMO_BENCH_MIN_FRAME_TIMES 4096
+
+static S64 demo_bench_peak_rss_kb(){
+#ifdef WIN32
+     return 0;
+#else
+     struct rusage usage;
+     if(getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+     #ifdef __APPLE__
+          return (S64)(usage.ru_maxrss) / 1024; // bytes on mac
+     #else
+          return (S64)(usage.ru_maxrss);
+     #endif
+#endif
+}
+
+static int demo_bench_frame_time_comparer(const void* a, const void* b){
+     F32 frame_time_a = *(const F32*)(a);
+     F32 frame_time_b = *(const F32*)(b);
+     if(frame_time_a < frame_time_b) return -1;
+     if(frame_time_a > frame_time_b) return 1;
+     return 0;
+}
+
+// nearest rank percentile, frame_times must be sorted
+static F64 demo_bench_percentile(const F32* frame_times, S64 count, F64 percentile){
+     if(count == 0) return 0;
+     S64 rank = (S64)(percentile * (F64)(count) + 0.999999);
+     if(rank < 1) rank = 1;
+     if(rank > count) rank = count;
+     return frame_times[rank - 1];
+}
+
+void demo_bench_frame_begin(DemoBench_t* bench){
+     bench->frame_start = std::chrono::steady_clock::now();
+}
+
+void demo_bench_frame_end(DemoBench_t* bench){
+     auto frame_end = std::chrono::steady_clock::now();
+     std::chrono::duration<F32, std::milli> frame_time = frame_end - bench->frame_start;
+
+     if(bench->frame_time_count >= bench->frame_time_capacity){
+          S64 new_capacity = bench->frame_time_capacity ? bench->frame_time_capacity * 2 : DEMO_BENCH_MIN_FRAME_TIMES;
+          F32* new_frame_times = (F32*)(realloc(bench->frame_times, new_capacity * sizeof(*new_frame_times)));
+          if(!new_frame_times){
+               LOG("%s() failed to realloc %" PRId64 " frame times\n", __FUNCTION__, new_capacity);
+               return;
+          }
+          bench->frame_times = new_frame_times;
+          bench->frame_time_capacity = new_capacity;
+     }
+
+     bench->frame_times[bench->frame_time_count] = frame_time.count();
+     bench->frame_time_count++;
+}
+
+bool demo_bench_demo_finished(DemoBench_t* bench, S16 map_number){
+     bench->current_iteration++;
+     if(bench->current_iteration < bench->iterations) return true;
+
+     F64 total_ms = 0;
+     for(S64 i = 0; i < bench->frame_time_count; i++) total_ms += bench->frame_times[i];
+     qsort(bench->frame_times, bench->frame_time_count, sizeof(*bench->frame_times), demo_bench_frame_time_comparer);
+
+     if(resize(&bench->maps, bench->maps.count + 1)){
+          DemoBenchMap_t* map = bench->maps.elements + bench->maps.count - 1;
+          map->map_number = map_number;
+          map->iterations = bench->current_iteration;
+          map->frames = bench->frame_time_count;
+          map->sim_fps = (total_ms > 0) ? ((F64)(bench->frame_time_count) * 1000.0) / total_ms : 0;
+          map->p50_ms = demo_bench_percentile(bench->frame_times, bench->frame_time_count, 0.50);
+          map->p99_ms = demo_bench_percentile(bench->frame_times, bench->frame_time_count, 0.99);
+          map->peak_rss_kb = demo_bench_peak_rss_kb();
+
+          LOG("bench map %03d: %d iterations, %" PRId64 " frames, %.0f fps, p50 %.3fms, p99 %.3fms, peak rss %" PRId64 "KB\n",
+              map->map_number, map->iterations, map->frames, map->sim_fps, map->p50_ms, map->p99_ms, map->peak_rss_kb);
+     }
+
+     bench->current_iteration = 0;
+     bench->frame_time_count = 0;
+     return false;
+}
+
+static bool demo_bench_save_baseline(DemoBench_t* bench){
+     FILE* file = fopen(bench->baseline_filepath, "w");
+     if(!file){
+          LOG("%s(): failed to open '%s' for writing\n", __FUNCTION__, bench->baseline_filepath);
+          return false;
+     }
+
+     fprintf(file, "# map fps p50_ms p99_ms peak_rss_kb\n");
+     for(S16 i = 0; i < bench->maps.count; i++){
+          DemoBenchMap_t* map = bench->maps.elements + i;
+          fprintf(file, "%03d %f %f %f %" PRId64 "\n", map->map_number, map->sim_fps, map->p50_ms, map->p99_ms,
+                  map->peak_rss_kb);
+     }
+
+     fclose(file);
+     LOG("saved bench baseline of %d maps to '%s'\n", bench->maps.count, bench->baseline_filepath);
+     return true;
+}
+
+// only the fps is compared, single frame percentiles are too noisy between runs to fail on
+static bool demo_bench_compare_baseline(DemoBench_t* bench){
+     FILE* file = fopen(bench->baseline_filepath, "r");
+     if(!file){
+          LOG("%s(): failed to open '%s'\n", __FUNCTION__, bench->baseline_filepath);
+          return false;
+     }
+
+     S16 regression_count = 0;
+     S16 compared_count = 0;
+     char line[256];
+     while(fgets(line, sizeof(line), file)){
+          if(line[0] == '#') continue;
+
+          int map_number = 0;
+          double baseline_fps = 0;
+          if(sscanf(line, "%d %lf", &map_number, &baseline_fps) != 2) continue;
+
+          for(S16 i = 0; i < bench->maps.count; i++){
+               DemoBenchMap_t* map = bench->maps.elements + i;
+               if(map->map_number != map_number) continue;
+
+               compared_count++;
+               F64 change = (baseline_fps > 0) ? (map->sim_fps - baseline_fps) / baseline_fps : 0;
+               if(change < -bench->threshold){
+                    LOG("bench map %03d regressed: %.0f fps vs baseline %.0f fps (%+.1f%%)\n", map->map_number,
+                        map->sim_fps, baseline_fps, change * 100.0);
+                    regression_count++;
+               }
+               break;
+          }
+     }
+
+     fclose(file);
+
+     LOG("compared %d maps against bench baseline '%s', %d regressed more than %.1f%%\n", compared_count,
+         bench->baseline_filepath, regression_count, bench->threshold * 100.0f);
+     return regression_count == 0;
+}
+
+bool demo_bench_report(DemoBench_t* bench){
+     S64 total_frames = 0;
+     F64 total_seconds = 0;
+     for(S16 i = 0; i < bench->maps.count; i++){
+          DemoBenchMap_t* map = bench->maps.elements + i;
+          total_frames += map->frames;
+          if(map->sim_fps > 0) total_seconds += (F64)(map->frames) / map->sim_fps;
+     }
+
+     LOG("bench: %d maps, %" PRId64 " frames, %.0f fps overall, peak rss %" PRId64 "KB\n", bench->maps.count,
+         total_frames, (total_seconds > 0) ? (F64)(total_frames) / total_seconds : 0.0, demo_bench_peak_rss_kb());
+
+     if(!bench->baseline_filepath) return true;
+     if(bench->save_baseline) return demo_bench_save_baseline(bench);
+     return demo_bench_compare_baseline(bench);
+}
+
+void destroy(DemoBench_t* bench){
+     free(bench->frame_times);
+     bench->frame_times = nullptr;
+     bench->frame_time_count = 0;
+     bench->frame_time_capacity = 0;
+     destroy(&bench->maps);
+}
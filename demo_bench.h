@@ -0,0 +1,48 @@
+#pragma once
+
+#include "types.h"
+#include "object_array.h"
+
+#include <chrono>
+
+#define DEMO_BENCH_DEFAULT_ITERATIONS 3
+#define DEMO_BENCH_DEFAULT_THRESHOLD 0.1f
+
+struct DemoBenchMap_t{
+     S16 map_number;
+     S32 iterations;
+     S64 frames;
+     F64 sim_fps;
+     F64 p50_ms;
+     F64 p99_ms;
+     S64 peak_rss_kb; // high water mark of the whole process by the time this map finished
+};
+
+// times every simulated frame while the suite replays demos headless, each demo is replayed 'iterations' times
+struct DemoBench_t{
+     S32 iterations = DEMO_BENCH_DEFAULT_ITERATIONS;
+     S32 current_iteration = 0;
+     F32 threshold = DEMO_BENCH_DEFAULT_THRESHOLD; // fraction of the baseline fps a map may lose before it fails
+     const char* baseline_filepath = nullptr;
+     bool save_baseline = false;
+
+     std::chrono::steady_clock::time_point frame_start;
+
+     // every iteration of the current map, in milliseconds
+     F32* frame_times = nullptr;
+     S64 frame_time_count = 0;
+     S64 frame_time_capacity = 0;
+
+     ObjectArray_t<DemoBenchMap_t> maps = {};
+};
+
+void demo_bench_frame_begin(DemoBench_t* bench);
+void demo_bench_frame_end(DemoBench_t* bench);
+
+// returns true if the demo should be replayed again, otherwise the map's results are recorded
+bool demo_bench_demo_finished(DemoBench_t* bench, S16 map_number);
+
+// logs the results and either saves them as the baseline or compares against it, returns false if a map regressed
+bool demo_bench_report(DemoBench_t* bench);
+
+void destroy(DemoBench_t* bench);
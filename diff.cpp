@@ -11,7 +11,7 @@ void calculate_world_changes(World_t* world, ObjectArray_t<DiffEntry_t>* diff){
      size_t diff_count = 0;
      for(S16 y = 0; y < world->tilemap.height; y++){
           for(S16 x = 0; x < world->tilemap.width; x++){
-               if(world->tilemap.tiles[y][x].flags != world->initial_shallow_world.tilemap.tiles[y][x].flags){
+               if(tilemap_tile(&world->tilemap, x, y)->flags != tilemap_tile(&world->initial_shallow_world.tilemap, x, y)->flags){
                     diff_count++;
                }
           }
@@ -47,11 +47,11 @@ void calculate_world_changes(World_t* world, ObjectArray_t<DiffEntry_t>* diff){
      diff_count = 0;
      for(S16 y = 0; y < world->tilemap.height; y++){
           for(S16 x = 0; x < world->tilemap.width; x++){
-               if(world->tilemap.tiles[y][x].flags != world->initial_shallow_world.tilemap.tiles[y][x].flags){
+               if(tilemap_tile(&world->tilemap, x, y)->flags != tilemap_tile(&world->initial_shallow_world.tilemap, x, y)->flags){
                     auto* diff_entry = diff->elements + diff_count;
                     diff_entry->type = DIFF_TILE_FLAGS;
                     diff_entry->index = y * world->tilemap.width + x;
-                    diff_entry->tile_flags = world->tilemap.tiles[y][x].flags;
+                    diff_entry->tile_flags = tilemap_tile(&world->tilemap, x, y)->flags;
                     diff_count++;
                }
           }
@@ -97,7 +97,8 @@ void apply_diff_to_world(World_t* world, ObjectArray_t<DiffEntry_t>* diff){
                int x = entry->index % world->tilemap.width;
                int y = entry->index / world->tilemap.width;
 
-               world->tilemap.tiles[y][x].flags = entry->tile_flags;
+               tilemap_tile(&world->tilemap, x, y)->flags = entry->tile_flags;
+               tilemap_sync_flag_planes(&world->tilemap, tilemap_tile(&world->tilemap, x, y));
           } break;
           case DIFF_INTERACTIVE:
                build_interactive_from_map_interactive(world->interactives.elements + entry->index, &entry->interactive);
@@ -122,10 +123,10 @@ bool world_rect_has_changed(World_t* world, Rect_t rect){
           for(S16 x = rect.left; x <= rect.right; x++){
                Coord_t coord{x, y};
 
-               if(world->tilemap.tiles[y][x].flags & TILE_FLAG_RESET_IMMUNE){
+               if(tilemap_tile(&world->tilemap, x, y)->flags & TILE_FLAG_RESET_IMMUNE){
                     // ignore flag changes and interactive changes on reset immune tiles
                }else{
-                    if(world->tilemap.tiles[y][x].flags != world->initial_shallow_world.tilemap.tiles[y][x].flags){
+                    if(tilemap_tile(&world->tilemap, x, y)->flags != tilemap_tile(&world->initial_shallow_world.tilemap, x, y)->flags){
                          return true;
                     }
 
@@ -697,7 +697,7 @@ void draw_world_row_solids(S16 y, S16 x_start, S16 x_end, TileMap_t* tilemap, Qu
           if(block->entangle_index >= 0){
                S32 tint_index = -1;
                for(S16 t = 0; t < entangle_tints->block_to_tint_index.count; t++){
-                    auto* converter = entangle_tints->block_to_tint_index.elements + t;
+                    auto* converter = entangle_tints->block_to_tint_index.objects + t;
                     if(converter->block == block){
                          tint_index = converter->index;
                          break;
@@ -11,6 +11,7 @@
 #include "arrow.h"
 #include "quad.h"
 #include "ui.h"
+#include "frame_arena.h"
 
 #include <SDL2/SDL_opengl.h>
 
@@ -61,7 +62,7 @@ struct EntangleTints_t{
      ObjectArray_t<BitmapPixel_t> tints;
 
      // TODO: linear search could be improved
-     ObjectArray_t<BlockToTintIndex_t> block_to_tint_index;
+     FrameArray_t<BlockToTintIndex_t> block_to_tint_index; // reset right after frame_arena_reset(), rebuilt every frame
 };
 
 Vec_t theme_frame(S16 x, S16 y);
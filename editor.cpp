@@ -646,6 +646,7 @@ void apply_stamp(Stamp_t* stamp, Coord_t coord, TileMap_t* tilemap, ObjectArray_
                tile->rotation = stamp->tile.rotation;
                if(stamp->tile.solid){
                     tile->flags |= TILE_FLAG_SOLID;
+                    tilemap_sync_flag_planes(tilemap, tile);
                }
           }
      } break;
@@ -658,6 +659,7 @@ void apply_stamp(Stamp_t* stamp, Coord_t coord, TileMap_t* tilemap, ObjectArray_
                }else{
                     tile->flags = stamp->tile_flags;
                }
+               tilemap_sync_flag_planes(tilemap, tile);
           }
      } break;
      case STAMP_TYPE_BLOCK:
@@ -709,6 +711,7 @@ void coord_clear(Coord_t coord, TileMap_t* tilemap, ObjectArray_t<Interactive_t>
           tile->id = 0;
           tile->flags = 0;
           tile->rotation = 0;
+          tilemap_sync_flag_planes(tilemap, tile);
      }
 
      auto* interactive = quad_tree_interactive_find_at(interactive_quad_tree, coord);
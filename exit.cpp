@@ -18,6 +18,27 @@ void read_exit(FILE* file, Exit_t* exit){
      fread(&exit->destination_index, sizeof(exit->destination_index), 1, file);
 }
 
+U64 exit_serialized_size(const Exit_t* exit){
+     size_t length = strnlen((const char*)(exit->path), EXIT_MAX_PATH_SIZE);
+     return sizeof(length) + length + sizeof(exit->destination_index);
+}
+
+// returns the number of bytes read, 0 if the bytes do not contain a valid exit
+U64 read_exit_from_bytes(const U8* bytes, U64 byte_count, Exit_t* exit){
+     memset(exit->path, 0, EXIT_MAX_PATH_SIZE);
+     size_t length = 0;
+     if(byte_count < sizeof(length)) return 0;
+     memcpy(&length, bytes, sizeof(length));
+     if(length > EXIT_MAX_PATH_SIZE) return 0;
+
+     U64 total_size = sizeof(length) + length + sizeof(exit->destination_index);
+     if(byte_count < total_size) return 0;
+
+     memcpy(exit->path, bytes + sizeof(length), length);
+     memcpy(&exit->destination_index, bytes + sizeof(length) + length, sizeof(exit->destination_index));
+     return total_size;
+}
+
 Quad_t exit_ui_query(ExitUIType_t type, S16 index, ObjectArray_t<Exit_t>* exits){
      const F32 text_height_spacing = TEXT_CHAR_HEIGHT + TEXT_CHAR_SPACING;
      const F32 text_width_spacing = TEXT_CHAR_WIDTH + TEXT_CHAR_SPACING;
@@ -25,5 +25,7 @@ struct Exit_t{
 
 void write_exit(FILE* file, const Exit_t* exit);
 void read_exit(FILE* file, Exit_t* exit);
+U64 exit_serialized_size(const Exit_t* exit);
+U64 read_exit_from_bytes(const U8* bytes, U64 byte_count, Exit_t* exit);
 
 Quad_t exit_ui_query(ExitUIType_t type, S16 index, ObjectArray_t<Exit_t>* exits);
@@ -0,0 +1,89 @@
+#include "frame_arena.h"
+#include "log.h"
+
+#include <stdlib.h>
+
+static thread_local FrameArena_t frame_arena;
+
+static size_t frame_arena_align(size_t size){
+     return (size + (FRAME_ARENA_ALIGNMENT - 1)) & ~(size_t)(FRAME_ARENA_ALIGNMENT - 1);
+}
+
+// the chunk header is padded so the memory after it stays aligned
+static U8* frame_arena_chunk_memory(FrameArenaChunk_t* chunk){
+     return (U8*)(chunk) + frame_arena_align(sizeof(*chunk));
+}
+
+static FrameArenaChunk_t* frame_arena_new_chunk(size_t size, FrameArenaChunk_t* prev){
+     FrameArenaChunk_t* chunk = (FrameArenaChunk_t*)(malloc(frame_arena_align(sizeof(*chunk)) + size));
+     if(!chunk){
+          LOG("%s() failed to allocate %zu bytes\n", __FUNCTION__, size);
+          return NULL;
+     }
+     chunk->prev = prev;
+     chunk->size = size;
+     chunk->used = 0;
+     return chunk;
+}
+
+static void frame_arena_free_chunks(FrameArena_t* arena){
+     while(arena->chunk){
+          FrameArenaChunk_t* prev = arena->chunk->prev;
+          free(arena->chunk);
+          arena->chunk = prev;
+     }
+     arena->total_size = 0;
+}
+
+FrameArena_t::~FrameArena_t(){
+     frame_arena_free_chunks(this);
+}
+
+void* frame_arena_alloc(size_t size){
+     size = frame_arena_align(size);
+
+     FrameArenaChunk_t* chunk = frame_arena.chunk;
+     if(!chunk || chunk->used + size > chunk->size){
+          // chunks are never moved, so earlier allocations stay valid while the arena grows
+          size_t chunk_size = chunk ? chunk->size * 2 : FRAME_ARENA_MIN_CHUNK_SIZE;
+          while(chunk_size < size) chunk_size *= 2;
+
+          chunk = frame_arena_new_chunk(chunk_size, chunk);
+          if(!chunk) return NULL;
+
+          frame_arena.chunk = chunk;
+          frame_arena.total_size += chunk_size;
+     }
+
+     void* memory = frame_arena_chunk_memory(chunk) + chunk->used;
+     chunk->used += size;
+     return memory;
+}
+
+void frame_arena_reset(){
+     FrameArenaChunk_t* chunk = frame_arena.chunk;
+     if(!chunk) return;
+
+     // if the last frame outgrew the first chunk, replace them all with one chunk big enough for the whole frame
+     if(chunk->prev){
+          size_t total_size = frame_arena.total_size;
+          frame_arena_free_chunks(&frame_arena);
+          frame_arena.chunk = frame_arena_new_chunk(total_size, NULL);
+          if(frame_arena.chunk) frame_arena.total_size = total_size;
+          return;
+     }
+
+     chunk->used = 0;
+}
+
+void frame_arena_destroy(){
+     frame_arena_free_chunks(&frame_arena);
+}
+
+size_t frame_arena_used(){
+     size_t used = 0;
+     for(FrameArenaChunk_t* chunk = frame_arena.chunk; chunk; chunk = chunk->prev){
+          used += chunk->used;
+     }
+     return used;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <new>
+#include <string.h>
+
+#include "types.h"
+
+#define FRAME_ARENA_MIN_CHUNK_SIZE (64 * 1024)
+#define FRAME_ARENA_ALIGNMENT 16
+
+struct FrameArenaChunk_t{
+     FrameArenaChunk_t* prev;
+     size_t size;
+     size_t used;
+};
+
+// bump allocator for scratch memory that only lives until the end of the frame, nothing is freed individually,
+// frame_arena_reset() throws everything away at once. Each thread gets its own arena.
+struct FrameArena_t{
+     FrameArenaChunk_t* chunk = NULL;
+     size_t total_size = 0;
+
+     ~FrameArena_t();
+};
+
+void* frame_arena_alloc(size_t size);
+void frame_arena_reset();
+void frame_arena_destroy();
+size_t frame_arena_used();
+
+template <typename T>
+T* frame_arena_alloc_array(S32 count){
+     return (T*)(frame_arena_alloc(count * sizeof(T)));
+}
+
+// growable array backed by the frame arena, it has the same interface as StaticObjectArray_t but never runs out of
+// room. Copies get their own storage, so they behave like the static version. T is copied around with memcpy when
+// growing and is never destructed, so it can't own anything outside of the arena. One that outlives a frame has to be
+// assigned an empty FrameArray_t after frame_arena_reset(), clear() keeps the storage the reset just threw away.
+template <typename T>
+struct FrameArray_t{
+     T* objects = NULL;
+     S32 count = 0;
+     S32 capacity = 0;
+
+     FrameArray_t() = default;
+
+     FrameArray_t(const FrameArray_t<T>& other){
+          copy(&other);
+     }
+
+     FrameArray_t(FrameArray_t<T>&& other){
+          objects = other.objects;
+          count = other.count;
+          capacity = other.capacity;
+          other.objects = NULL;
+          other.count = 0;
+          other.capacity = 0;
+     }
+
+     // the old storage is left to the arena, this may be assigned on top of uninitialized memory
+     FrameArray_t<T>& operator=(const FrameArray_t<T>& other){
+          if(this != &other) copy(&other);
+          return *this;
+     }
+
+     void copy(const FrameArray_t<T>* other){
+          objects = NULL;
+          count = 0;
+          capacity = 0;
+          if(other->count == 0) return;
+          if(!reserve(other->count)) return;
+          for(S32 i = 0; i < other->count; i++) new (objects + i) T(other->objects[i]);
+          count = other->count;
+     }
+
+     bool reserve(S32 new_capacity){
+          if(new_capacity <= capacity) return true;
+          T* new_objects = frame_arena_alloc_array<T>(new_capacity);
+          if(!new_objects) return false;
+          if(count) memcpy((void*)(new_objects), (void*)(objects), count * sizeof(T));
+          objects = new_objects;
+          capacity = new_capacity;
+          return true;
+     }
+
+     // like resize() for ObjectArray_t, the new objects are left uninitialized
+     bool resize(S32 new_count){
+          if(new_count > capacity){
+               S32 new_capacity = capacity ? capacity : 8;
+               while(new_capacity < new_count) new_capacity *= 2;
+               if(!reserve(new_capacity)) return false;
+          }
+          count = new_count;
+          return true;
+     }
+
+     bool insert(const T* obj){
+          if(count >= capacity && !reserve(capacity ? capacity * 2 : 8)) return false;
+          new (objects + count) T(*obj);
+          count++;
+          return true;
+     }
+
+     bool merge(FrameArray_t<T>* object_array){
+          if(!reserve(count + object_array->count)) return false;
+          for(S32 i = 0; i < object_array->count; i++){
+               if(!insert(object_array->objects + i)){
+                    return false;
+               }
+          }
+          return true;
+     }
+
+     void clear(){
+          count = 0;
+     }
+};
@@ -191,23 +191,25 @@ Progression Requirements:
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_opengl.h>
 
-// linux specific
-#include <dirent.h>
-
 #include "log.h"
 #include "centroid.h"
 #include "demo.h"
+#include "demo_bench.h"
+#include "solver.h"
 #include "conversion.h"
 #include "portal_exit.h"
 #include "player_block_push.h"
 #include "map_format.h"
 #include "draw.h"
 #include "block_collisions.h"
+#include "collision_island.h"
 #include "collision.h"
 #include "editor.h"
 #include "utils.h"
 #include "tags.h"
 #include "thumbnail.h"
+#include "thumbnail_cache.h"
+#include "map_index.h"
 #include "diff.h"
 
 #define CHECKBOX_START_OFFSET_X (4.0f * PIXEL_SIZE)
@@ -237,16 +239,6 @@ struct DoBlockCollisionResults_t{
      S16 update_blocks_count;
 };
 
-struct FindMapResult_t{
-     char* path = NULL;
-     int map_number = 0;
-};
-
-struct FindAllMapsResult_t{
-     FindMapResult_t* entries = NULL;
-     U32 count = 0;
-};
-
 LogMapNumberResult_t load_map_number_map(S16 map_number, World_t* world, Undo_t* undo,
                                          Coord_t* player_start, PlayerAction_t* player_action,
                                          Camera_t* camera, bool* tags){
@@ -283,7 +275,7 @@ void log_block_push(BlockMomentumPush_t* block_push)
     }
 }
 
-void log_block_pushes(BlockMomentumPushes_t<128>& block_pushes)
+void log_block_pushes(BlockMomentumPushes_t& block_pushes)
 {
     if(block_pushes.count > 0){
         LOG("block pushes: %d\n", block_pushes.count);
@@ -342,8 +334,7 @@ void stop_player_action_movement(PlayerAction_t* player_action, ObjectArray_t<Pl
                     break;
                }
 
-               player_action_perform(player_action, players, stop_action,
-                                     record_demo->mode, record_demo->file, frame_count);
+               player_action_perform(player_action, players, stop_action, record_demo, frame_count);
           }
      }
 }
@@ -441,7 +432,7 @@ void handle_blocks_colliding_moving_in_the_same_direction_vertical(Block_t* bloc
      }
 }
 
-void generate_pushes_from_collision(World_t* world, CheckBlockCollisionResult_t* collision_result, BlockMomentumPushes_t<128>* block_pushes){
+void generate_pushes_from_collision(World_t* world, CheckBlockCollisionResult_t* collision_result, BlockMomentumPushes_t* block_pushes){
      if(collision_result->unused) return;
      Block_t* block = world->blocks.elements + collision_result->block_index;
      Position_t block_pos = block_get_position(block);
@@ -511,17 +502,18 @@ void generate_pushes_from_collision(World_t* world, CheckBlockCollisionResult_t*
 
                // TODO: it would be nice to check for this block specifically instead of doing a query again
                bool against_block = false;
-               auto against_result = block_against_other_blocks(block_pos + block_pos_delta, block_cut, direction, world->block_qt, world->interactive_qt, &world->tilemap);
+               auto against_result = block_against_other_blocks(block_pos + block_pos_delta, block_cut, direction, world->block_qt, &world->blocks, world->interactive_qt, &world->tilemap);
                bool all_on_frictionless = true;
                for(S16 a = 0; a < against_result.count; a++){
                     auto* against = against_result.objects + a;
-                    if(against->block == collided_block){
+                    if(against->block.index == collided_with_block->block_index){
                          against_block = true;
                     }
 
-                    Position_t against_block_pos = block_get_position(against->block);
-                    Vec_t against_block_pos_delta = block_get_pos_delta(against->block);
-                    auto against_block_cut = block_get_cut(against->block);
+                    Block_t* against_other_block = block_from_handle(&world->blocks, against->block);
+                    Position_t against_block_pos = block_get_position(against_other_block);
+                    Vec_t against_block_pos_delta = block_get_pos_delta(against_other_block);
+                    auto against_block_cut = block_get_cut(against_other_block);
 
                     all_on_frictionless &= block_on_frictionless(against_block_pos, against_block_pos_delta, against_block_cut, &world->tilemap, world->interactive_qt, world->block_qt);
                }
@@ -541,12 +533,9 @@ void generate_pushes_from_collision(World_t* world, CheckBlockCollisionResult_t*
 
                while(true){
                     // TODO: handle multiple against blocks
-                    Position_t last_block_in_chain_final_pos = block_get_final_position(last_block_in_chain);
-                    auto last_block_in_chain_cut = block_get_cut(last_block_in_chain);
-                    auto chain_against_result = block_against_other_blocks(last_block_in_chain_final_pos, last_block_in_chain_cut,
-                                                                           against_direction, world->block_qt, world->interactive_qt, &world->tilemap);
+                    auto chain_against_result = block_against_other_blocks(last_block_in_chain, against_direction, world);
                     if(chain_against_result.count > 0){
-                         last_block_in_chain = chain_against_result.objects[0].block;
+                         last_block_in_chain = block_from_handle(&world->blocks, chain_against_result.objects[0].block);
                          against_direction = direction_rotate_clockwise(against_direction, chain_against_result.objects[0].rotations_through_portal);
                          rotations_between_last_in_chain += chain_against_result.objects[0].rotations_through_portal;
                     }else{
@@ -669,9 +658,9 @@ void generate_pushes_from_collision(World_t* world, CheckBlockCollisionResult_t*
                }
           }else{
                auto against = block_diagonally_against_block(block->pos + block->pos_delta, block_cut, collided_with_block->direction_mask, &world->tilemap,
-                                                             world->interactive_qt, world->block_qt);
+                                                             world->interactive_qt, world->block_qt, &world->blocks);
 
-               if(against.block != collided_block) continue;
+               if(against.block.index != collided_with_block->block_index) continue;
 
                against_block_count = 1;
 
@@ -685,9 +674,10 @@ void generate_pushes_from_collision(World_t* world, CheckBlockCollisionResult_t*
                     Position_t last_block_in_chain_final_pos = block_get_final_position(last_block_in_chain);
                     auto last_block_in_chain_cut = block_get_cut(last_block_in_chain);
                     against = block_diagonally_against_block(last_block_in_chain_final_pos, last_block_in_chain_cut,
-                                                             against_direction_mask, &world->tilemap, world->interactive_qt, world->block_qt);
-                    if(against.block){
-                         last_block_in_chain = against.block;
+                                                             against_direction_mask, &world->tilemap, world->interactive_qt, world->block_qt, &world->blocks);
+                    Block_t* against_block = block_from_handle(&world->blocks, against.block);
+                    if(against_block){
+                         last_block_in_chain = against_block;
                          against_direction_mask = direction_mask_rotate_clockwise(against_direction_mask, against.rotations_through_portal);
                          rotations_between_last_in_chain += against.rotations_through_portal;
                     }else{
@@ -1001,12 +991,13 @@ DoBlockCollisionResults_t do_block_collision(World_t* world, Block_t* block, S16
                     }else{
                          S16 new_block_index = world->blocks.count;
                          S16 old_block_index = (S16)(block - world->blocks.elements);
+                         ObjectHandle_t block_handle = object_handle(&world->blocks, old_block_index);
 
                          if(resize(&world->blocks, world->blocks.count + (S16)(1))){
                               add_global_tag(TAG_BLOCK_GETS_ENTANGLED);
 
-                              // a resize will kill our block ptr, so we gotta update it
-                              block = world->blocks.elements + old_block_index;
+                              // growing may move the blocks, so look our block back up
+                              block = object_from_handle(&world->blocks, block_handle);
                               block->clone_start = portal->coord;
 
                               Block_t* entangled_block = world->blocks.elements + new_block_index;
@@ -1116,8 +1107,8 @@ DoBlockCollisionResults_t do_block_collision(World_t* world, Block_t* block, S16
      return result;
 }
 
-void add_entangle_pushes_for_end_of_chain_blocks_on_ice(World_t* world, S16 push_index, BlockMomentumPushes_t<128>* block_pushes,
-                                                        BlockMomentumPushes_t<128>* new_block_pushes){
+void add_entangle_pushes_for_end_of_chain_blocks_on_ice(World_t* world, S16 push_index, BlockMomentumPushes_t* block_pushes,
+                                                        BlockMomentumPushes_t* new_block_pushes){
      BlockMomentumPush_t* push = block_pushes->pushes + push_index;
 
      Block_t* pushee = world->blocks.elements + push->pushee_index;
@@ -1134,18 +1125,15 @@ void add_entangle_pushes_for_end_of_chain_blocks_on_ice(World_t* world, S16 push
 
      auto block_push_momentum = get_block_push_pusher_momentum(push, world, rotated_direction);
 
-     auto chain_result = find_block_chain(pushee, rotated_direction, world->block_qt, world->interactive_qt, &world->tilemap);
+     auto chain_result = find_block_chain(pushee, rotated_direction, world);
 
      if(chain_result.count > 0){
           push->no_entangled_pushes = true;
      }
 
-     auto against_result = block_against_other_blocks(pushee_pos + pushee_pos_delta, pushee_cut,
-                                                      rotated_direction, world->block_qt, world->interactive_qt,
-                                                      &world->tilemap);
+     auto against_result = block_against_other_blocks(pushee, rotated_direction, world);
 
-     S16 added_indices[MAX_BLOCKS_IN_CHAIN];
-     S16 added_indices_count = 0;
+     FrameArray_t<S16> added_indices;
 
      for(S16 c = 0; c < chain_result.count; c++){
           BlockChain_t* chain = chain_result.objects + c;
@@ -1170,8 +1158,8 @@ void add_entangle_pushes_for_end_of_chain_blocks_on_ice(World_t* world, S16 push
                Block_t* entangler = world->blocks.elements + current_entangle_index;
 
                bool already_added = false;
-               for(S16 a = 0; a < added_indices_count; a++){
-                    if(current_entangle_index == added_indices[a]){
+               for(S16 a = 0; a < added_indices.count; a++){
+                    if(current_entangle_index == added_indices.objects[a]){
                          already_added = true;
                          break;
                     }
@@ -1183,8 +1171,9 @@ void add_entangle_pushes_for_end_of_chain_blocks_on_ice(World_t* world, S16 push
                }
 
                // get the chain in the direction of the push for each entangled block
-               auto entangled_chain_result = find_block_chain(entangler, rotated_direction, world->block_qt, world->interactive_qt, &world->tilemap);
+               auto entangled_chain_result = find_block_chain(entangler, rotated_direction, world);
                for(S16 e = 0; e < chain_result.count; e++){
+                    if(c >= entangled_chain_result.count) continue;
                     BlockChain_t* entangled_chain = entangled_chain_result.objects + c;
                     if(entangled_chain->count <= 0) continue;
 
@@ -1197,8 +1186,8 @@ void add_entangle_pushes_for_end_of_chain_blocks_on_ice(World_t* world, S16 push
 
                          // TODO: compress this with above
                          already_added = false;
-                         for(S16 a = 0; a < added_indices_count; a++){
-                              if(current_entangle_index == added_indices[a]){
+                         for(S16 a = 0; a < added_indices.count; a++){
+                              if(current_entangle_index == added_indices.objects[a]){
                                    already_added = true;
                                    break;
                               }
@@ -1237,9 +1226,7 @@ void add_entangle_pushes_for_end_of_chain_blocks_on_ice(World_t* world, S16 push
 
                          new_block_pushes->add(&new_block_push);
 
-                         added_indices[added_indices_count] = new_block_push.pushee_index;
-                         added_indices_count++;
-                         assert(added_indices_count <= MAX_BLOCKS_IN_CHAIN);
+                         added_indices.insert(&new_block_push.pushee_index);
                     }
 
                     current_entangle_index = entangler->entangle_index;
@@ -1248,7 +1235,7 @@ void add_entangle_pushes_for_end_of_chain_blocks_on_ice(World_t* world, S16 push
      }
 }
 
-void generate_entangled_block_pushes(BlockMomentumPushes_t<128>* block_pushes, BlockMomentumPushes_t<128>* new_block_pushes,
+void generate_entangled_block_pushes(BlockMomentumPushes_t* block_pushes, BlockMomentumPushes_t* new_block_pushes,
                                      World_t* world){
      for(S16 i = 0; i < block_pushes->count; i++){
           auto& block_push = block_pushes->pushes[i];
@@ -1276,16 +1263,11 @@ void generate_entangled_block_pushes(BlockMomentumPushes_t<128>* block_pushes, B
           S16 current_entangle_index = pushee->entangle_index;
           while(current_entangle_index != block_push.pushee_index && current_entangle_index >= 0){
               Block_t* entangler = world->blocks.elements + current_entangle_index;
-              Position_t entangler_pos = block_get_position(entangler);
-              Vec_t entangler_pos_delta = block_get_pos_delta(entangler);
-              auto entangler_cut = block_get_cut(entangler);
               S8 rotations_between_blocks = blocks_rotations_between(entangler, pushee);
               S8 total_rotations = (rotations_between_blocks + block_push_rotations) % DIRECTION_COUNT;
               Direction_t direction_to_check = direction_rotate_clockwise(block_push.direction, total_rotations);
 
-              auto block_against_result = block_against_other_blocks(entangler_pos + entangler_pos_delta,
-                                                                     entangler_cut, direction_to_check, world->block_qt,
-                                                                     world->interactive_qt, &world->tilemap);
+              auto block_against_result = block_against_other_blocks(entangler, direction_to_check, world);
               if(block_against_result.count == 0){
                    BlockMomentumPush_t new_block_push = block_push;
                    new_block_push.direction = block_push.direction;
@@ -1309,7 +1291,7 @@ void generate_entangled_block_pushes(BlockMomentumPushes_t<128>* block_pushes, B
                         new_block_push.add_pusher(current_entangle_index, block_against_result.count, false,
                                                   rotations_between_blocks);
                         new_block_push.direction = direction_to_check;
-                        new_block_push.pushee_index = against->block - world->blocks.elements;
+                        new_block_push.pushee_index = against->block.index;
                         new_block_push.portal_rotations = 0;
                         new_block_push.entangle_rotations = 0;
                         new_block_push.entangled_with_push_index = i;
@@ -1327,12 +1309,23 @@ void generate_entangled_block_pushes(BlockMomentumPushes_t<128>* block_pushes, B
      }
 }
 
-void consolidate_block_pushes(BlockMomentumPushes_t<128>* block_pushes, BlockMomentumPushes_t<128>* consolidated_block_pushes){
+void consolidate_block_pushes(BlockMomentumPushes_t* block_pushes, BlockMomentumPushes_t* consolidated_block_pushes){
+     // index the consolidated pushes by pushee and direction so each push doesn't rescan all of them
+     BlockPushIndex_t consolidated_index;
+     consolidated_index.init(block_pushes->count + consolidated_block_pushes->count);
+     for(S16 i = 0; i < consolidated_block_pushes->count; i++){
+          auto* consolidated_push = consolidated_block_pushes->pushes + i;
+          consolidated_index.insert(block_push_pair_hash(consolidated_push->pushee_index, consolidated_push->direction), i);
+     }
+
      for(S16 i = 0; i < block_pushes->count; i++){
           auto* push = block_pushes->pushes + i;
           if(push->invalidated) continue;
           if(push->no_consolidate){
-               consolidated_block_pushes->add(push);
+               if(consolidated_block_pushes->add(push)){
+                    consolidated_index.insert(block_push_pair_hash(push->pushee_index, push->direction),
+                                              consolidated_block_pushes->count - 1);
+               }
                continue;
           }
 
@@ -1343,7 +1336,8 @@ void consolidate_block_pushes(BlockMomentumPushes_t<128>* block_pushes, BlockMom
 
           // consolidate pushes if we can
           bool consolidated_current_push = false;
-          for(S16 j = 0; j < consolidated_block_pushes->count; j++){
+          U32 slot = block_push_pair_hash(push->pushee_index, rot_direction) & consolidated_index.mask;
+          for(S16 j = consolidated_index.next(&slot); j >= 0; j = consolidated_index.next(&slot)){
                auto* consolidated_push = consolidated_block_pushes->pushes + j;
 
                if(consolidated_push->no_consolidate) continue;
@@ -1359,7 +1353,10 @@ void consolidate_block_pushes(BlockMomentumPushes_t<128>* block_pushes, BlockMom
           }
 
           // otherwise just add it
-          if(!consolidated_current_push) consolidated_block_pushes->add(push);
+          if(!consolidated_current_push && consolidated_block_pushes->add(push)){
+               consolidated_index.insert(block_push_pair_hash(push->pushee_index, push->direction),
+                                         consolidated_block_pushes->count - 1);
+          }
      }
 
      // Do a pass checking for blocks being pushed that are themselves pushing. When they are being pushed we need
@@ -1384,10 +1381,9 @@ void consolidate_block_pushes(BlockMomentumPushes_t<128>* block_pushes, BlockMom
      }
 }
 
-void restart_demo(World_t* world, TileMap_t* demo_starting_tilemap, ObjectArray_t<Block_t>* demo_starting_blocks,
-                  ObjectArray_t<Interactive_t>* demo_starting_interactives, Demo_t* demo, S64* frame_count,
+void restart_demo(World_t* world, WorldSnapshot_t* demo_starting_world, Demo_t* demo, S64* frame_count,
                   Coord_t* player_start, PlayerAction_t* player_action, Undo_t* undo, Camera_t* camera){
-     fetch_cache_for_demo_seek(world, demo_starting_tilemap, demo_starting_blocks, demo_starting_interactives);
+     fetch_cache_for_demo_seek(world, demo_starting_world);
 
      reset_map(*player_start, world, undo, camera);
 
@@ -1398,67 +1394,7 @@ void restart_demo(World_t* world, TileMap_t* demo_starting_tilemap, ObjectArray_
      *frame_count = 0;
 }
 
-int get_numbered_map(const char* path){
-    char number_str[4];
-    memset(number_str, 0, 4);
-
-    U32 digits_left = 3;
-    while(*path){
-         if(digits_left > 0){
-              if(!isdigit(*path)) return -1;
-              number_str[3 - digits_left] = *path;
-              digits_left--;
-         }else{
-              if(*path == '_') break;
-              return -1;
-         }
-         path++;
-    }
-
-    return atoi(number_str);
-}
-
-FindAllMapsResult_t find_all_maps(){
-     FindAllMapsResult_t result;
-     U32 map_count = 0;
-
-     {
-          DIR* d = opendir("content");
-          if(!d) return result;
-          struct dirent* dir;
-          while((dir = readdir(d)) != nullptr){
-               if(strstr(dir->d_name, ".bm") && get_numbered_map(dir->d_name) >= 0){
-                    map_count++;
-               }
-          }
-          closedir(d);
-     }
-
-     result.count = map_count;
-     result.entries = (FindMapResult_t*)(malloc(map_count * sizeof(*result.entries)));
-
-     map_count = 0;
-     {
-          DIR* d = opendir("content");
-          if(!d) return result;
-          struct dirent* dir;
-          char full_path[256];
-          while((dir = readdir(d)) != nullptr){
-               int map_number = get_numbered_map(dir->d_name);
-               if(strstr(dir->d_name, ".bm") && map_number >= 0){
-                    snprintf(full_path, 256, "content/%s", dir->d_name);
-                    result.entries[map_count].path = strdup(full_path);
-                    result.entries[map_count].map_number = map_number;
-                    map_count++;
-               }
-          }
-          closedir(d);
-     }
-
-     return result;
-}
-
-bool this_block_has_already_pushed_others(BlockMomentumPushes_t<128>* block_pushes, S16 block_pushes_executed,
+bool this_block_has_already_pushed_others(BlockMomentumPushes_t* block_pushes, S16 block_pushes_executed,
                                           BlockMomentumPush_t* push_to_check, BlockMomentumPusher_t* pusher_to_check){
      // if we find pushes going the opposite way or pushers going the same
      // way that have already happened, then we cannot invalidate the push
@@ -1639,6 +1575,8 @@ int main(int argc, char** argv){
      char* current_map_filepath = nullptr;
      bool test = false;
      bool suite = false;
+     bool bench = false;
+     bool solve = false;
      bool show_suite = false;
      bool fail_slow = false;
      bool update_tags = false;
@@ -1652,10 +1590,16 @@ int main(int argc, char** argv){
      int window_x = SDL_WINDOWPOS_CENTERED;
      int window_y = SDL_WINDOWPOS_CENTERED;
 
+     const char* log_path = "bryte.log";
+
      GameMode_t game_mode = GAME_MODE_PLAYING;
 
      Demo_t play_demo {};
      Demo_t record_demo {};
+     DemoBench_t demo_bench {};
+     DemoTurbo_t turbo {};
+     Solver_t solver {};
+     DemoEndStates_t demo_end_states {};
 
      for(int i = 1; i < argc; i++){
           if(strcmp(argv[i], "-play") == 0){
@@ -1677,6 +1621,43 @@ int main(int argc, char** argv){
           }else if(strcmp(argv[i], "-suite") == 0){
                test = true;
                suite = true;
+          }else if(strcmp(argv[i], "-bench") == 0){
+               test = true;
+               suite = true;
+               bench = true;
+          }else if(strcmp(argv[i], "-benchiter") == 0){
+               int next = i + 1;
+               if(next >= argc) continue;
+               demo_bench.iterations = atoi(argv[next]);
+               if(demo_bench.iterations < 1) demo_bench.iterations = 1;
+          }else if(strcmp(argv[i], "-baseline") == 0){
+               int next = i + 1;
+               if(next >= argc) continue;
+               demo_bench.baseline_filepath = argv[next];
+          }else if(strcmp(argv[i], "-savebaseline") == 0){
+               demo_bench.save_baseline = true;
+          }else if(strcmp(argv[i], "-endstates") == 0){
+               int next = i + 1;
+               if(next >= argc) continue;
+               demo_end_states.filepath = argv[next];
+          }else if(strcmp(argv[i], "-saveendstates") == 0){
+               demo_end_states.save = true;
+          }else if(strcmp(argv[i], "-threshold") == 0){
+               int next = i + 1;
+               if(next >= argc) continue;
+               demo_bench.threshold = (F32)(atof(argv[next])) / 100.0f;
+          }else if(strcmp(argv[i], "-solve") == 0){
+               solve = true;
+          }else if(strcmp(argv[i], "-solvebfs") == 0){
+               solver.breadth_first = true;
+          }else if(strcmp(argv[i], "-solvemaxnodes") == 0){
+               int next = i + 1;
+               if(next >= argc) continue;
+               solver.max_nodes = atoi(argv[next]);
+          }else if(strcmp(argv[i], "-solvedepth") == 0){
+               int next = i + 1;
+               if(next >= argc) continue;
+               solver.max_depth = atoi(argv[next]);
           }else if(strcmp(argv[i], "-show") == 0){
                show_suite = true;
           }else if(strcmp(argv[i], "-updatetags") == 0){
@@ -1695,6 +1676,8 @@ int main(int argc, char** argv){
                if(next >= argc) continue;
                play_demo.dt_scalar = (F32)(atof(argv[next]));
                record_demo.dt_scalar = (F32)(atof(argv[next]));
+          }else if(strcmp(argv[i], "-turbo") == 0){
+               turbo.on = true;
           }else if(strcmp(argv[i], "-failslow") == 0){
                fail_slow = true;
           }else if(strcmp(argv[i], "-winw") == 0){
@@ -1715,6 +1698,10 @@ int main(int argc, char** argv){
                window_y = atoi(argv[next]);
           }else if(strcmp(argv[i], "-save") == 0){
                saving = true;
+          }else if(strcmp(argv[i], "-log") == 0){
+               int next = i + 1;
+               if(next >= argc) continue;
+               log_path = argv[next];
           }else if(strcmp(argv[i], "-h") == 0){
                printf("%s [options]\n", argv[0]);
                printf("  -play   <demo filepath> replay a recorded demo file\n");
@@ -1723,22 +1710,34 @@ int main(int argc, char** argv){
                printf("  -save                   enables the saving/loading system.\n");
                printf("  -test                   validate the map state is correct after playing a demo\n");
                printf("  -suite                  run map/demo combos in succession validating map state after each headless\n");
+               printf("  -bench                  like -suite but replays each demo several times and reports fps, p50/p99 frame time and peak rss per map\n");
+               printf("  -benchiter <integer>    how many times -bench replays each demo. default: %d\n", DEMO_BENCH_DEFAULT_ITERATIONS);
+               printf("  -baseline <filepath>    compare -bench results against this baseline, failing maps that got slower than the threshold\n");
+               printf("  -savebaseline           write the -bench results to the -baseline file instead of comparing\n");
+               printf("  -threshold <decimal>    percent of the baseline fps a map can lose before -bench fails. default: %.0f\n", DEMO_BENCH_DEFAULT_THRESHOLD * 100.0f);
+               printf("  -endstates <filepath>   compare the world checksum at the end of every -suite demo against this file, failing maps that changed\n");
+               printf("  -saveendstates          write the -suite end states to the -endstates file instead of comparing\n");
+               printf("  -solve                  search headless for inputs that take the loaded map to its stairs and record them as a demo, to -record or %s\n", SOLVER_DEFAULT_SOLUTION_FILEPATH);
+               printf("  -solvebfs               with -solve, search breadth first instead of guided by the distance to the stairs\n");
+               printf("  -solvemaxnodes <integer> with -solve, how many world states to explore before giving up. default: %d\n", SOLVER_DEFAULT_MAX_NODES);
+               printf("  -solvedepth <integer>   with -solve, the most actions a solution can take. default: %d\n", SOLVER_DEFAULT_MAX_DEPTH);
                printf("  -updatetags             when running a test, at the end update the tags in the map file\n");
                printf("  -show                   use in combination with -suite to run with a head\n");
                printf("  -map    <integer>       load a map by number\n");
                printf("  -speed  <decimal>       when replaying a demo, specify how fast/slow to replay where 1.0 is realtime\n");
+               printf("  -turbo                  with a speed above 1.0, simulate multiple frames per drawn frame instead of drawing faster\n");
                printf("  -frame  <integer>       which frame to play to automatically before drawing\n");
                printf("  -failslow               opposite of failfast, where we continue running tests in the suite after failure\n");
                printf("  -winx                   set the x position of the window. default: SDL_WINDOWPOS_CENTERED\n");
                printf("  -winy                   set the y position of the window. default: SDL_WINDOWPOS_CENTERED\n");
                printf("  -winw                   set the width of the window. default: 800\n");
                printf("  -winh                   set the height of the window. default: 800\n");
+               printf("  -log    <filepath>      where to write the log. default: bryte.log\n");
                printf("  -h this help.\n");
                return 0;
           }
      }
 
-     const char* log_path = "bryte.log";
      if(!Log_t::create(log_path)){
           fprintf(stderr, "failed to create log file: '%s'\n", log_path);
           return -1;
@@ -1749,6 +1748,18 @@ int main(int argc, char** argv){
           return 1;
      }
 
+     if(solve){
+          if(!current_map_filepath && !map_number){
+               LOG("cannot solve without specifying a map to load\n");
+               return 1;
+          }
+
+          // the solution is only recorded once the search finds one
+          if(record_demo.mode == DEMO_MODE_RECORD) solver.solution_filepath = record_demo.filepath;
+          record_demo.mode = DEMO_MODE_NONE;
+          play_demo.mode = DEMO_MODE_NONE;
+     }
+
      clear_global_tags();
 
      SDL_Window* window = nullptr;
@@ -1764,7 +1775,9 @@ int main(int argc, char** argv){
      GLuint thumbnail_framebuffer = 0;
      GLuint thumbnail_texture = 0;
 
-     if(!suite || show_suite){
+     bool headless = (suite && !show_suite) || solve;
+
+     if(!headless){
           if(SDL_Init(SDL_INIT_EVERYTHING) != 0){
                return 1;
           }
@@ -1887,18 +1900,11 @@ int main(int argc, char** argv){
      S8 collision_attempts = 0;
 
      // cached to seek in demo faster
-     TileMap_t demo_starting_tilemap {};
-     ObjectArray_t<Block_t> demo_starting_blocks {};
-     ObjectArray_t<Interactive_t> demo_starting_interactives {};
+     WorldSnapshot_t demo_starting_world {};
 
      Quad_t pct_bar_outline_quad = {0, 2.0f * PIXEL_SIZE, 1.0f, 0.02f};
 
-     ObjectArray_t<PlayerBlockPush_t> player_block_pushes {};
-     memset(&player_block_pushes, 0, sizeof(player_block_pushes));
-     ObjectArray_t<PlayerBlockPush_t*> ordered_player_block_pushes {};
-     memset(&ordered_player_block_pushes, 0, sizeof(ordered_player_block_pushes));
-     ObjectArray_t<RestoreBlock_t> restore_blocks {};
-     memset(&restore_blocks, 0, sizeof(restore_blocks));
+     CollisionIslands_t collision_islands;
 
      if(current_map_filepath){
           if(!load_map(current_map_filepath, &player_start, &world.tilemap, &world.blocks, &world.interactives,
@@ -1909,7 +1915,7 @@ int main(int argc, char** argv){
           load_map_tags(current_map_filepath, current_map_tags);
 
           if(play_demo.mode == DEMO_MODE_PLAY){
-               cache_for_demo_seek(&world, &demo_starting_tilemap, &demo_starting_blocks, &demo_starting_interactives);
+               cache_for_demo_seek(&world, &demo_starting_world);
           }
 
           if(saving){
@@ -1925,7 +1931,7 @@ int main(int argc, char** argv){
 
           load_map_tags(load_result.filepath, current_map_tags);
 
-          cache_for_demo_seek(&world, &demo_starting_tilemap, &demo_starting_blocks, &demo_starting_interactives);
+          cache_for_demo_seek(&world, &demo_starting_world);
 
           play_demo.mode = DEMO_MODE_PLAY;
           if(!load_map_number_demo(&play_demo, map_number, &frame_count)){
@@ -1941,7 +1947,7 @@ int main(int argc, char** argv){
           load_map_tags(load_result.filepath, current_map_tags);
 
           if(play_demo.mode == DEMO_MODE_PLAY){
-               cache_for_demo_seek(&world, &demo_starting_tilemap, &demo_starting_blocks, &demo_starting_interactives);
+               cache_for_demo_seek(&world, &demo_starting_world);
           }
 
           if(first_frame > 0 && first_frame < play_demo.last_frame){
@@ -1955,8 +1961,7 @@ int main(int argc, char** argv){
      Camera_t camera {};
 
      // init entangle colors
-     EntangleTints_t entangle_tints;
-     memset(&entangle_tints, 0, sizeof(entangle_tints));
+     EntangleTints_t entangle_tints {};
      {
           if(!resize(&entangle_tints.tints, 8)){
                LOG("failed to allocate 8 entangle tints\n");
@@ -1984,6 +1989,11 @@ int main(int argc, char** argv){
      reset_map(player_start, &world, &undo, &camera);
      init(&editor);
 
+     bool solve_failed = false;
+     if(solve && !solver_begin(&solver, &world, map_number)){
+          return 1;
+     }
+
      // init ui
      Vec_t checkbox_scroll {};
      ObjectArray_t<Checkbox_t> tag_checkboxes;
@@ -1995,14 +2005,13 @@ int main(int argc, char** argv){
           checkbox->pos.y = CHECKBOX_START_OFFSET_Y + CHECKBOX_INTERVAL * (F32)(c);
      }
 
-     auto all_maps = find_all_maps();
-
      Vec_t map_scroll {};
      char* hovered_map_thumbnail_path = NULL;
      S16 hovered_map_thumbnail_index = 0;
      S16 visible_map_thumbnail_count = 0;
      ObjectArray_t<MapThumbnail_t> map_thumbnails;
      memset(&map_thumbnails, 0, sizeof(map_thumbnails));
+     ThumbnailCache_t thumbnail_cache;
 
      world.editor_camera_bounds = Rect_t{0, 0, world.tilemap.width, world.tilemap.height};
      world.camera_transition = 1.0f;
@@ -2014,13 +2023,19 @@ int main(int argc, char** argv){
      auto current_time = last_time;
 
      while(!quit){
-          if((!suite || show_suite) && play_demo.seek_frame < 0){
+          // scratch memory from the last frame is no longer referenced, anything outside the frame that pointed into it
+          // gets dropped here as well, frames that are skipped with continue never reach the end of the loop
+          frame_arena_reset();
+          entangle_tints.block_to_tint_index = FrameArray_t<BlockToTintIndex_t>{};
+          world_end_block_query_cache(&world);
+
+          if(!headless && play_demo.seek_frame < 0 && !turbo.stepping){
                current_time = std::chrono::system_clock::now();
                std::chrono::duration<double> elapsed_seconds = current_time - last_time;
                auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(current_time - last_time);
                dt = (F32)(elapsed_seconds.count());
 
-               if(dt < FRAME_TIME / play_demo.dt_scalar){
+               if(dt < demo_turbo_frame_time(&turbo, play_demo.dt_scalar)){
                     if(elapsed_milliseconds.count() < 16){
                          std::this_thread::sleep_for(std::chrono::milliseconds(1));
                     }
@@ -2030,6 +2045,9 @@ int main(int argc, char** argv){
 
           last_time = current_time;
 
+          if(bench) demo_bench_frame_begin(&demo_bench);
+          demo_turbo_frame_begin(&turbo, play_demo.dt_scalar);
+
           // TODO: consider 30fps as minimum for random noobs computers
           dt = FRAME_TIME; // the game always runs as if a 60th of a frame has occurred.
 
@@ -2072,6 +2090,7 @@ int main(int argc, char** argv){
                     }
                     if(test){
                          bool passed = test_map_end_state(&world, &play_demo);
+                         if(suite && demo_end_states.filepath) demo_end_state_record(&demo_end_states, map_number, &world);
                          clear_global_tags();
                          if(!passed){
                               LOG("test failed\n");
@@ -2081,12 +2100,13 @@ int main(int argc, char** argv){
                               play_demo.mode = DEMO_MODE_NONE;
                               if(suite && !show_suite) return 1;
                          }else if(suite){
-                              map_number++;
+                              // when benching, the same map is loaded again until it has been replayed enough times
+                              if(!bench || !demo_bench_demo_finished(&demo_bench, map_number)) map_number++;
                               S16 maps_tested = map_number - first_map_number;
 
                               auto load_result = load_map_number_map(map_number, &world, &undo, &player_start, &player_action, &camera, current_map_tags);
                               if(load_result.success){
-                                   cache_for_demo_seek(&world, &demo_starting_tilemap, &demo_starting_blocks, &demo_starting_interactives);
+                                   cache_for_demo_seek(&world, &demo_starting_world);
                                    free(current_map_filepath);
                                    current_map_filepath = strdup(load_result.filepath);
                                    world_recalculate_camera_on_world_bounds(&world);
@@ -2103,7 +2123,11 @@ int main(int argc, char** argv){
                                    }else{
                                         LOG("Done Testing %d maps.\n", maps_tested);
                                    }
-                                   return 0;
+                                   bool bench_passed = !bench || demo_bench_report(&demo_bench);
+                                   bool end_states_passed = demo_end_states_report(&demo_end_states);
+                                   destroy(&demo_bench);
+                                   destroy(&demo_end_states);
+                                   return (bench_passed && end_states_passed) ? 0 : 1;
                               }
                          }
                     }else{
@@ -2116,6 +2140,8 @@ int main(int argc, char** argv){
                }
           }
 
+          if(solve) solver_frame_input(&solver, &player_action, &world, &record_demo, frame_count);
+
           S16 current_room_index = get_room_index_of_player(&world);
           bool can_undo = (undo.history.current != undo.history.start);
           bool will_undo_to_another_room = undo_revert_would_move_player_to_a_different_room(&undo,
@@ -2199,10 +2225,11 @@ int main(int argc, char** argv){
 
                                    for(S16 i = 0; i < world.tilemap.height; i++){
                                         for(S16 j = 0; j < world.tilemap.width; j++){
-                                             world.tilemap.tiles[i][j] = map_copy.tiles[i][j];
+                                             *tilemap_tile(&world.tilemap, j, i) = *tilemap_tile(&map_copy, j, i);
                                         }
                                    }
 
+                                   tilemap_build_flag_planes(&world.tilemap);
                                    destroy(&map_copy);
                                    world_recalculate_camera_on_world_bounds(&world);
                               }
@@ -2219,10 +2246,11 @@ int main(int argc, char** argv){
 
                                    for(S16 i = 0; i < map_copy.height; i++){
                                         for(S16 j = 0; j < map_copy.width; j++){
-                                             world.tilemap.tiles[i][j] = map_copy.tiles[i][j];
+                                             *tilemap_tile(&world.tilemap, j, i) = *tilemap_tile(&map_copy, j, i);
                                         }
                                    }
 
+                                   tilemap_build_flag_planes(&world.tilemap);
                                    destroy(&map_copy);
                                    world_recalculate_camera_on_world_bounds(&world);
                               }
@@ -2245,10 +2273,11 @@ int main(int argc, char** argv){
 
                                    for(S16 i = 0; i < world.tilemap.height; i++){
                                         for(S16 j = 0; j < world.tilemap.width; j++){
-                                             world.tilemap.tiles[i][j] = map_copy.tiles[i][j];
+                                             *tilemap_tile(&world.tilemap, j, i) = *tilemap_tile(&map_copy, j, i);
                                         }
                                    }
 
+                                   tilemap_build_flag_planes(&world.tilemap);
                                    destroy(&map_copy);
                                    world_recalculate_camera_on_world_bounds(&world);
                               }
@@ -2264,37 +2293,38 @@ int main(int argc, char** argv){
 
                                    for(S16 i = 0; i < map_copy.height; i++){
                                         for(S16 j = 0; j < map_copy.width; j++){
-                                             world.tilemap.tiles[i][j] = map_copy.tiles[i][j];
+                                             *tilemap_tile(&world.tilemap, j, i) = *tilemap_tile(&map_copy, j, i);
                                         }
                                    }
 
+                                   tilemap_build_flag_planes(&world.tilemap);
                                    destroy(&map_copy);
                                    world_recalculate_camera_on_world_bounds(&world);
                               }
                               break;
                          case SDL_SCANCODE_F12:
                               game_mode = GAME_MODE_LEVEL_SELECT;
-                              if(map_thumbnails.count == 0 && all_maps.count > 0){
-                                   init(&map_thumbnails, all_maps.count);
-                                   for(U32 m = 0; m < all_maps.count; m++){
-                                        auto* map_thumbnail = map_thumbnails.elements + m;
-                                        map_thumbnail->map_filepath = strdup(all_maps.entries[m].path);
-                                        map_thumbnail->map_number = all_maps.entries[m].map_number;
-                                        load_map_tags(map_thumbnail->map_filepath, map_thumbnail->tags);
-                                        Raw_t loaded_thumbnail {};
-                                        if(load_map_thumbnail(map_thumbnail->map_filepath, &loaded_thumbnail)){
-                                             map_thumbnail->texture = transparent_texture_from_raw_bitmap(&loaded_thumbnail);
-                                             free(loaded_thumbnail.bytes);
-                                        }else{
+                              if(map_thumbnails.count == 0){
+                                   ObjectArray_t<MapIndexEntry_t> map_index = {};
+                                   if(map_index_refresh(&map_index) && map_index.count > 0){
+                                        init(&map_thumbnails, map_index.count);
+                                        for(S16 m = 0; m < map_index.count; m++){
+                                             auto* map_thumbnail = map_thumbnails.elements + m;
+                                             auto* map_index_entry = map_index.elements + m;
+                                             map_thumbnail->map_filepath = strdup(map_index_entry->path);
+                                             map_thumbnail->map_number = map_index_entry->map_number;
+                                             map_thumbnail->thumbnail_offset = map_index_entry->thumbnail_offset;
+                                             map_thumbnail->thumbnail_size = map_index_entry->thumbnail_size;
+                                             map_thumbnail->texture_state = THUMBNAIL_TEXTURE_STATE_NONE;
                                              map_thumbnail->texture = 0;
+                                             map_index_entry_get_tags(map_index_entry, map_thumbnail->tags);
                                         }
-                                        free(all_maps.entries[m].path);
-                                   }
-                                   free(all_maps.entries);
 
-                                   qsort(map_thumbnails.elements, map_thumbnails.count, sizeof(map_thumbnails.elements[0]), map_thumbnail_comparor);
+                                        qsort(map_thumbnails.elements, map_thumbnails.count, sizeof(map_thumbnails.elements[0]), map_thumbnail_comparor);
 
-                                   visible_map_thumbnail_count = filter_thumbnails(&tag_checkboxes, &map_thumbnails);
+                                        visible_map_thumbnail_count = filter_thumbnails(&tag_checkboxes, &map_thumbnails);
+                                   }
+                                   destroy(&map_index);
                               }
                               break;
                          case SDL_SCANCODE_LEFT:
@@ -2309,8 +2339,8 @@ int main(int argc, char** argv){
                                    if(frame_count > 0 && play_demo.seek_frame < 0){
                                         play_demo.seek_frame = frame_count - 1;
 
-                                        restart_demo(&world, &demo_starting_tilemap, &demo_starting_blocks, &demo_starting_interactives,
-                                                     &play_demo, &frame_count, &player_start, &player_action, &undo, &camera);
+                                        restart_demo(&world, &demo_starting_world, &play_demo, &frame_count, &player_start, &player_action,
+                                                     &undo, &camera);
                                    }
                               }
                               break;
@@ -2351,31 +2381,31 @@ int main(int argc, char** argv){
                          case SDL_SCANCODE_A:
                               if(fade_state == FADE_STATE_NONE){
                                    player_action_perform(&player_action, &world.players, PLAYER_ACTION_TYPE_MOVE_LEFT_START,
-                                                         record_demo.mode, record_demo.file, frame_count);
+                                                         &record_demo, frame_count);
                               }
                               break;
                          case SDL_SCANCODE_D:
                               if(fade_state == FADE_STATE_NONE){
                                    player_action_perform(&player_action, &world.players, PLAYER_ACTION_TYPE_MOVE_RIGHT_START,
-                                                         record_demo.mode, record_demo.file, frame_count);
+                                                         &record_demo, frame_count);
                               }
                               break;
                          case SDL_SCANCODE_W:
                               if(fade_state == FADE_STATE_NONE){
                                    player_action_perform(&player_action, &world.players, PLAYER_ACTION_TYPE_MOVE_UP_START,
-                                                         record_demo.mode, record_demo.file, frame_count);
+                                                         &record_demo, frame_count);
                               }
                               break;
                          case SDL_SCANCODE_S:
                               if(fade_state == FADE_STATE_NONE){
                                    player_action_perform(&player_action, &world.players, PLAYER_ACTION_TYPE_MOVE_DOWN_START,
-                                                         record_demo.mode, record_demo.file, frame_count);
+                                                         &record_demo, frame_count);
                               }
                               break;
                          case SDL_SCANCODE_E:
                               if(fade_state == FADE_STATE_NONE){
                                    player_action_perform(&player_action, &world.players, PLAYER_ACTION_TYPE_ACTIVATE_START,
-                                                         record_demo.mode, record_demo.file, frame_count);
+                                                         &record_demo, frame_count);
                               }
                               break;
                          case SDL_SCANCODE_SPACE:
@@ -2384,7 +2414,7 @@ int main(int argc, char** argv){
                               }else{
                                    if(fade_state == FADE_STATE_NONE){
                                         player_action_perform(&player_action, &world.players, PLAYER_ACTION_TYPE_SHOOT_START,
-                                                              record_demo.mode, record_demo.file, frame_count);
+                                                              &record_demo, frame_count);
                                    }
                               }
                               break;
@@ -2393,7 +2423,7 @@ int main(int argc, char** argv){
                               auto load_result = load_map_number_map(map_number, &world, &undo, &player_start, &player_action, &camera, current_map_tags);
                               if(load_result.success){
                                    if(record_demo.mode == DEMO_MODE_PLAY){
-                                        cache_for_demo_seek(&world, &demo_starting_tilemap, &demo_starting_blocks, &demo_starting_interactives);
+                                        cache_for_demo_seek(&world, &demo_starting_world);
                                    }
                                    free(current_map_filepath);
                                    current_map_filepath = strdup(load_result.filepath);
@@ -2422,7 +2452,7 @@ int main(int argc, char** argv){
                                    free(current_map_filepath);
                                    current_map_filepath = strdup(load_result.filepath);
                                    if(record_demo.mode == DEMO_MODE_PLAY){
-                                        cache_for_demo_seek(&world, &demo_starting_tilemap, &demo_starting_blocks, &demo_starting_interactives);
+                                        cache_for_demo_seek(&world, &demo_starting_world);
 
                                         if(load_map_number_demo(&play_demo, map_number, &frame_count)){
                                              continue; // reset to the top of the loop
@@ -2445,7 +2475,7 @@ int main(int argc, char** argv){
                                    free(current_map_filepath);
                                    current_map_filepath = strdup(load_result.filepath);
                                    if(play_demo.mode == DEMO_MODE_PLAY){
-                                        cache_for_demo_seek(&world, &demo_starting_tilemap, &demo_starting_blocks, &demo_starting_interactives);
+                                        cache_for_demo_seek(&world, &demo_starting_world);
 
                                         if(load_map_number_demo(&play_demo, map_number, &frame_count)){
                                              continue; // reset to the top of the loop
@@ -2639,13 +2669,16 @@ int main(int argc, char** argv){
                          case SDL_SCANCODE_U:
                               if(fade_state == FADE_STATE_NONE && can_undo && !will_undo_to_another_room){
                                    player_action_perform(&player_action, &world.players, PLAYER_ACTION_TYPE_UNDO,
-                                                         record_demo.mode, record_demo.file, frame_count);
+                                                         &record_demo, frame_count);
                               }
                               break;
                          case SDL_SCANCODE_N:
                               if(game_mode == GAME_MODE_EDITOR && editor.mode == EDITOR_MODE_CATEGORY_SELECT){
                                    Tile_t* tile = tilemap_get_tile(&world.tilemap, mouse_select_world_coord(mouse_screen, &camera));
-                                   if(tile) tile_toggle_wire_activated(tile);
+                                   if(tile){
+                                        tile_toggle_wire_activated(tile);
+                                        tilemap_sync_flag_planes(&world.tilemap, tile);
+                                   }
                               }
                               break;
                          case SDL_SCANCODE_4:
@@ -2807,7 +2840,7 @@ int main(int argc, char** argv){
                               }
                               else if(game_mode == GAME_MODE_PLAYING && fade_state == FADE_STATE_NONE && can_undo && will_undo_to_another_room){
                                    player_action_perform(&player_action, &world.players, PLAYER_ACTION_TYPE_UNDO,
-                                                         record_demo.mode, record_demo.file, frame_count);
+                                                         &record_demo, frame_count);
                               }
                               break;
                          case SDL_SCANCODE_M:
@@ -2936,42 +2969,42 @@ int main(int argc, char** argv){
                          if(fade_state != FADE_STATE_NONE) break;
 
                          player_action_perform(&player_action, &world.players, PLAYER_ACTION_TYPE_MOVE_LEFT_STOP,
-                                               record_demo.mode, record_demo.file, frame_count);
+                                               &record_demo, frame_count);
                          break;
                     case SDL_SCANCODE_D:
                          if(play_demo.mode == DEMO_MODE_PLAY) break;
                          if(fade_state != FADE_STATE_NONE) break;
 
                          player_action_perform(&player_action, &world.players, PLAYER_ACTION_TYPE_MOVE_RIGHT_STOP,
-                                               record_demo.mode, record_demo.file, frame_count);
+                                               &record_demo, frame_count);
                          break;
                     case SDL_SCANCODE_W:
                          if(play_demo.mode == DEMO_MODE_PLAY) break;
                          if(fade_state != FADE_STATE_NONE) break;
 
                          player_action_perform(&player_action, &world.players, PLAYER_ACTION_TYPE_MOVE_UP_STOP,
-                                               record_demo.mode, record_demo.file, frame_count);
+                                               &record_demo, frame_count);
                          break;
                     case SDL_SCANCODE_S:
                          if(play_demo.mode == DEMO_MODE_PLAY) break;
                          if(fade_state != FADE_STATE_NONE) break;
 
                          player_action_perform(&player_action, &world.players, PLAYER_ACTION_TYPE_MOVE_DOWN_STOP,
-                                               record_demo.mode, record_demo.file, frame_count);
+                                               &record_demo, frame_count);
                          break;
                     case SDL_SCANCODE_E:
                          if(play_demo.mode == DEMO_MODE_PLAY) break;
                          if(fade_state != FADE_STATE_NONE) break;
 
                          player_action_perform(&player_action, &world.players, PLAYER_ACTION_TYPE_ACTIVATE_STOP,
-                                               record_demo.mode, record_demo.file, frame_count);
+                                               &record_demo, frame_count);
                          break;
                     case SDL_SCANCODE_SPACE:
                          if(play_demo.mode == DEMO_MODE_PLAY) break;
                          if(fade_state != FADE_STATE_NONE) break;
 
                          player_action_perform(&player_action, &world.players, PLAYER_ACTION_TYPE_SHOOT_STOP,
-                                               record_demo.mode, record_demo.file, frame_count);
+                                               &record_demo, frame_count);
                          break;
                     case SDL_SCANCODE_LCTRL:
                          ctrl_down = false;
@@ -2994,8 +3027,8 @@ int main(int argc, char** argv){
                                         play_demo.seek_frame = (S64)((F32)(play_demo.last_frame) * mouse_screen.x);
 
                                         if(play_demo.seek_frame < frame_count){
-                                            restart_demo(&world, &demo_starting_tilemap, &demo_starting_blocks, &demo_starting_interactives,
-                                                         &play_demo, &frame_count, &player_start, &player_action, &undo, &camera);
+                                            restart_demo(&world, &demo_starting_world, &play_demo, &frame_count, &player_start, &player_action,
+                                                         &undo, &camera);
                                         }else if(play_demo.seek_frame == frame_count){
                                              play_demo.seek_frame = -1;
                                         }
@@ -3328,8 +3361,8 @@ int main(int argc, char** argv){
                               play_demo.seek_frame = (S64)((F32)(play_demo.last_frame) * mouse_screen.x);
 
                               if(play_demo.seek_frame < frame_count){
-                                   restart_demo(&world, &demo_starting_tilemap, &demo_starting_blocks, &demo_starting_interactives,
-                                                &play_demo, &frame_count, &player_start, &player_action, &undo, &camera);
+                                   restart_demo(&world, &demo_starting_world, &play_demo, &frame_count, &player_start, &player_action,
+                                                &undo, &camera);
                               }else if(play_demo.seek_frame == frame_count){
                                    play_demo.seek_frame = -1;
                               }
@@ -3470,7 +3503,7 @@ int main(int argc, char** argv){
                                         arrow->vel = 0;
                                    }else if(arrow->pos.z > block_top && arrow->pos.z < (block_top + HEIGHT_INTERVAL)){
                                         // TODO(jtardiff): being held down is probably not quite enough to block us from lighting the block
-                                        auto held_down_result = block_held_down_by_another_block(blocks[b], world.block_qt, world.interactive_qt, &world.tilemap);
+                                        auto held_down_result = block_held_down_by_another_block(blocks[b], world.block_qt, &world.blocks, world.interactive_qt, &world.tilemap);
                                         if(!held_down_result.held()){
                                              arrow->element_from_block = block_index;
                                              if(arrow->element != blocks[b]->element){
@@ -3497,7 +3530,7 @@ int main(int argc, char** argv){
                                         }
                                    // the block is only iced so we just want to melt the ice, if the block isn't covered
                                    }else if(arrow->pos.z >= block_bottom && arrow->pos.z <= (block_top + MELT_SPREAD_HEIGHT) &&
-                                            !block_held_down_by_another_block(blocks[b], world.block_qt, world.interactive_qt, &world.tilemap).held()){
+                                            !block_held_down_by_another_block(blocks[b], world.block_qt, &world.blocks, world.interactive_qt, &world.tilemap).held()){
                                         if(arrow->element == ELEMENT_FIRE && blocks[b]->element == ELEMENT_ONLY_ICED){
                                              blocks[b]->element = ELEMENT_NONE;
                                         }else if(arrow->element == ELEMENT_ICE && blocks[b]->element == ELEMENT_NONE){
@@ -3684,6 +3717,7 @@ int main(int argc, char** argv){
                     if(player_action.undo){
                          undo_commit(&undo, &world.players, &world.tilemap, &world.blocks, &world.interactives, true);
                          undo_revert(&undo, &world.players, &world.tilemap, &world.blocks, &world.interactives, player->has_bow);
+                         world_wake_all_blocks(&world);
                          quad_tree_free(world.interactive_qt);
                          world.interactive_qt = quad_tree_build(&world.interactives);
                          quad_tree_free(world.block_qt);
@@ -3858,8 +3892,13 @@ int main(int argc, char** argv){
 
                // block movement
 
+               // blocks at rest are skipped by the passes below unless something nearby could disturb them
+               if(game_mode == GAME_MODE_EDITOR) world_wake_all_blocks(&world);
+               world_update_awake_blocks(&world);
+
                // do a pass moving the block as far as possible, so that collision doesn't rely on order of blocks in the array
-               for(S16 i = 0; i < world.blocks.count; i++){
+               for(S16 awake_index = 0; awake_index < world_awake_block_count(&world); awake_index++){
+                    S16 i = world_awake_block_index(&world, awake_index);
                     Block_t* block = world.blocks.elements + i;
 
                     block->prev_vel = block->vel;
@@ -3927,7 +3966,8 @@ int main(int argc, char** argv){
                }
 
                // pass to detect if blocks are in a pit or just held up by the floor
-               for(S16 i = 0; i < world.blocks.count; i++){
+               for(S16 awake_index = 0; awake_index < world_awake_block_count(&world); awake_index++){
+                    S16 i = world_awake_block_index(&world, awake_index);
                     auto block = world.blocks.elements + i;
 
                     if(block->pos.z <= 0){
@@ -3960,7 +4000,8 @@ int main(int argc, char** argv){
 
                // do multiple passes here so that entangled blocks know for sure if their entangled counterparts are coasting and index order doesn't matter
                for(S16 j = 0; j < 2; j++){ // TODO: is this enough iterations or will we need more iterations for multiple entangled blocks?
-                    for(S16 i = 0; i < world.blocks.count; i++){
+                    for(S16 awake_index = 0; awake_index < world_awake_block_count(&world); awake_index++){
+                         S16 i = world_awake_block_index(&world, awake_index);
                          Block_t* block = world.blocks.elements + i;
 
                          bool would_teleport_onto_ice = false;
@@ -4118,7 +4159,7 @@ int main(int argc, char** argv){
                     }
 
                     if(!player->held_up){
-                         auto result = player_in_block_rect(player, &world.tilemap, world.interactive_qt, world.block_qt);
+                         auto result = player_in_block_rect(player, &world.tilemap, world.interactive_qt, world.block_qt, &world.blocks);
                          for(S8 e = 0; e < result.entries.count; e++){
                               auto& entry = result.entries.objects[e];
                               if(entry.block_pos.z == player->pos.z - HEIGHT_INTERVAL){
@@ -4138,7 +4179,8 @@ int main(int argc, char** argv){
                     }
                }
 
-               for(S16 i = 0; i < world.blocks.count; i++){
+               for(S16 awake_index = 0; awake_index < world_awake_block_count(&world); awake_index++){
+                    S16 i = world_awake_block_index(&world, awake_index);
                     Block_t* block = world.blocks.elements + i;
 
                     MotionComponent_t x_component = motion_x_component(block);
@@ -4183,10 +4225,11 @@ int main(int argc, char** argv){
 
                // TODO: for these next 2 passes, do we need to care about teleport position? Probably just the next loop?
                // determine whether or not we are going to be lifted/held up by a popup and if the block is inside a portal (for future slicing)
-               for(S16 i = 0; i < world.blocks.count; i++){
+               for(S16 awake_index = 0; awake_index < world_awake_block_count(&world); awake_index++){
+                    S16 i = world_awake_block_index(&world, awake_index);
                     auto block = world.blocks.elements + i;
 
-                    auto result = block_held_up_by_another_block(block, world.block_qt, world.interactive_qt, &world.tilemap);
+                    auto result = block_held_up_by_another_block(block, world.block_qt, &world.blocks, world.interactive_qt, &world.tilemap);
                     if(result.held()){
                          block->held_up |= BLOCK_HELD_BY_SOLID;
                     }
@@ -4328,7 +4371,8 @@ int main(int argc, char** argv){
 
 
                // have the block fall if it is not held up
-               for(S16 i = 0; i < world.blocks.count; i++){
+               for(S16 awake_index = 0; awake_index < world_awake_block_count(&world); awake_index++){
+                    S16 i = world_awake_block_index(&world, awake_index);
                     auto block = world.blocks.elements + i;
 
                     if(block->entangle_index >= 0){
@@ -4362,7 +4406,8 @@ int main(int argc, char** argv){
                     }
                }
 
-               for(S16 i = 0; i < world.blocks.count; i++){
+               for(S16 awake_index = 0; awake_index < world_awake_block_count(&world); awake_index++){
+                    S16 i = world_awake_block_index(&world, awake_index);
                     Block_t* block = world.blocks.elements + i;
 
                     if(block->coast_vertical <= BLOCK_COAST_ICE  || block->coast_horizontal <= BLOCK_COAST_ICE){
@@ -4388,7 +4433,7 @@ int main(int argc, char** argv){
                                              check_idle_move_state = block->vertical_move.state;
                                         }
 
-                                        bool held_down = block_held_down_by_another_block(block, world.block_qt, world.interactive_qt, &world.tilemap).held();
+                                        bool held_down = block_held_down_by_another_block(block, world.block_qt, &world.blocks, world.interactive_qt, &world.tilemap).held();
 
                                         if(check_idle_move_state == MOVE_STATE_IDLING && player->push_time > BLOCK_PUSH_TIME){
                                              if(!held_down){
@@ -4418,7 +4463,7 @@ int main(int argc, char** argv){
                                              check_idle_move_state = block->horizontal_move.state;
                                         }
 
-                                        bool held_down = block_held_down_by_another_block(block, world.block_qt, world.interactive_qt, &world.tilemap).held();
+                                        bool held_down = block_held_down_by_another_block(block, world.block_qt, &world.blocks, world.interactive_qt, &world.tilemap).held();
 
                                         if(check_idle_move_state == MOVE_STATE_IDLING && player->push_time > BLOCK_PUSH_TIME){
                                              if(!held_down){
@@ -4444,795 +4489,829 @@ int main(int argc, char** argv){
                     }
                }
 
-               BlockMomentumPushes_t<128> momentum_block_pushes; // TODO: is 128 this enough ?
-               BlockMomentumPushes_t<128> entangled_momentum_block_pushes;
-               BlockMomentumPushes_t<128> consolidated_momentum_block_pushes;
+               BlockMomentumPushes_t momentum_block_pushes;
+               BlockMomentumPushes_t entangled_momentum_block_pushes;
+               BlockMomentumPushes_t consolidated_momentum_block_pushes;
 
                // TODO: maybe one day make this happen only when we load the map
                CheckBlockCollisions_t collision_results;
                collision_results.init(world.blocks.count);
 
+               // entangled pushes above may have woken blocks
+               world_sort_awake_blocks(&world);
+
                // before collision, track the pos delta
-               S16 update_blocks_count = world.blocks.count;
-               for(S16 i = 0; i < update_blocks_count; i++){
-                    auto block = world.blocks.elements + i;
+               for(S16 awake_index = 0; awake_index < world_awake_block_count(&world); awake_index++){
+                    auto block = world.blocks.elements + world_awake_block_index(&world, awake_index);
                     block->pre_collision_pos_delta = block->pos_delta;
                }
 
                // unbounded collision: this should be exciting
                // we have our initial position and our initial pos_delta, update pos_delta for all players and blocks until nothing is colliding anymore
+               // blocks are split into islands that cannot touch each other this frame, so an island only repeats its own passes
+               collision_islands.build(&world);
+
                const S8 max_collision_attempts = 16;
-               bool repeat_collision_pass = true;
-               while(repeat_collision_pass && collision_attempts <= max_collision_attempts){
-                    repeat_collision_pass = false;
-
-                    // do a collision pass on blocks against the world
-                    for(S16 i = 0; i < update_blocks_count; i++){
-                         auto block = world.blocks.elements + i;
-                         block->pre_collision_pos_delta = block->pos_delta;
-                         auto block_collision_result = do_block_collision(&world, block, update_blocks_count);
-                         if(block_collision_result.repeat_collision_pass){
-                             repeat_collision_pass = true;
+               for(S16 island_index = 0; island_index < collision_islands.count; island_index++){
+                    S16 update_blocks_count = collision_islands.block_count(&world, island_index);
+                    S8 island_collision_attempts = 1;
+                    bool repeat_collision_pass = true;
+                    while(repeat_collision_pass && island_collision_attempts <= max_collision_attempts){
+                         repeat_collision_pass = false;
+
+                         // do a collision pass on blocks against the world
+                         for(S16 island_block = 0; island_block < update_blocks_count; island_block++){
+                              auto block = world.blocks.elements + collision_islands.block_index(&world, island_index, island_block);
+                              block->pre_collision_pos_delta = block->pos_delta;
+                              auto block_collision_result = do_block_collision(&world, block, update_blocks_count);
+                              if(block_collision_result.repeat_collision_pass){
+                                  repeat_collision_pass = true;
+                              }
+                              update_blocks_count = block_collision_result.update_blocks_count;
                          }
-                         update_blocks_count = block_collision_result.update_blocks_count;
-                    }
 
-                    // do a collision pass on blocks against other blocks
-                    for(S16 i = 0; i < update_blocks_count; i++){
-                         auto* block = world.blocks.elements + i;
-                         auto collision_result = check_block_collision(&world, block);
-                         // add collisions that we need to resolve
-                         if(collision_result.collided){
-                              if(block->pos_delta.x == 0){
-                                   block->collision_time_ratio.x = 0;
-                              }else{
-                                   block->collision_time_ratio.x = collision_result.pos_delta.x / block->pre_collision_pos_delta.x;
-                              }
+                         // do a collision pass on blocks against other blocks
+                         for(S16 island_block = 0; island_block < update_blocks_count; island_block++){
+                              auto* block = world.blocks.elements + collision_islands.block_index(&world, island_index, island_block);
+                              auto collision_result = check_block_collision(&world, block);
+                              // add collisions that we need to resolve
+                              if(collision_result.collided){
+                                   if(block->pos_delta.x == 0){
+                                        block->collision_time_ratio.x = 0;
+                                   }else{
+                                        block->collision_time_ratio.x = collision_result.pos_delta.x / block->pre_collision_pos_delta.x;
+                                   }
 
-                              if(block->pos_delta.y == 0){
-                                   block->collision_time_ratio.y = 0;
-                              }else{
-                                   block->collision_time_ratio.y = collision_result.pos_delta.y / block->pre_collision_pos_delta.y;
-                              }
+                                   if(block->pos_delta.y == 0){
+                                        block->collision_time_ratio.y = 0;
+                                   }else{
+                                        block->collision_time_ratio.y = collision_result.pos_delta.y / block->pre_collision_pos_delta.y;
+                                   }
 
-                              collision_results.add_collision(&collision_result);
+                                   collision_results.add_collision(&collision_result);
+                              }
                          }
-                    }
 
-                    // on any collision repeat
-                    if(collision_results.count > 0) repeat_collision_pass = true;
+                         // on any collision repeat
+                         if(collision_results.count > 0) repeat_collision_pass = true;
 
-                    collision_results.sort_by_time();
-
-                    // update block positions based on collisions
-                    for(S32 i = 0; i < collision_results.count; i++){
-                        auto* collision = collision_results.collisions + i;
-                        apply_block_collision(&world, world.blocks.elements + collision->block_index, dt, collision);
-                    }
+                         collision_results.sort_by_time();
 
-#if 0
-                    if(collision_results.count > 0){
-                         LOG("collision_result: %d\n", collision_results.count);
+                         // update block positions based on collisions
                          for(S32 i = 0; i < collision_results.count; i++){
                              auto* collision = collision_results.collisions + i;
-                             log_collision_result(collision, &world);
+                             apply_block_collision(&world, world.blocks.elements + collision->block_index, dt, collision);
+                         }
+
+#if 0
+                         if(collision_results.count > 0){
+                              LOG("collision_result: %d\n", collision_results.count);
+                              for(S32 i = 0; i < collision_results.count; i++){
+                                  auto* collision = collision_results.collisions + i;
+                                  log_collision_result(collision, &world);
+                              }
                          }
-                    }
 #endif
 
-                    // generate pushes based on collisions
-                    for(S32 i = 0; i < collision_results.count; i++){
-                        auto* collision = collision_results.collisions + i;
-                        generate_pushes_from_collision(&world, collision, &momentum_block_pushes);
-                    }
+                         // generate pushes based on collisions
+                         for(S32 i = 0; i < collision_results.count; i++){
+                             auto* collision = collision_results.collisions + i;
+                             generate_pushes_from_collision(&world, collision, &momentum_block_pushes);
+                         }
 
-                    collision_results.reset();
+                         collision_results.reset();
 
-                    // check if blocks extinguish elements of other blocks
-                    for(S16 i = 0; i < world.blocks.count; i++){
-                         auto block = world.blocks.elements + i;
+                         // check if blocks extinguish elements of other blocks
+                         for(S16 island_block = 0; island_block < collision_islands.block_count(&world, island_index); island_block++){
+                              S16 i = collision_islands.block_index(&world, island_index, island_block);
+                              auto block = world.blocks.elements + i;
 
-                         // TODO: use teleport pos and pos_delta here?
+                              // TODO: use teleport pos and pos_delta here?
 
-                         // filter out blocks that couldn't extinguish
-                         if(block->pos_delta.x == 0 && block->pos_delta.y == 0) continue;
-                         if(block->pos.z == 0) continue; // TODO: if we bring back pits, remove this line
+                              // filter out blocks that couldn't extinguish
+                              if(block->pos_delta.x == 0 && block->pos_delta.y == 0) continue;
+                              if(block->pos.z == 0) continue; // TODO: if we bring back pits, remove this line
 
-                         auto block_rect = block_get_inclusive_rect(block);
-                         auto coord = block_get_coord(block);
-                         auto search_rect = rect_surrounding_adjacent_coords(coord);
+                              auto block_rect = block_get_inclusive_rect(block);
+                              auto coord = block_get_coord(block);
+                              auto search_rect = rect_surrounding_adjacent_coords(coord);
 
-                         S16 block_count = 0;
-                         Block_t* blocks[BLOCK_QUAD_TREE_MAX_QUERY];
-                         quad_tree_find_in(world.block_qt, search_rect, blocks, &block_count, BLOCK_QUAD_TREE_MAX_QUERY);
+                              S16 block_count = 0;
+                              Block_t* blocks[BLOCK_QUAD_TREE_MAX_QUERY];
+                              quad_tree_find_in(world.block_qt, search_rect, blocks, &block_count, BLOCK_QUAD_TREE_MAX_QUERY);
 
-                         for(S16 b = 0; b < block_count; b++){
-                              auto check_block = blocks[b];
-
-                              if(check_block->element != ELEMENT_FIRE && check_block->element != ELEMENT_ICE) continue;
-                              if(check_block->pos.z + HEIGHT_INTERVAL != block->pos.z) continue;
-
-                              if(pixel_in_rect(block_center_pixel(check_block), block_rect)){
-                                   if(check_block->element == ELEMENT_FIRE){
-                                        check_block->element = ELEMENT_NONE;
-                                        add_global_tag(TAG_BLOCK_EXTINGUISHED_BY_STOMP);
-                                   }else if(check_block->element == ELEMENT_ICE){
-                                        check_block->element = ELEMENT_ONLY_ICED;
-                                        add_global_tag(TAG_BLOCK_EXTINGUISHED_BY_STOMP);
+                              for(S16 b = 0; b < block_count; b++){
+                                   auto check_block = blocks[b];
+
+                                   if(check_block->element != ELEMENT_FIRE && check_block->element != ELEMENT_ICE) continue;
+                                   if(check_block->pos.z + HEIGHT_INTERVAL != block->pos.z) continue;
+
+                                   if(pixel_in_rect(block_center_pixel(check_block), block_rect)){
+                                        if(check_block->element == ELEMENT_FIRE){
+                                             check_block->element = ELEMENT_NONE;
+                                             add_global_tag(TAG_BLOCK_EXTINGUISHED_BY_STOMP);
+                                        }else if(check_block->element == ELEMENT_ICE){
+                                             check_block->element = ELEMENT_ONLY_ICED;
+                                             add_global_tag(TAG_BLOCK_EXTINGUISHED_BY_STOMP);
+                                        }
                                    }
                               }
                          }
-                    }
 
-                    // update carried blocks pos_delta based on carrying blocks pos_delta
-                    for(S16 i = 0; i < world.blocks.count; i++){
-                         auto block = world.blocks.elements + i;
+                         // update carried blocks pos_delta based on carrying blocks pos_delta
+                         for(S16 island_block = 0; island_block < collision_islands.block_count(&world, island_index); island_block++){
+                              S16 i = collision_islands.block_index(&world, island_index, island_block);
+                              auto block = world.blocks.elements + i;
 
-                         auto result = block_held_up_by_another_block(block, world.block_qt, world.interactive_qt, &world.tilemap,
-                                                                      BLOCK_FRICTION_AREA);
-                         for(S16 b = 0; b < result.count; b++){
-                              auto holder = result.blocks_held[b].block;
+                              auto result = block_held_up_by_another_block(block, world.block_qt, &world.blocks, world.interactive_qt, &world.tilemap,
+                                                                           BLOCK_FRICTION_AREA);
+                              for(S16 b = 0; b < result.count; b++){
+                                   auto holder = block_from_handle(&world.blocks, result.blocks_held[b].block);
 
-                              // a frictionless surface cannot carry a block
-                              if(holder->element == ELEMENT_ICE || holder->element == ELEMENT_ONLY_ICED) continue;
+                                   // a frictionless surface cannot carry a block
+                                   if(holder->element == ELEMENT_ICE || holder->element == ELEMENT_ONLY_ICED) continue;
 
-                              if(holder && holder->pos_delta != vec_zero()){
-                                   auto old_carried_pos_delta = block->carried_pos_delta.positive + block->carried_pos_delta.negative;
+                                   if(holder && holder->pos_delta != vec_zero()){
+                                        auto old_carried_pos_delta = block->carried_pos_delta.positive + block->carried_pos_delta.negative;
 
-                                   auto holder_index = get_block_index(&world, holder);
-                                   if(!get_carried_noob(&block->carried_pos_delta, holder->pos_delta, holder_index, false)){
-                                        auto new_carried_pos_delta = block->carried_pos_delta.positive + block->carried_pos_delta.negative;
+                                        auto holder_index = result.blocks_held[b].block.index;
+                                        if(!get_carried_noob(&block->carried_pos_delta, holder->pos_delta, holder_index, false)){
+                                             auto new_carried_pos_delta = block->carried_pos_delta.positive + block->carried_pos_delta.negative;
 
-                                        if(block->teleport){
-                                             block->teleport_pos_delta -= old_carried_pos_delta;
-                                             block->teleport_pos_delta += new_carried_pos_delta;
-                                        }else{
-                                             block->pos_delta -= old_carried_pos_delta;
-                                             block->pos_delta += new_carried_pos_delta;
-                                        }
+                                             if(block->teleport){
+                                                  block->teleport_pos_delta -= old_carried_pos_delta;
+                                                  block->teleport_pos_delta += new_carried_pos_delta;
+                                             }else{
+                                                  block->pos_delta -= old_carried_pos_delta;
+                                                  block->pos_delta += new_carried_pos_delta;
+                                             }
 
-                                        S16 entangle_index = block->entangle_index;
-                                        while(entangle_index != i && entangle_index >= 0){
-                                             Block_t* entangled_block = world.blocks.elements + entangle_index;
+                                             S16 entangle_index = block->entangle_index;
+                                             while(entangle_index != i && entangle_index >= 0){
+                                                  Block_t* entangled_block = world.blocks.elements + entangle_index;
 
-                                             S8 rotations_between = blocks_rotations_between(block, entangled_block);
-                                             auto rotated_pos_delta = vec_rotate_quadrants_clockwise(holder->pos_delta, rotations_between);
+                                                  S8 rotations_between = blocks_rotations_between(block, entangled_block);
+                                                  auto rotated_pos_delta = vec_rotate_quadrants_clockwise(holder->pos_delta, rotations_between);
 
-                                             old_carried_pos_delta = entangled_block->carried_pos_delta.positive + entangled_block->carried_pos_delta.negative;
-                                             if(!get_carried_noob(&entangled_block->carried_pos_delta, rotated_pos_delta, holder_index, true)){
-                                                  new_carried_pos_delta = entangled_block->carried_pos_delta.positive + entangled_block->carried_pos_delta.negative;
+                                                  old_carried_pos_delta = entangled_block->carried_pos_delta.positive + entangled_block->carried_pos_delta.negative;
+                                                  if(!get_carried_noob(&entangled_block->carried_pos_delta, rotated_pos_delta, holder_index, true)){
+                                                       new_carried_pos_delta = entangled_block->carried_pos_delta.positive + entangled_block->carried_pos_delta.negative;
 
-                                                  if(entangled_block->teleport){
-                                                       entangled_block->teleport_pos_delta -= old_carried_pos_delta;
-                                                       entangled_block->teleport_pos_delta += new_carried_pos_delta;
-                                                  }else{
-                                                       entangled_block->pos_delta -= old_carried_pos_delta;
-                                                       entangled_block->pos_delta += new_carried_pos_delta;
+                                                       if(entangled_block->teleport){
+                                                            entangled_block->teleport_pos_delta -= old_carried_pos_delta;
+                                                            entangled_block->teleport_pos_delta += new_carried_pos_delta;
+                                                       }else{
+                                                            entangled_block->pos_delta -= old_carried_pos_delta;
+                                                            entangled_block->pos_delta += new_carried_pos_delta;
+                                                       }
+
+                                                       repeat_collision_pass = true;
                                                   }
 
-                                                  repeat_collision_pass = true;
+                                                  entangle_index = entangled_block->entangle_index;
                                              }
 
-                                             entangle_index = entangled_block->entangle_index;
+                                             repeat_collision_pass = true;
                                         }
-
-                                        repeat_collision_pass = true;
                                    }
                               }
                          }
-                    }
-
-                    // see if any moving blocks teleport
-                    for(S16 i = 0; i < world.blocks.count; i++){
-                         auto block = world.blocks.elements + i;
-                         if(block->teleport) continue;
 
-                         auto block_center = block_get_center(block);
-                         auto premove_coord = block_get_coord(block);
-                         auto coord = block_get_coord(block->pos + block->pos_delta, block->cut);
-                         auto teleport_result = teleport_position_across_portal(block_center, block->pos_delta, &world, premove_coord, coord, false);
-                         if(teleport_result.count > block->clone_id){
-                              add_global_tag(TAG_TELEPORT_BLOCK);
-                              block->teleport = true;
-                              block->teleport_pos = teleport_result.results[block->clone_id].pos;
+                         // see if any moving blocks teleport
+                         for(S16 island_block = 0; island_block < collision_islands.block_count(&world, island_index); island_block++){
+                              S16 i = collision_islands.block_index(&world, island_index, island_block);
+                              auto block = world.blocks.elements + i;
+                              if(block->teleport) continue;
+
+                              auto block_center = block_get_center(block);
+                              auto premove_coord = block_get_coord(block);
+                              auto coord = block_get_coord(block->pos + block->pos_delta, block->cut);
+                              auto teleport_result = teleport_position_across_portal(block_center, block->pos_delta, &world, premove_coord, coord, false);
+                              if(teleport_result.count > block->clone_id){
+                                   add_global_tag(TAG_TELEPORT_BLOCK);
+                                   block->teleport = true;
+                                   block->teleport_pos = teleport_result.results[block->clone_id].pos;
+
+                                   // LOG("block %d at %d, %d - %.10f, %.10f teleports to %d, %d - %.10f, %.10f\n",
+                                   //     i, block->pos.pixel.x, block->pos.pixel.y, block->pos.decimal.x, block->pos.decimal.y,
+                                   //     block->teleport_pos.pixel.x, block->teleport_pos.pixel.y, block->teleport_pos.decimal.x, block->teleport_pos.decimal.y);
+
+                                   block->teleport_cut = block_cut_rotate_clockwise(block->cut, teleport_result.results[block->clone_id].rotations);
+                                   block->teleport_pos.pixel -= block_center_pixel_offset(block->teleport_cut);
+
+                                   block->teleport_pos_delta = teleport_result.results[block->clone_id].delta;
+                                   block->teleport_vel = vec_rotate_quadrants_clockwise(block->vel, teleport_result.results[block->clone_id].rotations);
+                                   block->teleport_accel = vec_rotate_quadrants_clockwise(block->accel, teleport_result.results[block->clone_id].rotations);
+                                   block->teleport_rotation = teleport_result.results[block->clone_id].rotations;
+
+                                   if((block->teleport_rotation % 2)){
+                                        block->teleport_vertical_move   = block->horizontal_move;
+                                        block->teleport_horizontal_move = block->vertical_move;
+
+                                        // figure out if we need to flip the horizontal or vertical move signs
+                                        {
+                                             auto prev_horizontal_dir = vec_direction(Vec_t{block->pos_delta.x, 0});
+                                             auto prev_vertical_dir = vec_direction(Vec_t{0, block->pos_delta.y});
 
-                              // LOG("block %d at %d, %d - %.10f, %.10f teleports to %d, %d - %.10f, %.10f\n",
-                              //     i, block->pos.pixel.x, block->pos.pixel.y, block->pos.decimal.x, block->pos.decimal.y,
-                              //     block->teleport_pos.pixel.x, block->teleport_pos.pixel.y, block->teleport_pos.decimal.x, block->teleport_pos.decimal.y);
+                                             auto cur_horizontal_dir = vec_direction(Vec_t{block->teleport_pos_delta.x, 0});
+                                             auto cur_vertical_dir = vec_direction(Vec_t{0, block->teleport_pos_delta.y});
 
-                              block->teleport_cut = block_cut_rotate_clockwise(block->cut, teleport_result.results[block->clone_id].rotations);
-                              block->teleport_pos.pixel -= block_center_pixel_offset(block->teleport_cut);
+                                             if(direction_is_positive(prev_horizontal_dir) != direction_is_positive(cur_vertical_dir)){
+                                                  move_flip_sign(&block->teleport_vertical_move);
+                                             }
 
-                              block->teleport_pos_delta = teleport_result.results[block->clone_id].delta;
-                              block->teleport_vel = vec_rotate_quadrants_clockwise(block->vel, teleport_result.results[block->clone_id].rotations);
-                              block->teleport_accel = vec_rotate_quadrants_clockwise(block->accel, teleport_result.results[block->clone_id].rotations);
-                              block->teleport_rotation = teleport_result.results[block->clone_id].rotations;
+                                             if(direction_is_positive(prev_vertical_dir) != direction_is_positive(cur_horizontal_dir)){
+                                                  move_flip_sign(&block->teleport_horizontal_move);
+                                             }
+                                        }
 
-                              if((block->teleport_rotation % 2)){
-                                   block->teleport_vertical_move   = block->horizontal_move;
-                                   block->teleport_horizontal_move = block->vertical_move;
+                                        for(S8 r = 0; r < block->teleport_rotation; r++){
+                                             block->prev_push_mask = direction_mask_rotate_clockwise(block->prev_push_mask);
+                                        }
+                                   }else{
+                                        block->teleport_horizontal_move = block->horizontal_move;
+                                        block->teleport_vertical_move = block->vertical_move;
 
-                                   // figure out if we need to flip the horizontal or vertical move signs
-                                   {
+                                        // figure out if we need to flip the horizontal or vertical move signs
                                         auto prev_horizontal_dir = vec_direction(Vec_t{block->pos_delta.x, 0});
                                         auto prev_vertical_dir = vec_direction(Vec_t{0, block->pos_delta.y});
 
                                         auto cur_horizontal_dir = vec_direction(Vec_t{block->teleport_pos_delta.x, 0});
                                         auto cur_vertical_dir = vec_direction(Vec_t{0, block->teleport_pos_delta.y});
 
-                                        if(direction_is_positive(prev_horizontal_dir) != direction_is_positive(cur_vertical_dir)){
+                                        if(direction_is_positive(prev_vertical_dir) != direction_is_positive(cur_vertical_dir)){
                                              move_flip_sign(&block->teleport_vertical_move);
                                         }
 
-                                        if(direction_is_positive(prev_vertical_dir) != direction_is_positive(cur_horizontal_dir)){
+                                        if(direction_is_positive(prev_horizontal_dir) != direction_is_positive(cur_horizontal_dir)){
                                              move_flip_sign(&block->teleport_horizontal_move);
                                         }
                                    }
 
-                                   for(S8 r = 0; r < block->teleport_rotation; r++){
-                                        block->prev_push_mask = direction_mask_rotate_clockwise(block->prev_push_mask);
-                                   }
-                              }else{
-                                   block->teleport_horizontal_move = block->horizontal_move;
-                                   block->teleport_vertical_move = block->vertical_move;
-
-                                   // figure out if we need to flip the horizontal or vertical move signs
-                                   auto prev_horizontal_dir = vec_direction(Vec_t{block->pos_delta.x, 0});
-                                   auto prev_vertical_dir = vec_direction(Vec_t{0, block->pos_delta.y});
-
-                                   auto cur_horizontal_dir = vec_direction(Vec_t{block->teleport_pos_delta.x, 0});
-                                   auto cur_vertical_dir = vec_direction(Vec_t{0, block->teleport_pos_delta.y});
-
-                                   if(direction_is_positive(prev_vertical_dir) != direction_is_positive(cur_vertical_dir)){
-                                        move_flip_sign(&block->teleport_vertical_move);
+                                   // update any stuck offsets
+                                   for(S16 a = 0; a < ARROW_ARRAY_MAX; a++){
+                                        Arrow_t* arrow = world.arrows.arrows + a;
+                                        if(!arrow->alive) continue;
+                                        if(arrow->stuck_type == STUCK_BLOCK && arrow->stuck_index == i){
+                                             arrow->face = direction_rotate_clockwise(arrow->face, teleport_result.results[block->clone_id].rotations);
+                                             arrow->stuck_offset = position_rotate_quadrants_clockwise(arrow->stuck_offset, teleport_result.results[block->clone_id].rotations);
+                                        }
                                    }
 
-                                   if(direction_is_positive(prev_horizontal_dir) != direction_is_positive(cur_horizontal_dir)){
-                                        move_flip_sign(&block->teleport_horizontal_move);
-                                   }
-                              }
+                                   Interactive_t* src_portal = quad_tree_interactive_find_at(world.interactive_qt, teleport_result.results[block->clone_id].src_portal);
+                                   Interactive_t* dst_portal = quad_tree_interactive_find_at(world.interactive_qt, teleport_result.results[block->clone_id].dst_portal);
+                                   if(src_portal && src_portal->type == INTERACTIVE_TYPE_PORTAL &&
+                                      dst_portal && dst_portal->type == INTERACTIVE_TYPE_PORTAL){
+                                       Direction_t src_portal_dir = src_portal->portal.face;
+                                       Direction_t dst_portal_dir = dst_portal->portal.face;
+
+                                       find_and_update_connected_teleported_block(block, direction_opposite(dst_portal_dir), &world);
+
+                                       if(block->connected_teleport.block_index >= 0)
+                                       {
+                                           auto against_result = block_against_other_blocks(block->teleport_pos + block->teleport_pos_delta,
+                                                                                            block->teleport_cut, block->connected_teleport.direction, world.block_qt, &world.blocks,
+                                                                                            world.interactive_qt, &world.tilemap);
+
+                                           F32 block_vel = 0;
+                                           F32 block_pos_delta = 0;
+
+                                           if(direction_is_horizontal(block->connected_teleport.direction)){
+                                               block_vel = block->teleport_vel.x;
+                                               block_pos_delta = block->teleport_pos_delta.x;
+                                           }else{
+                                               block_vel = block->teleport_vel.y;
+                                               block_pos_delta = block->teleport_pos_delta.y;
+                                           }
+
+                                           for(S16 a = 0; a < against_result.count; a++){
+                                               auto* against_other = against_result.objects + a;
+
+                                               if(against_other->block.index != block->connected_teleport.block_index) continue;
+
+                                               Block_t* connected_block = block_from_handle(&world.blocks, against_other->block);
+
+                                               Vec_t rotated_against_vel = vec_rotate_quadrants_counter_clockwise(connected_block->vel, against_other->rotations_through_portal);
+                                               Vec_t rotated_against_pos_delta = vec_rotate_quadrants_counter_clockwise(connected_block->pos_delta, against_other->rotations_through_portal);
+
+                                               F32 against_block_vel = 0;
+                                               F32 against_block_pos_delta = 0;
+
+                                               if(direction_is_horizontal(block->connected_teleport.direction)){
+                                                   against_block_vel = rotated_against_vel.x;
+                                                   against_block_pos_delta = rotated_against_pos_delta.x;
+                                               }else{
+                                                   against_block_vel = rotated_against_vel.y;
+                                                   against_block_pos_delta = rotated_against_pos_delta.y;
+                                               }
+
+                                               if(block_vel != against_block_vel || block_pos_delta != against_block_pos_delta) continue;
+
+                                               switch(block->connected_teleport.direction){
+                                               default:
+                                                   break;
+                                               case DIRECTION_LEFT:
+                                               {
+                                                   block->teleport_pos.pixel.x = connected_block->pos.pixel.x + block_get_width_in_pixels(connected_block->cut);
+                                                   block->teleport_pos.decimal.x = connected_block->pos.decimal.x;
+                                                   break;
+                                               }
+                                               case DIRECTION_RIGHT:
+                                               {
+                                                   block->teleport_pos.pixel.x = connected_block->pos.pixel.x - block_get_width_in_pixels(connected_block->cut);
+                                                   block->teleport_pos.decimal.x = connected_block->pos.decimal.x;
+                                                   break;
+                                               }
+                                               case DIRECTION_DOWN:
+                                               {
+                                                   block->teleport_pos.pixel.y = connected_block->pos.pixel.y + block_get_height_in_pixels(connected_block->cut);
+                                                   block->teleport_pos.decimal.y = connected_block->pos.decimal.y;
+                                                   break;
+                                               }
+                                               case DIRECTION_UP:
+                                               {
+                                                   block->teleport_pos.pixel.y = connected_block->pos.pixel.y - block_get_height_in_pixels(connected_block->cut);
+                                                   block->teleport_pos.decimal.y = connected_block->pos.decimal.y;
+                                                   break;
+                                               }
+                                               }
+                                           }
+
+                                           // clear dis
+                                           block->connected_teleport.block_index = -1;
+                                       }
 
-                              // update any stuck offsets
-                              for(S16 a = 0; a < ARROW_ARRAY_MAX; a++){
-                                   Arrow_t* arrow = world.arrows.arrows + a;
-                                   if(!arrow->alive) continue;
-                                   if(arrow->stuck_type == STUCK_BLOCK && arrow->stuck_index == i){
-                                        arrow->face = direction_rotate_clockwise(arrow->face, teleport_result.results[block->clone_id].rotations);
-                                        arrow->stuck_offset = position_rotate_quadrants_clockwise(arrow->stuck_offset, teleport_result.results[block->clone_id].rotations);
+                                       if(src_portal->portal.wants_to_turn_off && dst_portal->portal.wants_to_turn_off){
+                                           BlockCut_t original_src_cut = block->cut;
+                                           BlockCut_t final_src_cut = BLOCK_CUT_WHOLE;
+                                           BlockCut_t final_dst_cut = BLOCK_CUT_WHOLE;
+                                           Pixel_t final_dst_offset{0, 0};
+                                           Pixel_t final_src_offset{0, 0};
+
+                                           if(original_src_cut == BLOCK_CUT_TOP_LEFT_QUARTER ||
+                                              original_src_cut == BLOCK_CUT_TOP_RIGHT_QUARTER ||
+                                              original_src_cut == BLOCK_CUT_BOTTOM_LEFT_QUARTER ||
+                                              original_src_cut == BLOCK_CUT_BOTTOM_RIGHT_QUARTER ||
+                                              (direction_is_horizontal(src_portal_dir) &&
+                                               (original_src_cut == BLOCK_CUT_LEFT_HALF || original_src_cut == BLOCK_CUT_RIGHT_HALF)) ||
+                                              (!direction_is_horizontal(src_portal_dir) &&
+                                               (original_src_cut == BLOCK_CUT_TOP_HALF || original_src_cut == BLOCK_CUT_BOTTOM_HALF))){
+                                               // we kill the block
+                                               // TODO: I'm hesitant to actually kill it because things use block index as references, so we move it to the origin
+                                               block->teleport_pos.pixel = Pixel_t{-TILE_SIZE_IN_PIXELS, -TILE_SIZE_IN_PIXELS};
+                                               add_global_tag(TAG_BLOCK_GETS_DESTROYED);
+                                           }else{
+                                               if(original_src_cut == BLOCK_CUT_WHOLE){
+                                                   switch(src_portal_dir){
+                                                   default:
+                                                      break;
+                                                   case DIRECTION_LEFT:
+                                                      final_src_cut = BLOCK_CUT_RIGHT_HALF;
+                                                      final_dst_cut = BLOCK_CUT_LEFT_HALF;
+                                                      break;
+                                                   case DIRECTION_RIGHT:
+                                                      final_src_cut = BLOCK_CUT_LEFT_HALF;
+                                                      final_dst_cut = BLOCK_CUT_RIGHT_HALF;
+                                                      break;
+                                                   case DIRECTION_DOWN:
+                                                      final_src_cut = BLOCK_CUT_TOP_HALF;
+                                                      final_dst_cut = BLOCK_CUT_BOTTOM_HALF;
+                                                      break;
+                                                   case DIRECTION_UP:
+                                                      final_src_cut = BLOCK_CUT_BOTTOM_HALF;
+                                                      final_dst_cut = BLOCK_CUT_TOP_HALF;
+                                                      break;
+                                                   }
+                                               }else if(original_src_cut == BLOCK_CUT_LEFT_HALF){
+                                                   switch(src_portal_dir){
+                                                   default:
+                                                       break;
+                                                   case DIRECTION_DOWN:
+                                                       final_src_cut = BLOCK_CUT_TOP_LEFT_QUARTER;
+                                                       final_dst_cut = BLOCK_CUT_BOTTOM_LEFT_QUARTER;
+                                                       break;
+                                                   case DIRECTION_UP:
+                                                       final_src_cut = BLOCK_CUT_BOTTOM_LEFT_QUARTER;
+                                                       final_dst_cut = BLOCK_CUT_TOP_LEFT_QUARTER;
+                                                       break;
+                                                   }
+                                               }else if(original_src_cut == BLOCK_CUT_RIGHT_HALF){
+                                                   switch(src_portal_dir){
+                                                   default:
+                                                       break;
+                                                   case DIRECTION_DOWN:
+                                                       final_src_cut = BLOCK_CUT_TOP_RIGHT_QUARTER;
+                                                       final_dst_cut = BLOCK_CUT_BOTTOM_RIGHT_QUARTER;
+                                                       break;
+                                                   case DIRECTION_UP:
+                                                       final_src_cut = BLOCK_CUT_BOTTOM_RIGHT_QUARTER;
+                                                       final_dst_cut = BLOCK_CUT_TOP_RIGHT_QUARTER;
+                                                       break;
+                                                   }
+                                               }else if(original_src_cut == BLOCK_CUT_TOP_HALF){
+                                                   switch(src_portal_dir){
+                                                   default:
+                                                       break;
+                                                   case DIRECTION_LEFT:
+                                                       final_src_cut = BLOCK_CUT_TOP_RIGHT_QUARTER;
+                                                       final_dst_cut = BLOCK_CUT_TOP_LEFT_QUARTER;
+                                                       break;
+                                                   case DIRECTION_RIGHT:
+                                                       final_src_cut = BLOCK_CUT_TOP_LEFT_QUARTER;
+                                                       final_dst_cut = BLOCK_CUT_TOP_RIGHT_QUARTER;
+                                                       break;
+                                                   }
+                                               }else if(original_src_cut == BLOCK_CUT_BOTTOM_HALF){
+                                                   switch(src_portal_dir){
+                                                   default:
+                                                       break;
+                                                   case DIRECTION_LEFT:
+                                                       final_src_cut = BLOCK_CUT_BOTTOM_RIGHT_QUARTER;
+                                                       final_dst_cut = BLOCK_CUT_BOTTOM_LEFT_QUARTER;
+                                                       break;
+                                                   case DIRECTION_RIGHT:
+                                                       final_src_cut = BLOCK_CUT_BOTTOM_LEFT_QUARTER;
+                                                       final_dst_cut = BLOCK_CUT_BOTTOM_RIGHT_QUARTER;
+                                                       break;
+                                                   }
+                                               }
+
+                                               final_dst_cut = block_cut_rotate_clockwise(final_dst_cut, teleport_result.results[block->clone_id].rotations);
+
+                                               switch(src_portal_dir){
+                                               default:
+                                                   break;
+                                               case DIRECTION_LEFT:
+                                                   final_src_offset.x = block_center_pixel_offset(block->cut).x;
+                                                   break;
+                                               case DIRECTION_RIGHT:
+                                                   break;
+                                               case DIRECTION_DOWN:
+                                                   final_src_offset.y = block_center_pixel_offset(block->cut).y;
+                                                   break;
+                                               case DIRECTION_UP:
+                                                   break;
+                                               }
+
+                                               switch(dst_portal_dir){
+                                               default:
+                                                   break;
+                                               case DIRECTION_LEFT:
+                                                   final_dst_offset.x = block_center_pixel_offset(block->teleport_cut).x;
+                                                   break;
+                                               case DIRECTION_RIGHT:
+                                                   break;
+                                               case DIRECTION_DOWN:
+                                                   final_dst_offset.y = block_center_pixel_offset(block->teleport_cut).y;
+                                                   break;
+                                               case DIRECTION_UP:
+                                                   break;
+                                               }
+
+                                               S16 new_block_index = world.blocks.count;
+                                               ObjectHandle_t block_handle = object_handle(&world.blocks, i);
+                                               if(resize(&world.blocks, world.blocks.count + (S16)(1))){
+                                                   // growing may move the blocks, so look our block back up
+                                                   block = object_from_handle(&world.blocks, block_handle);
+
+                                                   Block_t* new_block = world.blocks.elements + new_block_index;
+                                                   *new_block = *block;
+                                                   new_block->teleport = false;
+                                                   new_block->cut = final_src_cut;
+                                                   new_block->pos.pixel += final_src_offset;
+                                                   new_block->previous_mass = get_block_stack_mass(&world, new_block);
+                                                   new_block->element = put_out_element(block->element);
+
+                                                   if(direction_is_horizontal(src_portal_dir)){
+                                                        new_block->stop_on_pixel_x = closest_pixel(new_block->pos.pixel.x, new_block->pos.decimal.x);
+                                                   }else{
+                                                        new_block->stop_on_pixel_y = closest_pixel(new_block->pos.pixel.y, new_block->pos.decimal.y);
+                                                   }
+                                               }
+
+                                               block->teleport_pos.pixel += final_dst_offset;
+                                               block->teleport_cut = final_dst_cut;
+                                               block->teleport_split = true;
+                                               block->element = put_out_element(block->element);
+
+                                               add_global_tag(TAG_BLOCK_GETS_SPLIT);
+                                           }
+
+                                           src_portal->portal.on = false;
+                                           dst_portal->portal.on = false;
+                                           src_portal->portal.wants_to_turn_off = false;
+                                           dst_portal->portal.wants_to_turn_off = false;
+                                       }
                                    }
-                              }
 
-                              Interactive_t* src_portal = quad_tree_interactive_find_at(world.interactive_qt, teleport_result.results[block->clone_id].src_portal);
-                              Interactive_t* dst_portal = quad_tree_interactive_find_at(world.interactive_qt, teleport_result.results[block->clone_id].dst_portal);
-                              if(src_portal && src_portal->type == INTERACTIVE_TYPE_PORTAL &&
-                                 dst_portal && dst_portal->type == INTERACTIVE_TYPE_PORTAL){
-                                  Direction_t src_portal_dir = src_portal->portal.face;
-                                  Direction_t dst_portal_dir = dst_portal->portal.face;
-
-                                  find_and_update_connected_teleported_block(block, direction_opposite(dst_portal_dir), &world);
-
-                                  if(block->connected_teleport.block_index >= 0)
-                                  {
-                                      auto against_result = block_against_other_blocks(block->teleport_pos + block->teleport_pos_delta,
-                                                                                       block->teleport_cut, block->connected_teleport.direction, world.block_qt,
-                                                                                       world.interactive_qt, &world.tilemap);
-
-                                      F32 block_vel = 0;
-                                      F32 block_pos_delta = 0;
-
-                                      if(direction_is_horizontal(block->connected_teleport.direction)){
-                                          block_vel = block->teleport_vel.x;
-                                          block_pos_delta = block->teleport_pos_delta.x;
-                                      }else{
-                                          block_vel = block->teleport_vel.y;
-                                          block_pos_delta = block->teleport_pos_delta.y;
-                                      }
-
-                                      for(S16 a = 0; a < against_result.count; a++){
-                                          auto* against_other = against_result.objects + a;
-
-                                          if(get_block_index(&world, against_other->block) != block->connected_teleport.block_index) continue;
-
-                                          Vec_t rotated_against_vel = vec_rotate_quadrants_counter_clockwise(against_other->block->vel, against_other->rotations_through_portal);
-                                          Vec_t rotated_against_pos_delta = vec_rotate_quadrants_counter_clockwise(against_other->block->pos_delta, against_other->rotations_through_portal);
-
-                                          F32 against_block_vel = 0;
-                                          F32 against_block_pos_delta = 0;
-
-                                          if(direction_is_horizontal(block->connected_teleport.direction)){
-                                              against_block_vel = rotated_against_vel.x;
-                                              against_block_pos_delta = rotated_against_pos_delta.x;
-                                          }else{
-                                              against_block_vel = rotated_against_vel.y;
-                                              against_block_pos_delta = rotated_against_pos_delta.y;
-                                          }
-
-                                          if(block_vel != against_block_vel || block_pos_delta != against_block_pos_delta) continue;
-
-                                          switch(block->connected_teleport.direction){
-                                          default:
-                                              break;
-                                          case DIRECTION_LEFT:
-                                          {
-                                              block->teleport_pos.pixel.x = against_other->block->pos.pixel.x + block_get_width_in_pixels(against_other->block->cut);
-                                              block->teleport_pos.decimal.x = against_other->block->pos.decimal.x;
-                                              break;
-                                          }
-                                          case DIRECTION_RIGHT:
-                                          {
-                                              block->teleport_pos.pixel.x = against_other->block->pos.pixel.x - block_get_width_in_pixels(against_other->block->cut);
-                                              block->teleport_pos.decimal.x = against_other->block->pos.decimal.x;
-                                              break;
-                                          }
-                                          case DIRECTION_DOWN:
-                                          {
-                                              block->teleport_pos.pixel.y = against_other->block->pos.pixel.y + block_get_height_in_pixels(against_other->block->cut);
-                                              block->teleport_pos.decimal.y = against_other->block->pos.decimal.y;
-                                              break;
-                                          }
-                                          case DIRECTION_UP:
-                                          {
-                                              block->teleport_pos.pixel.y = against_other->block->pos.pixel.y - block_get_height_in_pixels(against_other->block->cut);
-                                              block->teleport_pos.decimal.y = against_other->block->pos.decimal.y;
-                                              break;
-                                          }
-                                          }
-                                      }
-
-                                      // clear dis
-                                      block->connected_teleport.block_index = -1;
-                                  }
+                                   // TODO: maybe only do this one time per loop in case multiple blocks teleport in a frame
+                                   // re-calculate the quad tree using the new teleported position for the block
+                                   quad_tree_free(world.block_qt);
+                                   world.block_qt = quad_tree_build(&world.blocks);
 
-                                  if(src_portal->portal.wants_to_turn_off && dst_portal->portal.wants_to_turn_off){
-                                      BlockCut_t original_src_cut = block->cut;
-                                      BlockCut_t final_src_cut = BLOCK_CUT_WHOLE;
-                                      BlockCut_t final_dst_cut = BLOCK_CUT_WHOLE;
-                                      Pixel_t final_dst_offset{0, 0};
-                                      Pixel_t final_src_offset{0, 0};
-
-                                      if(original_src_cut == BLOCK_CUT_TOP_LEFT_QUARTER ||
-                                         original_src_cut == BLOCK_CUT_TOP_RIGHT_QUARTER ||
-                                         original_src_cut == BLOCK_CUT_BOTTOM_LEFT_QUARTER ||
-                                         original_src_cut == BLOCK_CUT_BOTTOM_RIGHT_QUARTER ||
-                                         (direction_is_horizontal(src_portal_dir) &&
-                                          (original_src_cut == BLOCK_CUT_LEFT_HALF || original_src_cut == BLOCK_CUT_RIGHT_HALF)) ||
-                                         (!direction_is_horizontal(src_portal_dir) &&
-                                          (original_src_cut == BLOCK_CUT_TOP_HALF || original_src_cut == BLOCK_CUT_BOTTOM_HALF))){
-                                          // we kill the block
-                                          // TODO: I'm hesitant to actually kill it because things use block index as references, so we move it to the origin
-                                          block->teleport_pos.pixel = Pixel_t{-TILE_SIZE_IN_PIXELS, -TILE_SIZE_IN_PIXELS};
-                                          add_global_tag(TAG_BLOCK_GETS_DESTROYED);
-                                      }else{
-                                          if(original_src_cut == BLOCK_CUT_WHOLE){
-                                              switch(src_portal_dir){
-                                              default:
-                                                 break;
-                                              case DIRECTION_LEFT:
-                                                 final_src_cut = BLOCK_CUT_RIGHT_HALF;
-                                                 final_dst_cut = BLOCK_CUT_LEFT_HALF;
-                                                 break;
-                                              case DIRECTION_RIGHT:
-                                                 final_src_cut = BLOCK_CUT_LEFT_HALF;
-                                                 final_dst_cut = BLOCK_CUT_RIGHT_HALF;
-                                                 break;
-                                              case DIRECTION_DOWN:
-                                                 final_src_cut = BLOCK_CUT_TOP_HALF;
-                                                 final_dst_cut = BLOCK_CUT_BOTTOM_HALF;
-                                                 break;
-                                              case DIRECTION_UP:
-                                                 final_src_cut = BLOCK_CUT_BOTTOM_HALF;
-                                                 final_dst_cut = BLOCK_CUT_TOP_HALF;
-                                                 break;
-                                              }
-                                          }else if(original_src_cut == BLOCK_CUT_LEFT_HALF){
-                                              switch(src_portal_dir){
-                                              default:
-                                                  break;
-                                              case DIRECTION_DOWN:
-                                                  final_src_cut = BLOCK_CUT_TOP_LEFT_QUARTER;
-                                                  final_dst_cut = BLOCK_CUT_BOTTOM_LEFT_QUARTER;
-                                                  break;
-                                              case DIRECTION_UP:
-                                                  final_src_cut = BLOCK_CUT_BOTTOM_LEFT_QUARTER;
-                                                  final_dst_cut = BLOCK_CUT_TOP_LEFT_QUARTER;
-                                                  break;
-                                              }
-                                          }else if(original_src_cut == BLOCK_CUT_RIGHT_HALF){
-                                              switch(src_portal_dir){
-                                              default:
-                                                  break;
-                                              case DIRECTION_DOWN:
-                                                  final_src_cut = BLOCK_CUT_TOP_RIGHT_QUARTER;
-                                                  final_dst_cut = BLOCK_CUT_BOTTOM_RIGHT_QUARTER;
-                                                  break;
-                                              case DIRECTION_UP:
-                                                  final_src_cut = BLOCK_CUT_BOTTOM_RIGHT_QUARTER;
-                                                  final_dst_cut = BLOCK_CUT_TOP_RIGHT_QUARTER;
-                                                  break;
-                                              }
-                                          }else if(original_src_cut == BLOCK_CUT_TOP_HALF){
-                                              switch(src_portal_dir){
-                                              default:
-                                                  break;
-                                              case DIRECTION_LEFT:
-                                                  final_src_cut = BLOCK_CUT_TOP_RIGHT_QUARTER;
-                                                  final_dst_cut = BLOCK_CUT_TOP_LEFT_QUARTER;
-                                                  break;
-                                              case DIRECTION_RIGHT:
-                                                  final_src_cut = BLOCK_CUT_TOP_LEFT_QUARTER;
-                                                  final_dst_cut = BLOCK_CUT_TOP_RIGHT_QUARTER;
-                                                  break;
-                                              }
-                                          }else if(original_src_cut == BLOCK_CUT_BOTTOM_HALF){
-                                              switch(src_portal_dir){
-                                              default:
-                                                  break;
-                                              case DIRECTION_LEFT:
-                                                  final_src_cut = BLOCK_CUT_BOTTOM_RIGHT_QUARTER;
-                                                  final_dst_cut = BLOCK_CUT_BOTTOM_LEFT_QUARTER;
-                                                  break;
-                                              case DIRECTION_RIGHT:
-                                                  final_src_cut = BLOCK_CUT_BOTTOM_LEFT_QUARTER;
-                                                  final_dst_cut = BLOCK_CUT_BOTTOM_RIGHT_QUARTER;
-                                                  break;
-                                              }
-                                          }
-
-                                          final_dst_cut = block_cut_rotate_clockwise(final_dst_cut, teleport_result.results[block->clone_id].rotations);
-
-                                          switch(src_portal_dir){
-                                          default:
-                                              break;
-                                          case DIRECTION_LEFT:
-                                              final_src_offset.x = block_center_pixel_offset(block->cut).x;
-                                              break;
-                                          case DIRECTION_RIGHT:
-                                              break;
-                                          case DIRECTION_DOWN:
-                                              final_src_offset.y = block_center_pixel_offset(block->cut).y;
-                                              break;
-                                          case DIRECTION_UP:
-                                              break;
-                                          }
-
-                                          switch(dst_portal_dir){
-                                          default:
-                                              break;
-                                          case DIRECTION_LEFT:
-                                              final_dst_offset.x = block_center_pixel_offset(block->teleport_cut).x;
-                                              break;
-                                          case DIRECTION_RIGHT:
-                                              break;
-                                          case DIRECTION_DOWN:
-                                              final_dst_offset.y = block_center_pixel_offset(block->teleport_cut).y;
-                                              break;
-                                          case DIRECTION_UP:
-                                              break;
-                                          }
-
-                                          S16 new_block_index = world.blocks.count;
-                                          if(resize(&world.blocks, world.blocks.count + (S16)(1))){
-                                              // a resize will kill our block ptr, so we gotta update it
-                                              block = world.blocks.elements + i;
-
-                                              Block_t* new_block = world.blocks.elements + new_block_index;
-                                              *new_block = *block;
-                                              new_block->teleport = false;
-                                              new_block->cut = final_src_cut;
-                                              new_block->pos.pixel += final_src_offset;
-                                              new_block->previous_mass = get_block_stack_mass(&world, new_block);
-                                              new_block->element = put_out_element(block->element);
-
-                                              if(direction_is_horizontal(src_portal_dir)){
-                                                   new_block->stop_on_pixel_x = closest_pixel(new_block->pos.pixel.x, new_block->pos.decimal.x);
-                                              }else{
-                                                   new_block->stop_on_pixel_y = closest_pixel(new_block->pos.pixel.y, new_block->pos.decimal.y);
-                                              }
-                                          }
-
-                                          block->teleport_pos.pixel += final_dst_offset;
-                                          block->teleport_cut = final_dst_cut;
-                                          block->teleport_split = true;
-                                          block->element = put_out_element(block->element);
-
-                                          add_global_tag(TAG_BLOCK_GETS_SPLIT);
-                                      }
-
-                                      src_portal->portal.on = false;
-                                      dst_portal->portal.on = false;
-                                      src_portal->portal.wants_to_turn_off = false;
-                                      dst_portal->portal.wants_to_turn_off = false;
-                                  }
+                                   repeat_collision_pass = true;
                               }
-
-                              // TODO: maybe only do this one time per loop in case multiple blocks teleport in a frame
-                              // re-calculate the quad tree using the new teleported position for the block
-                              quad_tree_free(world.block_qt);
-                              world.block_qt = quad_tree_build(&world.blocks);
-
-                              repeat_collision_pass = true;
                          }
-                    }
 
-                    // to fight the battle against floating point error, track any blocks we are connected to (going the same speed)
-                    for(S16 i = 0; i < world.blocks.count; i++){
-                         Block_t* block = world.blocks.elements + i;
+                         // to fight the battle against floating point error, track any blocks we are connected to (going the same speed)
+                         for(S16 island_block = 0; island_block < collision_islands.block_count(&world, island_index); island_block++){
+                              S16 i = collision_islands.block_index(&world, island_index, island_block);
+                              Block_t* block = world.blocks.elements + i;
 
-                         Vec_t block_pos_delta_vec = block_get_pos_delta(block);
+                              Vec_t block_pos_delta_vec = block_get_pos_delta(block);
 
-                         if(block_pos_delta_vec.x == 0 && block_pos_delta_vec.y == 0) continue;
+                              if(block_pos_delta_vec.x == 0 && block_pos_delta_vec.y == 0) continue;
 
-                         bool against_any = false;
+                              bool against_any = false;
 
-                         for(S16 d = 0; d < DIRECTION_COUNT; d++){
-                              auto direction = (Direction_t)(d);
+                              for(S16 d = 0; d < DIRECTION_COUNT; d++){
+                                   auto direction = (Direction_t)(d);
 
-                              against_any |= find_and_update_connected_teleported_block(block, direction, &world);
-                         }
-
-                         if(!against_any) block->connected_teleport.block_index = -1;
-                    }
+                                   against_any |= find_and_update_connected_teleported_block(block, direction, &world);
+                              }
 
-                    // player movement
-                    S16 update_player_count = world.players.count; // save due to adding/removing players
-                    for(S16 i = 0; i < update_player_count; i++){
-                         Player_t* player = world.players.elements + i;
+                              if(!against_any) block->connected_teleport.block_index = -1;
+                         }
 
-                         Coord_t player_coord = pos_to_coord(player->pos + player->pos_delta);
+                         // player movement
+                         S16 update_player_count = 0; // save due to adding/removing players
+                         if(collision_islands.islands[island_index].has_players) update_player_count = world.players.count;
+                         for(S16 i = 0; i < update_player_count; i++){
+                              Player_t* player = world.players.elements + i;
 
-                         MovePlayerThroughWorldResult_t move_result {};
+                              Coord_t player_coord = pos_to_coord(player->pos + player->pos_delta);
 
-                         if(player->teleport){
-                              move_result = move_player_through_world(player->teleport_pos, player->teleport_vel, player->teleport_pos_delta, player->teleport_face,
-                                                                      player->clone_instance, i, player->teleport_pushing_block, player->teleport_pushing_block_dir,
-                                                                      player->teleport_pushing_block_rotation, &world);
+                              MovePlayerThroughWorldResult_t move_result {};
 
-                              if(move_result.collided) repeat_collision_pass = true;
-                              if(move_result.resetting){
-                                   fade_state = FADE_STATE_RESETTING_ROOM;
-                                   fade_time = FADE_RESET_TIME;
-                                   stop_player_action_movement(&player_action, &world.players, &record_demo, frame_count);
-                              }
-                              player->teleport_pos_delta = move_result.pos_delta;
-                              player->teleport_pushing_block = move_result.pushing_block;
-                              player->teleport_pushing_block_dir = move_result.pushing_block_dir;
-                              player->teleport_pushing_block_rotation = move_result.pushing_block_rotation;
-                         }else{
-                              move_result = move_player_through_world(player->pos, player->vel, player->pos_delta, player->face,
-                                                                      player->clone_instance, i, player->pushing_block,
-                                                                      player->pushing_block_dir, player->pushing_block_rotation,
-                                                                      &world);
+                              if(player->teleport){
+                                   move_result = move_player_through_world(player->teleport_pos, player->teleport_vel, player->teleport_pos_delta, player->teleport_face,
+                                                                           player->clone_instance, i, player->teleport_pushing_block, player->teleport_pushing_block_dir,
+                                                                           player->teleport_pushing_block_rotation, &world);
 
-                              if(move_result.collided) repeat_collision_pass = true;
-                              if(move_result.resetting){
-                                   fade_state = FADE_STATE_RESETTING_ROOM;
-                                   fade_time = FADE_RESET_TIME;
-                                   stop_player_action_movement(&player_action, &world.players, &record_demo, frame_count);
+                                   if(move_result.collided) repeat_collision_pass = true;
+                                   if(move_result.resetting){
+                                        fade_state = FADE_STATE_RESETTING_ROOM;
+                                        fade_time = FADE_RESET_TIME;
+                                        stop_player_action_movement(&player_action, &world.players, &record_demo, frame_count);
+                                   }
+                                   player->teleport_pos_delta = move_result.pos_delta;
+                                   player->teleport_pushing_block = move_result.pushing_block;
+                                   player->teleport_pushing_block_dir = move_result.pushing_block_dir;
+                                   player->teleport_pushing_block_rotation = move_result.pushing_block_rotation;
+                              }else{
+                                   move_result = move_player_through_world(player->pos, player->vel, player->pos_delta, player->face,
+                                                                           player->clone_instance, i, player->pushing_block,
+                                                                           player->pushing_block_dir, player->pushing_block_rotation,
+                                                                           &world);
+
+                                   if(move_result.collided) repeat_collision_pass = true;
+                                   if(move_result.resetting){
+                                        fade_state = FADE_STATE_RESETTING_ROOM;
+                                        fade_time = FADE_RESET_TIME;
+                                        stop_player_action_movement(&player_action, &world.players, &record_demo, frame_count);
+                                   }
+                                   player->pos_delta = move_result.pos_delta;
+                                   player->pushing_block = move_result.pushing_block;
+                                   player->pushing_block_dir = move_result.pushing_block_dir;
+                                   player->pushing_block_rotation = move_result.pushing_block_rotation;
                               }
-                              player->pos_delta = move_result.pos_delta;
-                              player->pushing_block = move_result.pushing_block;
-                              player->pushing_block_dir = move_result.pushing_block_dir;
-                              player->pushing_block_rotation = move_result.pushing_block_rotation;
-                         }
 
-                         auto* portal = player_is_teleporting(player, world.interactive_qt);
+                              auto* portal = player_is_teleporting(player, world.interactive_qt);
 
-                         if(portal && player->clone_start.x == 0){
-                              // at the first instant of the block teleporting, check if we should create an entangled_block
+                              if(portal && player->clone_start.x == 0){
+                                   // at the first instant of the block teleporting, check if we should create an entangled_block
 
-                              PortalExit_t portal_exits = find_portal_exits(portal->coord, &world.tilemap, world.interactive_qt);
-                              S8 count = portal_exit_count(&portal_exits);
-                              if(count >= 3){ // src portal, dst portal, clone portal
-                                   world.clone_instance++;
+                                   PortalExit_t portal_exits = find_portal_exits(portal->coord, &world.tilemap, world.interactive_qt);
+                                   S8 count = portal_exit_count(&portal_exits);
+                                   if(count >= 3){ // src portal, dst portal, clone portal
+                                        world.clone_instance++;
 
-                                   S8 clone_id = 0;
-                                   for (auto &direction : portal_exits.directions) {
-                                        for(int p = 0; p < direction.count; p++){
-                                             if(direction.coords[p] == portal->coord) continue;
+                                        S8 clone_id = 0;
+                                        for (auto &direction : portal_exits.directions) {
+                                             for(int p = 0; p < direction.count; p++){
+                                                  if(direction.coords[p] == portal->coord) continue;
 
-                                             if(clone_id == 0){
-                                                  player->clone_id = clone_id;
-                                                  player->clone_instance = world.clone_instance;
-                                             }else{
-                                                  S16 new_player_index = world.players.count;
-                                                  add_global_tag(TAG_PLAYER_GETS_ENTANGLED);
-
-                                                  if(resize(&world.players, world.players.count + (S16)(1))){
-                                                       // a resize will kill our player ptr, so we gotta update it
-                                                       player = world.players.elements + i;
-                                                       player->clone_start = portal->coord;
+                                                  if(clone_id == 0){
+                                                       player->clone_id = clone_id;
+                                                       player->clone_instance = world.clone_instance;
+                                                  }else{
+                                                       S16 new_player_index = world.players.count;
+                                                       ObjectHandle_t player_handle = object_handle(&world.players, i);
+                                                       add_global_tag(TAG_PLAYER_GETS_ENTANGLED);
+
+                                                       if(resize(&world.players, world.players.count + (S16)(1))){
+                                                            // growing may move the players, so look our player back up
+                                                            player = object_from_handle(&world.players, player_handle);
+                                                            player->clone_start = portal->coord;
+
+                                                            Player_t* new_player = world.players.elements + new_player_index;
+                                                            *new_player = *player;
+                                                            new_player->clone_id = clone_id;
+                                                       }
 
-                                                       Player_t* new_player = world.players.elements + new_player_index;
-                                                       *new_player = *player;
-                                                       new_player->clone_id = clone_id;
+                                                       if(world.players.count > 2){
+                                                            add_global_tag(TAG_THREE_PLUS_PLAYERS_ENTANGLED);
+                                                       }
                                                   }
 
-                                                  if(world.players.count > 2){
-                                                       add_global_tag(TAG_THREE_PLUS_PLAYERS_ENTANGLED);
-                                                  }
+                                                  clone_id++;
                                              }
-
-                                             clone_id++;
                                         }
                                    }
-                              }
-                         }else if(!portal && player->clone_start.x > 0){
-                              auto clone_portal_center = coord_to_pixel_at_center(player->clone_start);
-                              F64 player_distance_from_portal = pixel_distance_between(clone_portal_center, player->pos.pixel);
-                              bool from_clone_start = (player_distance_from_portal < TILE_SIZE_IN_PIXELS);
-
-                              if(from_clone_start){
-                                   // loop across all players after this one
-                                   for(S16 p = 0; p < world.players.count; p++){
-                                        if(p == i) continue;
-                                        Player_t* other_player = world.players.elements + p;
-                                        if(other_player->clone_instance == player->clone_instance){
-                                             // TODO: I think I may have a really subtle bug here where we actually move
-                                             // TODO: the i'th player around because it was the last in the array
-                                             remove(&world.players, p);
-
-                                             // update ptr since we could have resized
-                                             player = world.players.elements + i;
-
-                                             update_player_count--;
+                              }else if(!portal && player->clone_start.x > 0){
+                                   auto clone_portal_center = coord_to_pixel_at_center(player->clone_start);
+                                   F64 player_distance_from_portal = pixel_distance_between(clone_portal_center, player->pos.pixel);
+                                   bool from_clone_start = (player_distance_from_portal < TILE_SIZE_IN_PIXELS);
+
+                                   if(from_clone_start){
+                                        // loop across all players after this one
+                                        for(S16 p = 0; p < world.players.count; p++){
+                                             if(p == i) continue;
+                                             Player_t* other_player = world.players.elements + p;
+                                             if(other_player->clone_instance == player->clone_instance){
+                                                  // TODO: I think I may have a really subtle bug here where we actually move
+                                                  // TODO: the i'th player around because it was the last in the array
+                                                  remove(&world.players, p);
+
+                                                  // update ptr since we could have resized
+                                                  player = world.players.elements + i;
+
+                                                  update_player_count--;
+                                             }
                                         }
-                                   }
-                              }else{
-                                   for(S16 p = 0; p < world.players.count; p++){
-                                        if(p == i) continue;
-                                        Player_t* other_player = world.players.elements + p;
-                                        if(other_player->clone_instance == player->clone_instance){
-                                             other_player->clone_id = 0;
-                                             other_player->clone_instance = 0;
-                                             other_player->clone_start = Coord_t{};
+                                   }else{
+                                        for(S16 p = 0; p < world.players.count; p++){
+                                             if(p == i) continue;
+                                             Player_t* other_player = world.players.elements + p;
+                                             if(other_player->clone_instance == player->clone_instance){
+                                                  other_player->clone_id = 0;
+                                                  other_player->clone_instance = 0;
+                                                  other_player->clone_start = Coord_t{};
+                                             }
                                         }
-                                   }
 
-                                   // turn off the circuit
-                                   auto* src_portal = quad_tree_find_at(world.interactive_qt, player->clone_start.x, player->clone_start.y);
-                                   if(is_active_portal(src_portal)){
-                                        activate(&world, player->clone_start);
-                                        src_portal->portal.on = false;
+                                        // turn off the circuit
+                                        auto* src_portal = quad_tree_find_at(world.interactive_qt, player->clone_start.x, player->clone_start.y);
+                                        if(is_active_portal(src_portal)){
+                                             activate(&world, player->clone_start);
+                                             src_portal->portal.on = false;
+                                        }
                                    }
-                              }
 
-                              player->clone_id = 0;
-                              player->clone_instance = 0;
-                              player->clone_start = Coord_t{};
-                         }
+                                   player->clone_id = 0;
+                                   player->clone_instance = 0;
+                                   player->clone_start = Coord_t{};
+                              }
 
-                         Interactive_t* interactive = quad_tree_find_at(world.interactive_qt, player_coord.x, player_coord.y);
-                         if(interactive && interactive->type == INTERACTIVE_TYPE_CLONE_KILLER){
-                              if(i == 0){
-                                   resize(&world.players, 1);
-                                   update_player_count = 1;
-                              }else{
-                                   // TODO: How do we handle if they are in a room that can't reset ?
-                                   fade_state = FADE_STATE_RESETTING_ROOM;
-                                   fade_time = FADE_RESET_TIME;
-                                   stop_player_action_movement(&player_action, &world.players, &record_demo, frame_count);
+                              Interactive_t* interactive = quad_tree_find_at(world.interactive_qt, player_coord.x, player_coord.y);
+                              if(interactive && interactive->type == INTERACTIVE_TYPE_CLONE_KILLER){
+                                   if(i == 0){
+                                        resize(&world.players, 1);
+                                        update_player_count = 1;
+                                   }else{
+                                        // TODO: How do we handle if they are in a room that can't reset ?
+                                        fade_state = FADE_STATE_RESETTING_ROOM;
+                                        fade_time = FADE_RESET_TIME;
+                                        stop_player_action_movement(&player_action, &world.players, &record_demo, frame_count);
+                                   }
                               }
-                         }
 
-                         auto result = player_in_block_rect(player, &world.tilemap, world.interactive_qt, world.block_qt);
-                         for(S8 e = 0; e < result.entries.count; e++){
-                              auto& entry = result.entries.objects[e];
-                              if(entry.block_pos.z == player->pos.z - HEIGHT_INTERVAL){
-                                   auto block_index = get_block_index(&world, entry.block);
-                                   auto block_pos_delta = entry.block->teleport ? entry.block->teleport_pos_delta : entry.block->pos_delta;
-                                   auto rotated_pos_delta = vec_rotate_quadrants_clockwise(block_pos_delta, entry.portal_rotations);
-                                   auto old_carried_pos_delta = player->carried_pos_delta.positive + player->carried_pos_delta.negative;
-                                   bool carried = get_carried_noob(&player->carried_pos_delta, rotated_pos_delta, block_index, false);
-                                   if(!carried){
-                                        auto new_carried_pos_delta = player->carried_pos_delta.positive + player->carried_pos_delta.negative;
-
-                                        if(player->teleport){
-                                             player->teleport_pos_delta -= old_carried_pos_delta;
-                                             player->teleport_pos_delta += new_carried_pos_delta;
-                                        }else{
-                                             player->pos_delta -= old_carried_pos_delta;
-                                             player->pos_delta += new_carried_pos_delta;
-                                        }
+                              auto result = player_in_block_rect(player, &world.tilemap, world.interactive_qt, world.block_qt, &world.blocks);
+                              for(S8 e = 0; e < result.entries.count; e++){
+                                   auto& entry = result.entries.objects[e];
+                                   if(entry.block_pos.z == player->pos.z - HEIGHT_INTERVAL){
+                                        auto block_index = entry.block.index;
+                                        auto entry_block = block_from_handle(&world.blocks, entry.block);
+                                        auto block_pos_delta = entry_block->teleport ? entry_block->teleport_pos_delta : entry_block->pos_delta;
+                                        auto rotated_pos_delta = vec_rotate_quadrants_clockwise(block_pos_delta, entry.portal_rotations);
+                                        auto old_carried_pos_delta = player->carried_pos_delta.positive + player->carried_pos_delta.negative;
+                                        bool carried = get_carried_noob(&player->carried_pos_delta, rotated_pos_delta, block_index, false);
+                                        if(!carried){
+                                             auto new_carried_pos_delta = player->carried_pos_delta.positive + player->carried_pos_delta.negative;
+
+                                             if(player->teleport){
+                                                  player->teleport_pos_delta -= old_carried_pos_delta;
+                                                  player->teleport_pos_delta += new_carried_pos_delta;
+                                             }else{
+                                                  player->pos_delta -= old_carried_pos_delta;
+                                                  player->pos_delta += new_carried_pos_delta;
+                                             }
 
-                                        for(S16 p = 0; p < world.players.count; p++){
-                                             if(i == p) continue;
+                                             for(S16 p = 0; p < world.players.count; p++){
+                                                  if(i == p) continue;
 
-                                             auto tmp_player = world.players.elements + p;
-                                             auto relative_rotation = direction_rotations_between((Direction_t)(player->rotation), (Direction_t)(tmp_player->rotation));
-                                             auto local_pos_delta = vec_rotate_quadrants_clockwise(rotated_pos_delta, relative_rotation);
-                                             old_carried_pos_delta = tmp_player->carried_pos_delta.positive + tmp_player->carried_pos_delta.negative;
+                                                  auto tmp_player = world.players.elements + p;
+                                                  auto relative_rotation = direction_rotations_between((Direction_t)(player->rotation), (Direction_t)(tmp_player->rotation));
+                                                  auto local_pos_delta = vec_rotate_quadrants_clockwise(rotated_pos_delta, relative_rotation);
+                                                  old_carried_pos_delta = tmp_player->carried_pos_delta.positive + tmp_player->carried_pos_delta.negative;
 
-                                             get_carried_noob(&tmp_player->carried_pos_delta, local_pos_delta, block_index, true);
+                                                  get_carried_noob(&tmp_player->carried_pos_delta, local_pos_delta, block_index, true);
 
-                                             new_carried_pos_delta = tmp_player->carried_pos_delta.positive + tmp_player->carried_pos_delta.negative;
+                                                  new_carried_pos_delta = tmp_player->carried_pos_delta.positive + tmp_player->carried_pos_delta.negative;
 
-                                             if(tmp_player->teleport){
-                                                  tmp_player->teleport_pos_delta -= old_carried_pos_delta;
-                                                  tmp_player->teleport_pos_delta += new_carried_pos_delta;
-                                             }else{
-                                                  tmp_player->pos_delta -= old_carried_pos_delta;
-                                                  tmp_player->pos_delta += new_carried_pos_delta;
+                                                  if(tmp_player->teleport){
+                                                       tmp_player->teleport_pos_delta -= old_carried_pos_delta;
+                                                       tmp_player->teleport_pos_delta += new_carried_pos_delta;
+                                                  }else{
+                                                       tmp_player->pos_delta -= old_carried_pos_delta;
+                                                       tmp_player->pos_delta += new_carried_pos_delta;
+                                                  }
                                              }
-                                        }
 
-                                        repeat_collision_pass = true;
+                                             repeat_collision_pass = true;
+                                        }
                                    }
                               }
                          }
-                    }
 
-                    // based on changing pos_deltas, determine if we are teleporting
-                    for(S16 i = 0; i < update_player_count; i++){
-                         auto player = world.players.elements + i;
+                         // based on changing pos_deltas, determine if we are teleporting
+                         for(S16 i = 0; i < update_player_count; i++){
+                              auto player = world.players.elements + i;
 
-                         auto player_pos = player->pos;
-                         auto player_pos_delta = player->pos_delta;
+                              auto player_pos = player->pos;
+                              auto player_pos_delta = player->pos_delta;
 
-                         if(player->teleport){
-                              player_pos = player->teleport_pos;
-                              player_pos_delta = player->teleport_pos_delta;
-                         }
+                              if(player->teleport){
+                                   player_pos = player->teleport_pos;
+                                   player_pos_delta = player->teleport_pos_delta;
+                              }
 
-                         auto player_prev_coord = pos_to_coord(player_pos);
-                         auto player_cur_coord = pos_to_coord(player_pos + player_pos_delta);
-
-                         // if the player has teleported, but stays in the portal coord, undo the teleport and shorten
-                         // the pos_delta based on the collision that happened after teleporting
-                         if(player->teleport && player_prev_coord == player_cur_coord){
-                              player->teleport = false;
-                              auto unrotated_pos_delta = vec_rotate_quadrants_counter_clockwise(player->teleport_pos_delta, player->teleport_rotation);
-                              player->pos_delta = unrotated_pos_delta;
-                              player_pos = player->pos;
-                              player_pos_delta = player->pos_delta;
-                              player_prev_coord = pos_to_coord(player_pos);
-                              player_cur_coord = pos_to_coord(player_pos + player_pos_delta);
-                         }
+                              auto player_prev_coord = pos_to_coord(player_pos);
+                              auto player_cur_coord = pos_to_coord(player_pos + player_pos_delta);
+
+                              // if the player has teleported, but stays in the portal coord, undo the teleport and shorten
+                              // the pos_delta based on the collision that happened after teleporting
+                              if(player->teleport && player_prev_coord == player_cur_coord){
+                                   player->teleport = false;
+                                   auto unrotated_pos_delta = vec_rotate_quadrants_counter_clockwise(player->teleport_pos_delta, player->teleport_rotation);
+                                   player->pos_delta = unrotated_pos_delta;
+                                   player_pos = player->pos;
+                                   player_pos_delta = player->pos_delta;
+                                   player_prev_coord = pos_to_coord(player_pos);
+                                   player_cur_coord = pos_to_coord(player_pos + player_pos_delta);
+                              }
 
-                         // teleport position
-                         auto teleport_result = teleport_position_across_portal(player_pos, player_pos_delta, &world,
-                                                                                player_prev_coord, player_cur_coord);
-                         auto teleport_clone_id = player->clone_id;
-                         if(player_cur_coord != player->clone_start){
-                              // if we are going back to our clone portal, then all clones should go back
-
-                              // find the index closest to our original clone portal
-                              F32 shortest_distance = FLT_MAX;
-                              auto clone_start_center = coord_to_pixel_at_center(player->clone_start);
-
-                              for(S8 t = 0; t < teleport_result.count; t++){
-                                   F32 distance = pixel_distance_between(clone_start_center, teleport_result.results[t].pos.pixel);
-                                   if(distance < shortest_distance){
-                                        shortest_distance = distance;
-                                        teleport_clone_id = t;
+                              // teleport position
+                              auto teleport_result = teleport_position_across_portal(player_pos, player_pos_delta, &world,
+                                                                                     player_prev_coord, player_cur_coord);
+                              auto teleport_clone_id = player->clone_id;
+                              if(player_cur_coord != player->clone_start){
+                                   // if we are going back to our clone portal, then all clones should go back
+
+                                   // find the index closest to our original clone portal
+                                   F32 shortest_distance = FLT_MAX;
+                                   auto clone_start_center = coord_to_pixel_at_center(player->clone_start);
+
+                                   for(S8 t = 0; t < teleport_result.count; t++){
+                                        F32 distance = pixel_distance_between(clone_start_center, teleport_result.results[t].pos.pixel);
+                                        if(distance < shortest_distance){
+                                             shortest_distance = distance;
+                                             teleport_clone_id = t;
+                                        }
                                    }
                               }
+
+                              // if a teleport happened, update the position
+                              if(teleport_result.count){
+                                   assert(teleport_result.count > teleport_clone_id);
+                                   add_global_tag(TAG_TELEPORT_PLAYER);
+
+                                   player->teleport = true;
+                                   player->teleport_pos = teleport_result.results[teleport_clone_id].pos;
+                                   player->teleport_pos_delta = teleport_result.results[teleport_clone_id].delta;
+                                   player->teleport_vel = vec_rotate_quadrants_clockwise(player->vel, teleport_result.results[teleport_clone_id].rotations);
+                                   player->teleport_accel = vec_rotate_quadrants_clockwise(player->accel, teleport_result.results[teleport_clone_id].rotations);
+                                   player->teleport_rotation = teleport_result.results[teleport_clone_id].rotations;
+                                   player->teleport_face = direction_rotate_clockwise(player->face, teleport_result.results[teleport_clone_id].rotations);
+                                   player->teleport_pushing_block = player->pushing_block;
+                                   player->teleport_pushing_block_rotation = 0;
+                                   player->teleport_pushing_block_dir = player->pushing_block_dir;
+
+                                   repeat_collision_pass = true;
+                              }
                          }
 
-                         // if a teleport happened, update the position
-                         if(teleport_result.count){
-                              assert(teleport_result.count > teleport_clone_id);
-                              add_global_tag(TAG_TELEPORT_PLAYER);
-
-                              player->teleport = true;
-                              player->teleport_pos = teleport_result.results[teleport_clone_id].pos;
-                              player->teleport_pos_delta = teleport_result.results[teleport_clone_id].delta;
-                              player->teleport_vel = vec_rotate_quadrants_clockwise(player->vel, teleport_result.results[teleport_clone_id].rotations);
-                              player->teleport_accel = vec_rotate_quadrants_clockwise(player->accel, teleport_result.results[teleport_clone_id].rotations);
-                              player->teleport_rotation = teleport_result.results[teleport_clone_id].rotations;
-                              player->teleport_face = direction_rotate_clockwise(player->face, teleport_result.results[teleport_clone_id].rotations);
-                              player->teleport_pushing_block = player->pushing_block;
-                              player->teleport_pushing_block_rotation = 0;
-                              player->teleport_pushing_block_dir = player->pushing_block_dir;
+                         island_collision_attempts++;
 
+                         // blocks that woke up during the pass are in no island, so start over with all awake blocks in one
+                         if(collision_islands.fall_back_if_blocks_woke(&world)){
+                              island_index = 0;
+                              update_blocks_count = collision_islands.block_count(&world, island_index);
                               repeat_collision_pass = true;
+                              if(island_collision_attempts > collision_attempts) collision_attempts = island_collision_attempts;
+                              island_collision_attempts = 1;
                          }
                     }
 
-                    collision_attempts++;
+                    if(island_collision_attempts > collision_attempts) collision_attempts = island_collision_attempts;
                }
 
                collision_results.clear();
 
+               // positions are settled until they are finalized, so the entangled push generation and the push pass can
+               // share block queries
+               world_begin_block_query_cache(&world);
+
                // If the final block in an ice chain, is entangled then create entangled pushes for it
                S16 original_all_block_pushes_count = momentum_block_pushes.count;
                for(S16 i = 0; i < original_all_block_pushes_count; i++){
@@ -5247,7 +5326,7 @@ int main(int argc, char** argv){
                     momentum_block_pushes.merge(&entangled_momentum_block_pushes);
 
                     // continue generating entangled pushes until we get them all
-                    BlockMomentumPushes_t<128> new_entangled_momentum_block_pushes;
+                    BlockMomentumPushes_t new_entangled_momentum_block_pushes;
                     S16 new_entangle_pushes = 0;
                     do{
                          generate_entangled_block_pushes(&entangled_momentum_block_pushes, &new_entangled_momentum_block_pushes, &world);
@@ -5282,7 +5361,8 @@ int main(int argc, char** argv){
                          auto& block_push = consolidated_momentum_block_pushes.pushes[i];
                          if(block_push.invalidated) continue;
 
-                         auto result = block_collision_push(&block_push, &world);
+                         BlockCollisionPushResult_t result;
+                         block_collision_push(&block_push, &world, &result);
                          block_push.executed = true;
 
                          // some post processing for each push
@@ -5352,8 +5432,12 @@ int main(int argc, char** argv){
                          }
                     }
 
+                    // the push pass may have woken blocks at the far end of a chain
+                    world_sort_awake_blocks(&world);
+
                     // update each block's velocities based on the momentum they've received this frame
-                    for(S16 i = 0; i < world.blocks.count; i++){
+                    for(S16 awake_index = 0; awake_index < world_awake_block_count(&world); awake_index++){
+                         S16 i = world_awake_block_index(&world, awake_index);
                          auto* block = world.blocks.elements + i;
                          if(block->horizontal_momentum == BLOCK_MOMENTUM_SUM){
                               S16 mass = get_block_stack_mass(&world, block);
@@ -5413,6 +5497,8 @@ int main(int argc, char** argv){
                               block->vertical_move.time_left = 0;
                          }
                     }
+
+                    world_end_block_query_cache(&world);
                }
 
                // finalize positions
@@ -5490,13 +5576,14 @@ int main(int argc, char** argv){
                }
 
                // calculate stop_on_pixels for blocks carrying other blocks
-               for(S16 i = 0; i < world.blocks.count; i++){
+               for(S16 awake_index = 0; awake_index < world_awake_block_count(&world); awake_index++){
+                    S16 i = world_awake_block_index(&world, awake_index);
                     Block_t* block = world.blocks.elements + i;
 
-                    auto result = block_held_up_by_another_block(block, world.block_qt, world.interactive_qt, &world.tilemap,
+                    auto result = block_held_up_by_another_block(block, world.block_qt, &world.blocks, world.interactive_qt, &world.tilemap,
                                                                  BLOCK_FRICTION_AREA);
                     for(S16 b = 0; b < result.count; b++){
-                         auto holder = result.blocks_held[b].block;
+                         auto holder = block_from_handle(&world.blocks, result.blocks_held[b].block);
 
                          if(block->stop_on_pixel_x == 0 && holder->stop_on_pixel_x != 0){
                               Position_t diff = block->pos - holder->pos;
@@ -5512,7 +5599,8 @@ int main(int argc, char** argv){
                     }
                }
 
-               for(S16 i = 0; i < world.blocks.count; i++){
+               for(S16 awake_index = 0; awake_index < world_awake_block_count(&world); awake_index++){
+                    S16 i = world_awake_block_index(&world, awake_index);
                     Block_t* block = world.blocks.elements + i;
 
                     Position_t final_pos;
@@ -5573,6 +5661,10 @@ int main(int argc, char** argv){
                }
 
                // have player push block
+               world_begin_block_query_cache(&world);
+
+               FrameArray_t<PlayerBlockPush_t> player_block_pushes;
+               FrameArray_t<PlayerBlockPush_t*> ordered_player_block_pushes;
                for(S16 i = 0; i < world.players.count; i++){
                     auto player = world.players.elements + i;
                     if(player->prev_pushing_block >= 0 && player->prev_pushing_block == player->pushing_block){
@@ -5626,12 +5718,12 @@ int main(int argc, char** argv){
 
                                    auto allowed_result = allowed_to_push(&world, block_to_push, push_block_dir);
                                    if(allowed_result.push){
-                                        if(!resize(&player_block_pushes, player_block_pushes.count + 1)){
+                                        if(!player_block_pushes.resize(player_block_pushes.count + 1)){
                                              LOG("%d: Ran out of memory trying to do player %d block pushes...\n", __LINE__, player_block_pushes.count + 1);
                                         }else{
                                              S16 entangled_push_index = (player_block_pushes.count - 1);
 
-                                             auto* player_block_push = player_block_pushes.elements + entangled_push_index;
+                                             auto* player_block_push = player_block_pushes.objects + entangled_push_index;
                                              player_block_push->performed = false;
                                              player_block_push->entangled_push_index = -1;
                                              player_block_push->player_index = i;
@@ -5656,7 +5748,7 @@ int main(int argc, char** argv){
                     // if(player_block_pushes.count > 0){
                     //      LOG("%d player block pushes on frame %ld\n", player_block_pushes.count, frame_count);
                     //      for(S16 i = 0; i < player_block_pushes.count; i++){
-                    //           auto* player_block_push = player_block_pushes.elements + i;
+                    //           auto* player_block_push = player_block_pushes.objects + i;
                     //           LOG("  player: %d, block: %d, dir: %s, entangled: %d, force: %f\n", player_block_push->player_index,
                     //               player_block_push->block_index, direction_to_string(player_block_push->direction),
                     //               player_block_push->is_entangled(), player_block_push->allowed_to_push.mass_ratio);
@@ -5664,8 +5756,9 @@ int main(int argc, char** argv){
                     // }
 
                     // build a list of ordered block pushes based on dependencies
+                    FrameArray_t<RestoreBlock_t> restore_blocks;
                     for(S16 i = 0; i < player_block_pushes.count; i++){
-                         auto* player_block_push = player_block_pushes.elements + i;
+                         auto* player_block_push = player_block_pushes.objects + i;
                          if (player_block_push->is_entangled()){
                               if(player_block_push_add_ordered_entangled_reqs(player_block_push, &player_block_pushes, &world, &ordered_player_block_pushes, &restore_blocks)){
                                    player_block_push_add_ordered_physical_reqs(player_block_push, &player_block_pushes, &world, &ordered_player_block_pushes, &restore_blocks);
@@ -5676,19 +5769,19 @@ int main(int argc, char** argv){
 
                          // restore the blocks we messed up to detect dependencies
                          for(S16 b = 0; b < restore_blocks.count; b++){
-                              auto* restore_block = restore_blocks.elements + b;
+                              auto* restore_block = restore_blocks.objects + b;
                               auto* block = world.blocks.elements + restore_block->index;
                               *block = restore_block->block;
                          }
 
-                         destroy(&restore_blocks);
+                         restore_blocks.clear();
                     }
 
                     // for debugging
                     // if(player_block_pushes.count > 0){
                     //      LOG("%d ordered player block pushes on frame %ld\n", ordered_player_block_pushes.count, frame_count);
                     //      for(S16 i = 0; i < ordered_player_block_pushes.count; i++){
-                    //           auto* player_block_push = ordered_player_block_pushes.elements[i];
+                    //           auto* player_block_push = ordered_player_block_pushes.objects[i];
                     //           LOG("  player: %d, block: %d, dir: %s, entangled: %d, force: %f\n", player_block_push->player_index,
                     //               player_block_push->block_index, direction_to_string(player_block_push->direction),
                     //               player_block_push->is_entangled(), player_block_push->allowed_to_push.mass_ratio);
@@ -5696,7 +5789,7 @@ int main(int argc, char** argv){
                     // }
 
                     for(S16 i = 0; i < ordered_player_block_pushes.count; i++){
-                         auto* player_block_push = ordered_player_block_pushes.elements[i];
+                         auto* player_block_push = ordered_player_block_pushes.objects[i];
                          if(player_block_push->performed) continue;
 
                          Player_t* player = nullptr;
@@ -5725,10 +5818,10 @@ int main(int argc, char** argv){
                          if(block_to_push->pos.z > 0) player->push_time = -0.5f;
                     }
 
-                    destroy(&player_block_pushes);
-                    destroy(&ordered_player_block_pushes);
                }
 
+               world_end_block_query_cache(&world);
+
                // update interactive pressure plates
                for(S16 i = 0; i < world.interactives.count; i++){
                     Interactive_t* interactive = world.interactives.elements + i;
@@ -5836,6 +5929,8 @@ int main(int argc, char** argv){
                     update_light_and_ice_detectors(world.interactives.elements + i, &world);
                }
 
+               world_settle_blocks(&world);
+
                if(fade_state != FADE_STATE_NONE){
                     fade_timer += dt;
                     if(fade_timer >= fade_time){
@@ -5875,10 +5970,11 @@ int main(int argc, char** argv){
                                                   auto* tile = tilemap_get_tile(&temporary_world.tilemap, coord);
                                                   if(tile){
                                                        if(tile->flags & TILE_FLAG_RESET_IMMUNE) continue;
-                                                       world.tilemap.tiles[j][i] = *tile;
+                                                       *tilemap_tile(&world.tilemap, i, j) = *tile;
                                                   }
                                              }
                                         }
+                                        tilemap_build_flag_planes(&world.tilemap);
 
                                         for(S16 i = 0; i < temporary_world.interactives.count; i++){
                                              auto* temporary_interactive = temporary_world.interactives.elements + i;
@@ -5976,9 +6072,48 @@ int main(int argc, char** argv){
                     fade_timer -= dt;
                     if(fade_timer <= 0) fade_timer = 0;
                }
+
+               if(record_demo.mode == DEMO_MODE_RECORD){
+                    demo_record_checksum(&record_demo, &world, frame_count);
+               }
+
+               if(play_demo.mode == DEMO_MODE_PLAY){
+                    demo_verify_checksum(&play_demo, &world, frame_count);
+               }
           }
 
-          if((suite && !show_suite) || play_demo.seek_frame >= 0) continue;
+          if(solve){
+               switch(solver_frame_end(&solver, &world, &player_action, fade_state == FADE_STATE_EXITTING)){
+               default:
+                    break;
+               case SOLVER_STATUS_RESTORED:
+                    fade_state = FADE_STATE_NONE;
+                    fade_timer = 0;
+                    break;
+               case SOLVER_STATUS_RECORD:
+                    fade_state = FADE_STATE_NONE;
+                    fade_timer = 0;
+                    record_demo.filepath = solver.solution_filepath;
+                    record_demo.mode = DEMO_MODE_RECORD;
+                    if(!demo_begin(&record_demo)){
+                         return 1;
+                    }
+                    frame_count = 0;
+                    break;
+               case SOLVER_STATUS_SOLVED:
+                    quit = true;
+                    break;
+               case SOLVER_STATUS_FAILED:
+                    solve_failed = true;
+                    quit = true;
+                    break;
+               }
+          }
+
+          if(bench) demo_bench_frame_end(&demo_bench);
+
+          if(headless || play_demo.seek_frame >= 0) continue;
+          if(demo_turbo_step_again(&turbo, play_demo.dt_scalar, play_demo.paused)) continue;
 
           update_camera(&camera, &world, current_room_index);
 
@@ -5991,7 +6126,7 @@ int main(int argc, char** argv){
 
                     bool already_tinted = false;
                     for(S16 t = 0; t < entangle_tints.block_to_tint_index.count; t++){
-                         auto* converter = entangle_tints.block_to_tint_index.elements + t;
+                         auto* converter = entangle_tints.block_to_tint_index.objects + t;
                          if(block == converter->block){
                               already_tinted = true;
                               break;
@@ -6009,11 +6144,11 @@ int main(int argc, char** argv){
                     }
 
                     // resize convert to account for all entanglers
-                    if(!resize(&entangle_tints.block_to_tint_index, entangle_tints.block_to_tint_index.count + entangler_count)){
+                    if(!entangle_tints.block_to_tint_index.resize(entangle_tints.block_to_tint_index.count + entangler_count)){
                          LOG("failed to allocate memory for %d entangle tints\n", entangle_tints.block_to_tint_index.count + entangler_count);
                          break;
                     }
-                    auto* new_converter = entangle_tints.block_to_tint_index.elements + (entangle_tints.block_to_tint_index.count - 1);
+                    auto* new_converter = entangle_tints.block_to_tint_index.objects + (entangle_tints.block_to_tint_index.count - 1);
                     new_converter->block = block;
                     new_converter->index = tint_index;
 
@@ -6022,7 +6157,7 @@ int main(int argc, char** argv){
                     while(entangle_index != i && entangle_index >= 0){
                          auto* entangled_block = world.blocks.elements + entangle_index;
 
-                         new_converter = entangle_tints.block_to_tint_index.elements + (entangle_tints.block_to_tint_index.count - entangler_itr);
+                         new_converter = entangle_tints.block_to_tint_index.objects + (entangle_tints.block_to_tint_index.count - entangler_itr);
                          new_converter->block = entangled_block;
                          new_converter->index = tint_index;
 
@@ -6329,7 +6464,7 @@ int main(int argc, char** argv){
                for(S16 y = min.y; y <= max.y; y++){
                     for(S16 x = min.x; x <= max.x; x++){
                          Coord_t coord {x, y};
-                         Tile_t* tile = world.tilemap.tiles[y] + x;
+                         Tile_t* tile = tilemap_tile(&world.tilemap, x, y);
 
                          F32 light_value = (F32)(light_range - (256 - tile->light)) / (F32)(light_range);
                          if(light_value <= 0) continue;
@@ -6458,16 +6593,26 @@ int main(int argc, char** argv){
                     glEnd();
                }
 
+               thumbnail_cache_update(&thumbnail_cache, &map_thumbnails, map_scroll);
+
                for(S16 m = 0; m < map_thumbnails.count; m++){
                     auto* map_thumbnail = map_thumbnails.elements + m;
 
-                    if(map_thumbnail->texture == 0) continue;
+                    if(!thumbnail_in_view(map_thumbnail, map_scroll)) continue;
+
+                    if(map_thumbnail->texture_state == THUMBNAIL_TEXTURE_STATE_NONE){
+                         thumbnail_cache_request(&thumbnail_cache, map_thumbnail, m);
+                    }
 
                     Vec_t pos = map_thumbnail->pos + map_scroll;
                     Vec_t bounds = pos + Vec_t{THUMBNAIL_UI_DIMENSION, THUMBNAIL_UI_DIMENSION};
 
                     if(pos.y < 0 || pos.y > 1.0f ) continue;
 
+                    if(map_thumbnail->texture == 0) continue;
+
+                    map_thumbnail->texture_last_used_frame = thumbnail_cache.frame;
+
                     glBindTexture(GL_TEXTURE_2D, map_thumbnail->texture);
                     glBegin(GL_QUADS);
                     glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
@@ -6688,10 +6833,9 @@ int main(int argc, char** argv){
           glEnd();
 
           SDL_GL_SwapWindow(window);
+          demo_turbo_frame_end(&turbo);
 
           glBindFramebuffer(GL_FRAMEBUFFER, render_framebuffer);
-
-          destroy(&entangle_tints.block_to_tint_index);
      }
 
      if(saving){
@@ -6703,7 +6847,7 @@ int main(int argc, char** argv){
      }
 
      if(record_demo.mode == DEMO_MODE_RECORD){
-          player_action_perform(&player_action, &world.players, PLAYER_ACTION_TYPE_END_DEMO, record_demo.mode, record_demo.file, frame_count);
+          player_action_perform(&player_action, &world.players, PLAYER_ACTION_TYPE_END_DEMO, &record_demo, frame_count);
 
           // save map and player position
           save_map_to_file(record_demo.file, player_start, &world.tilemap, &world.blocks, &world.interactives,
@@ -6716,6 +6860,8 @@ int main(int argc, char** argv){
                fwrite(&world.players.elements->pos.pixel, sizeof(world.players.elements->pos.pixel), 1, record_demo.file);
                break;
           case 2:
+          case 3:
+          case 4:
           {
                fwrite(&world.players.count, sizeof(world.players.count), 1, record_demo.file);
                for(S16 p = 0; p < world.players.count; p++){
@@ -6731,12 +6877,18 @@ int main(int argc, char** argv){
      quad_tree_free(world.block_qt);
 
      destroy(&world.blocks);
+     destroy(&world.awake_blocks);
+     destroy(&world.interactive_wake_states);
+     collision_islands.clear();
+     frame_arena_destroy();
      destroy(&world.interactives);
      destroy(&undo);
      destroy(&world.tilemap);
      destroy(&editor);
 
-     if(!suite){
+     if(!suite && !solve){
+          thumbnail_cache_destroy(&thumbnail_cache, &map_thumbnails);
+
           glDeleteTextures(1, &theme_texture);
           glDeleteTextures(1, &floor_texture);
           glDeleteTextures(1, &solids_texture);
@@ -6755,7 +6907,9 @@ int main(int argc, char** argv){
      }
 
      free(current_map_filepath);
+     destroy(&demo_starting_world);
+     destroy(&solver);
 
      Log_t::destroy();
-     return 0;
+     return solve_failed ? 1 : 0;
 }
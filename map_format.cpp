@@ -1,4 +1,5 @@
 #include "map_format.h"
+#include "map_index.h"
 #include "defines.h"
 
 // only here for tag generation
@@ -207,9 +208,9 @@ bool save_map_to_file(FILE* file, Coord_t player_start, const TileMap_t* tilemap
      S32 index = 0;
      for(S32 y = 0; y < tilemap->height; y++){
           for(S32 x = 0; x < tilemap->width; x++){
-               map_tiles[index].id = tilemap->tiles[y][x].id;
-               map_tiles[index].flags = tilemap->tiles[y][x].flags;
-               map_tiles[index].rotation = tilemap->tiles[y][x].rotation;
+               map_tiles[index].id = tilemap_tile(tilemap, x, y)->id;
+               map_tiles[index].flags = tilemap_tile(tilemap, x, y)->flags;
+               map_tiles[index].rotation = tilemap_tile(tilemap, x, y)->rotation;
                index++;
           }
      }
@@ -223,15 +224,40 @@ bool save_map_to_file(FILE* file, Coord_t player_start, const TileMap_t* tilemap
           build_map_interactive_from_interactive(map_interactives + i, interactive_array->elements + i);
      }
 
-     U8 map_version = MAP_VERSION;
-     fwrite(&map_version, sizeof(map_version), 1, file);
-     fwrite(&player_start, sizeof(player_start), 1, file);
-     fwrite(&tilemap->width, sizeof(tilemap->width), 1, file);
-     fwrite(&tilemap->height, sizeof(tilemap->height), 1, file);
-     fwrite(&block_array->count, sizeof(block_array->count), 1, file);
-     fwrite(&interactive_array->count, sizeof(interactive_array->count), 1, file);
-     fwrite(&room_array->count, sizeof(room_array->count), 1, file);
-     fwrite(&exit_array->count, sizeof(exit_array->count), 1, file);
+     U16 tags_count = 0;
+     if(tags){
+          for(U16 t = 0; t < TAG_COUNT; t++){
+               if(tags[t]) tags_count++;
+          }
+     }
+
+     MapHeaderV1_t header = {};
+     header.version = MAP_VERSION;
+     header.player_start = player_start;
+     header.width = tilemap->width;
+     header.height = tilemap->height;
+     header.block_count = block_array->count;
+     header.interactive_count = interactive_array->count;
+     header.room_count = room_array->count;
+     header.exit_count = exit_array->count;
+
+     header.sections[MAP_SECTION_TILES].size = sizeof(*map_tiles) * (U64)(map_tile_count);
+     header.sections[MAP_SECTION_BLOCKS].size = sizeof(*map_blocks) * (U64)(block_array->count);
+     header.sections[MAP_SECTION_INTERACTIVES].size = sizeof(*map_interactives) * (U64)(interactive_array->count);
+     header.sections[MAP_SECTION_ROOMS].size = sizeof(*room_array->elements) * (U64)(room_array->count);
+     for(S16 i = 0; i < exit_array->count; i++){
+          header.sections[MAP_SECTION_EXITS].size += exit_serialized_size(exit_array->elements + i);
+     }
+     header.sections[MAP_SECTION_THUMBNAIL].size = thumbnail ? thumbnail->byte_count : 0;
+     header.sections[MAP_SECTION_TAGS].size = sizeof(U16) * tags_count;
+
+     U64 section_offset = sizeof(header);
+     for(S8 i = 0; i < MAP_SECTION_COUNT; i++){
+          header.sections[i].offset = section_offset;
+          section_offset += header.sections[i].size;
+     }
+
+     fwrite(&header, sizeof(header), 1, file);
      fwrite(map_tiles, sizeof(*map_tiles), (size_t)(map_tile_count), file);
      fwrite(map_blocks, sizeof(*map_blocks), (size_t)(block_array->count), file);
      fwrite(map_interactives, sizeof(*map_interactives), (size_t)(interactive_array->count), file);
@@ -243,25 +269,13 @@ bool save_map_to_file(FILE* file, Coord_t player_start, const TileMap_t* tilemap
      }
 
      if(thumbnail){
-          fwrite(&thumbnail->byte_count, sizeof(thumbnail->byte_count), 1, file);
           fwrite(thumbnail->bytes, thumbnail->byte_count, 1, file);
-     }else{
-          U64 thumbnail_size = 0;
-          fwrite(&thumbnail_size, sizeof(thumbnail_size), 1, file);
      }
 
-     U16 tags_count = 0;
-
      if(tags){
-          for(U16 t = 0; t < TAG_COUNT; t++){
-               if(tags[t]) tags_count++;
-          }
-          fwrite(&tags_count, sizeof(tags_count), 1, file);
           for(U16 t = 0; t < TAG_COUNT; t++){
                if(tags[t]) fwrite(&t, sizeof(t), 1, file);
           }
-     }else{
-          fwrite(&tags_count, sizeof(tags_count), 1, file);
      }
 
      free(map_tiles);
@@ -285,6 +299,7 @@ bool save_map(const char* filepath, Coord_t player_start, const TileMap_t* tilem
      LOG("saved map %s %s thumbnail and %stags\n", filepath, thumbnail == nullptr ? "without" : "with",
          tags == nullptr ? "no " : "");
      fclose(f);
+     if(success) map_index_update_map(filepath);
      return success;
 }
 
@@ -348,7 +363,7 @@ bool load_map_from_file_v4(FILE* file, Coord_t* player_start, TileMap_t* tilemap
      S32 index = 0;
      for(S32 y = 0; y < tilemap->height; y++){
           for(S32 x = 0; x < tilemap->width; x++){
-               auto* tile = tilemap->tiles[y] + x;
+               auto* tile = tilemap_tile(tilemap, x, y);
                tile->flags = map_tiles[index].flags;
                if(map_tiles[index].id >= OLD_TILE_ID_SOLID_START){
                     tile->flags |= TILE_FLAG_SOLID;
@@ -362,6 +377,8 @@ bool load_map_from_file_v4(FILE* file, Coord_t* player_start, TileMap_t* tilemap
           }
      }
 
+     tilemap_build_flag_planes(tilemap);
+
      // TODO: a lot of maps have -16, -16 as the first block
      for(S16 i = 0; i < block_count; i++){
           Block_t* block = block_array->elements + i;
@@ -489,7 +506,7 @@ bool load_map_from_file_v6(FILE* file, Coord_t* player_start, TileMap_t* tilemap
      S32 index = 0;
      for(S32 y = 0; y < tilemap->height; y++){
           for(S32 x = 0; x < tilemap->width; x++){
-               auto* tile = tilemap->tiles[y] + x;
+               auto* tile = tilemap_tile(tilemap, x, y);
                tile->flags = map_tiles[index].flags;
                if(map_tiles[index].id >= OLD_TILE_ID_SOLID_START){
                     tile->flags |= TILE_FLAG_SOLID;
@@ -503,6 +520,8 @@ bool load_map_from_file_v6(FILE* file, Coord_t* player_start, TileMap_t* tilemap
           }
      }
 
+     tilemap_build_flag_planes(tilemap);
+
      // TODO: a lot of maps have -16, -16 as the first block
      for(S16 i = 0; i < block_count; i++){
           Block_t* block = block_array->elements + i;
@@ -630,7 +649,7 @@ bool load_map_from_file_v7(FILE* file, Coord_t* player_start, TileMap_t* tilemap
      S32 index = 0;
      for(S32 y = 0; y < tilemap->height; y++){
           for(S32 x = 0; x < tilemap->width; x++){
-               auto* tile = tilemap->tiles[y] + x;
+               auto* tile = tilemap_tile(tilemap, x, y);
                tile->flags = map_tiles[index].flags;
                if(map_tiles[index].id >= OLD_TILE_ID_SOLID_START){
                     tile->flags |= TILE_FLAG_SOLID;
@@ -644,6 +663,8 @@ bool load_map_from_file_v7(FILE* file, Coord_t* player_start, TileMap_t* tilemap
           }
      }
 
+     tilemap_build_flag_planes(tilemap);
+
      // TODO: a lot of maps have -16, -16 as the first block
      for(S16 i = 0; i < block_count; i++){
           Block_t* block = block_array->elements + i;
@@ -779,14 +800,16 @@ bool load_map_from_file_v8(FILE* file, Coord_t* player_start, TileMap_t* tilemap
      S32 index = 0;
      for(S32 y = 0; y < tilemap->height; y++){
           for(S32 x = 0; x < tilemap->width; x++){
-               tilemap->tiles[y][x].id = map_tiles[index].id;
-               tilemap->tiles[y][x].flags = map_tiles[index].flags;
-               tilemap->tiles[y][x].light = BASE_LIGHT;
-               tilemap->tiles[y][x].rotation = map_tiles[index].rotation;
+               tilemap_tile(tilemap, x, y)->id = map_tiles[index].id;
+               tilemap_tile(tilemap, x, y)->flags = map_tiles[index].flags;
+               tilemap_tile(tilemap, x, y)->light = BASE_LIGHT;
+               tilemap_tile(tilemap, x, y)->rotation = map_tiles[index].rotation;
                index++;
           }
      }
 
+     tilemap_build_flag_planes(tilemap);
+
      // TODO: a lot of maps have -16, -16 as the first block
      for(S16 i = 0; i < block_count; i++){
           Block_t* block = block_array->elements + i;
@@ -934,14 +957,16 @@ bool load_map_from_file_v9(FILE* file, Coord_t* player_start, TileMap_t* tilemap
      S32 index = 0;
      for(S32 y = 0; y < tilemap->height; y++){
           for(S32 x = 0; x < tilemap->width; x++){
-               tilemap->tiles[y][x].id = map_tiles[index].id;
-               tilemap->tiles[y][x].flags = map_tiles[index].flags;
-               tilemap->tiles[y][x].light = BASE_LIGHT;
-               tilemap->tiles[y][x].rotation = map_tiles[index].rotation;
+               tilemap_tile(tilemap, x, y)->id = map_tiles[index].id;
+               tilemap_tile(tilemap, x, y)->flags = map_tiles[index].flags;
+               tilemap_tile(tilemap, x, y)->light = BASE_LIGHT;
+               tilemap_tile(tilemap, x, y)->rotation = map_tiles[index].rotation;
                index++;
           }
      }
 
+     tilemap_build_flag_planes(tilemap);
+
      // TODO: a lot of maps have -16, -16 as the first block
      for(S16 i = 0; i < block_count; i++){
           Block_t* block = block_array->elements + i;
@@ -1013,43 +1038,11 @@ bool load_map_from_file_v9(FILE* file, Coord_t* player_start, TileMap_t* tilemap
      return true;
 }
 
-bool load_map_from_file(FILE* file, Coord_t* player_start, TileMap_t* tilemap, ObjectArray_t<Block_t>* block_array,
-                        ObjectArray_t<Interactive_t>* interactive_array, ObjectArray_t<Rect_t>* room_array,
-                        ObjectArray_t<Exit_t>* exit_array, const char* filepath){
-     U8 map_version = 0;
-     fread(&map_version, sizeof(map_version), 1, file);
-     bool result = false;
-     switch(map_version){
-     default:
-          LOG("%s(): mismatched version loading '%s', actual %d, expected %d\n", __FUNCTION__, filepath, map_version, MAP_VERSION);
-          break;
-     case 1:
-     case 2:
-     case 3:
-          LOG("%s(): deprecated version %d, use git to find the code to load this map if ya really want bro\n",
-              __FUNCTION__, map_version);
-          break;
-     case 4:
-     case 5:
-          result = load_map_from_file_v4(file, player_start, tilemap, block_array, interactive_array);
-          break;
-     case 6:
-          result = load_map_from_file_v6(file, player_start, tilemap, block_array, interactive_array);
-          break;
-     case 7:
-          result = load_map_from_file_v7(file, player_start, tilemap, block_array, interactive_array);
-          break;
-     case 8:
-          result = load_map_from_file_v8(file, player_start, tilemap, block_array, interactive_array, room_array);
-          break;
-     case 9:
-          result = load_map_from_file_v9(file, player_start, tilemap, block_array, interactive_array, room_array, exit_array);
-          break;
-     }
-
+static void add_global_tags_for_map(TileMap_t* tilemap, ObjectArray_t<Block_t>* block_array,
+                                    ObjectArray_t<Interactive_t>* interactive_array){
      for(S16 y = 0; y < tilemap->height; y++){
           for(S16 x = 0; x < tilemap->width; x++){
-               Tile_t* tile = tilemap->tiles[y] + x;
+               Tile_t* tile = tilemap_tile(tilemap, x, y);
                if(tile->flags & TILE_FLAG_ICED) add_global_tag(TAG_ICE);
           }
      }
@@ -1093,7 +1086,7 @@ bool load_map_from_file(FILE* file, Coord_t* player_start, TileMap_t* tilemap, O
                     add_global_tag(TAG_THREE_PLUS_BLOCKS_ENTANGLED);
                }
           }
-          auto held_up_result = block_held_up_by_another_block(block, block_qt, interactive_qt, tilemap);
+          auto held_up_result = block_held_up_by_another_block(block, block_qt, block_array, interactive_qt, tilemap);
           if(held_up_result.held()){
                add_global_tag(TAG_BLOCKS_STACKED);
           }
@@ -1166,6 +1159,223 @@ bool load_map_from_file(FILE* file, Coord_t* player_start, TileMap_t* tilemap, O
 
      quad_tree_free(block_qt);
      quad_tree_free(interactive_qt);
+}
+
+// validates that every section lies within the bytes we have
+static bool map_header_from_bytes(const U8* bytes, U64 byte_count, MapHeaderV1_t* header, const char* filepath){
+     if(byte_count < sizeof(*header)){
+          LOG("%s(): '%s' is too small to contain a map header: %" PRIu64 " bytes\n", __FUNCTION__, filepath, byte_count);
+          return false;
+     }
+
+     memcpy(header, bytes, sizeof(*header));
+
+     for(S8 i = 0; i < MAP_SECTION_COUNT; i++){
+          const MapSectionV1_t* section = header->sections + i;
+          if(section->offset > byte_count || section->size > byte_count - section->offset){
+               LOG("%s(): '%s' section %d at offset %" PRIu64 " with size %" PRIu64 " is outside the %" PRIu64 " byte map\n",
+                   __FUNCTION__, filepath, i, section->offset, section->size, byte_count);
+               return false;
+          }
+     }
+
+     return true;
+}
+
+// returns false if a section's end does not fit in 64 bits, which only a corrupt header can do
+static bool map_header_byte_count(const MapHeaderV1_t* header, U64* byte_count){
+     *byte_count = sizeof(*header);
+     for(S8 i = 0; i < MAP_SECTION_COUNT; i++){
+          const MapSectionV1_t* section = header->sections + i;
+          if(section->size > UINT64_MAX - section->offset) return false;
+          U64 section_end = section->offset + section->size;
+          if(section_end > *byte_count) *byte_count = section_end;
+     }
+     return true;
+}
+
+// reads the map directly out of the bytes, which are expected to be memory mapped, without any intermediate copies
+bool load_map_from_bytes_v10(const U8* bytes, U64 byte_count, Coord_t* player_start, TileMap_t* tilemap,
+                             ObjectArray_t<Block_t>* block_array, ObjectArray_t<Interactive_t>* interactive_array,
+                             ObjectArray_t<Rect_t>* room_array, ObjectArray_t<Exit_t>* exit_array, const char* filepath){
+     MapHeaderV1_t header;
+     if(!map_header_from_bytes(bytes, byte_count, &header, filepath)) return false;
+
+     if(header.width < 0 || header.height < 0 || header.block_count < 0 || header.interactive_count < 0 ||
+        header.room_count < 0 || header.exit_count < 0){
+          LOG("%s(): '%s' has negative dimensions or counts in its header\n", __FUNCTION__, filepath);
+          return false;
+     }
+
+     S32 map_tile_count = (S32)(header.width) * (S32)(header.height);
+     if(header.sections[MAP_SECTION_TILES].size != sizeof(MapTileV2_t) * (U64)(map_tile_count) ||
+        header.sections[MAP_SECTION_BLOCKS].size != sizeof(MapBlockV3_t) * (U64)(header.block_count) ||
+        header.sections[MAP_SECTION_INTERACTIVES].size != sizeof(MapInteractiveV4_t) * (U64)(header.interactive_count) ||
+        header.sections[MAP_SECTION_ROOMS].size != sizeof(Rect_t) * (U64)(header.room_count)){
+          LOG("%s(): '%s' section sizes do not match the header counts\n", __FUNCTION__, filepath);
+          return false;
+     }
+
+     if(!resize(room_array, header.room_count)){
+          LOG("%s(): failed to allocate %d rooms\n", __FUNCTION__, header.room_count);
+          return false;
+     }
+
+     if(!resize(exit_array, header.exit_count)){
+          LOG("%s(): failed to allocate %d exit_array\n", __FUNCTION__, header.exit_count);
+          return false;
+     }
+
+     const U8* exit_bytes = bytes + header.sections[MAP_SECTION_EXITS].offset;
+     U64 exit_bytes_left = header.sections[MAP_SECTION_EXITS].size;
+     for(S16 i = 0; i < header.exit_count; i++){
+          U64 exit_size = read_exit_from_bytes(exit_bytes, exit_bytes_left, exit_array->elements + i);
+          if(exit_size == 0){
+               LOG("%s(): '%s' has a malformed exit %d\n", __FUNCTION__, filepath, i);
+               return false;
+          }
+          exit_bytes += exit_size;
+          exit_bytes_left -= exit_size;
+     }
+
+     if(header.room_count > 0){
+          memcpy(room_array->elements, bytes + header.sections[MAP_SECTION_ROOMS].offset,
+                 header.sections[MAP_SECTION_ROOMS].size);
+     }
+
+     *player_start = header.player_start;
+
+     destroy(tilemap);
+     init(tilemap, header.width, header.height);
+
+     destroy(block_array);
+     init(block_array, header.block_count);
+
+     destroy(interactive_array);
+     init(interactive_array, header.interactive_count);
+
+     // the map structs are packed, so we can point right at them
+     const MapTileV2_t* map_tiles = (const MapTileV2_t*)(bytes + header.sections[MAP_SECTION_TILES].offset);
+     const MapBlockV3_t* map_blocks = (const MapBlockV3_t*)(bytes + header.sections[MAP_SECTION_BLOCKS].offset);
+     const MapInteractiveV4_t* map_interactives = (const MapInteractiveV4_t*)(bytes + header.sections[MAP_SECTION_INTERACTIVES].offset);
+
+     S32 index = 0;
+     for(S32 y = 0; y < tilemap->height; y++){
+          for(S32 x = 0; x < tilemap->width; x++){
+               tilemap_tile(tilemap, x, y)->id = map_tiles[index].id;
+               tilemap_tile(tilemap, x, y)->flags = map_tiles[index].flags;
+               tilemap_tile(tilemap, x, y)->light = BASE_LIGHT;
+               tilemap_tile(tilemap, x, y)->rotation = map_tiles[index].rotation;
+               index++;
+          }
+     }
+
+     tilemap_build_flag_planes(tilemap);
+
+     for(S16 i = 0; i < block_array->count; i++){
+          Block_t* block = block_array->elements + i;
+          default_block(block);
+          build_block_from_map_block(block, map_blocks + i);
+     }
+
+     for(S16 i = 0; i < interactive_array->count; i++){
+          build_interactive_from_map_interactive(interactive_array->elements + i, map_interactives + i);
+     }
+
+     return true;
+}
+
+bool load_map_from_file_v10(FILE* file, Coord_t* player_start, TileMap_t* tilemap, ObjectArray_t<Block_t>* block_array,
+                            ObjectArray_t<Interactive_t>* interactive_array, ObjectArray_t<Rect_t>* room_array,
+                            ObjectArray_t<Exit_t>* exit_array, const char* filepath){
+     // the version byte has already been read, read the rest of the header to find out how big the map is
+     MapHeaderV1_t header;
+     header.version = 10;
+     if(fread((U8*)(&header) + sizeof(header.version), sizeof(header) - sizeof(header.version), 1, file) != 1){
+          LOG("%s(): failed to read map header from '%s'\n", __FUNCTION__, filepath);
+          return false;
+     }
+
+     // section offsets are relative to the version byte, which may not be at the start of the file
+     long header_end = ftell(file);
+     if(header_end < 0 || fseek(file, 0, SEEK_END) != 0){
+          LOG("%s(): failed to find the size of '%s'\n", __FUNCTION__, filepath);
+          return false;
+     }
+     long file_end = ftell(file);
+     if(file_end < header_end || fseek(file, header_end, SEEK_SET) != 0){
+          LOG("%s(): failed to find the size of '%s'\n", __FUNCTION__, filepath);
+          return false;
+     }
+     U64 bytes_available = (U64)(file_end - header_end) + sizeof(header);
+
+     // check the sections against the file before trusting them with an allocation
+     U64 byte_count = 0;
+     if(!map_header_byte_count(&header, &byte_count) || byte_count > bytes_available){
+          LOG("%s(): '%s' has sections outside the %" PRIu64 " bytes of the map\n", __FUNCTION__, filepath,
+              bytes_available);
+          return false;
+     }
+
+     U8* bytes = (U8*)(malloc(byte_count));
+     if(!bytes){
+          LOG("%s(): failed to allocate %" PRIu64 " bytes for map '%s'\n", __FUNCTION__, byte_count, filepath);
+          return false;
+     }
+
+     memcpy(bytes, &header, sizeof(header));
+     U64 bytes_left = byte_count - sizeof(header);
+     if(bytes_left > 0 && fread(bytes + sizeof(header), bytes_left, 1, file) != 1){
+          LOG("%s(): failed to read %" PRIu64 " bytes of map '%s'\n", __FUNCTION__, bytes_left, filepath);
+          free(bytes);
+          return false;
+     }
+
+     bool result = load_map_from_bytes_v10(bytes, byte_count, player_start, tilemap, block_array, interactive_array,
+                                           room_array, exit_array, filepath);
+     free(bytes);
+     return result;
+}
+
+bool load_map_from_file(FILE* file, Coord_t* player_start, TileMap_t* tilemap, ObjectArray_t<Block_t>* block_array,
+                        ObjectArray_t<Interactive_t>* interactive_array, ObjectArray_t<Rect_t>* room_array,
+                        ObjectArray_t<Exit_t>* exit_array, const char* filepath){
+     U8 map_version = 0;
+     fread(&map_version, sizeof(map_version), 1, file);
+     bool result = false;
+     switch(map_version){
+     default:
+          LOG("%s(): mismatched version loading '%s', actual %d, expected %d\n", __FUNCTION__, filepath, map_version, MAP_VERSION);
+          break;
+     case 1:
+     case 2:
+     case 3:
+          LOG("%s(): deprecated version %d, use git to find the code to load this map if ya really want bro\n",
+              __FUNCTION__, map_version);
+          break;
+     case 4:
+     case 5:
+          result = load_map_from_file_v4(file, player_start, tilemap, block_array, interactive_array);
+          break;
+     case 6:
+          result = load_map_from_file_v6(file, player_start, tilemap, block_array, interactive_array);
+          break;
+     case 7:
+          result = load_map_from_file_v7(file, player_start, tilemap, block_array, interactive_array);
+          break;
+     case 8:
+          result = load_map_from_file_v8(file, player_start, tilemap, block_array, interactive_array, room_array);
+          break;
+     case 9:
+          result = load_map_from_file_v9(file, player_start, tilemap, block_array, interactive_array, room_array, exit_array);
+          break;
+     case 10:
+          result = load_map_from_file_v10(file, player_start, tilemap, block_array, interactive_array, room_array,
+                                          exit_array, filepath);
+          break;
+     }
+
+     add_global_tags_for_map(tilemap, block_array, interactive_array);
 
      return result;
 }
@@ -1174,6 +1384,19 @@ bool load_map(const char* filepath, Coord_t* player_start, TileMap_t* tilemap, O
               ObjectArray_t<Interactive_t>* interactive_array, ObjectArray_t<Rect_t>* room_array,
               ObjectArray_t<Exit_t>* exit_array){
      LOG("load map %s\n", filepath);
+
+     // newer maps are read straight out of a memory mapping of the file
+     Raw_t raw = raw_map_file(filepath);
+     if(!raw.bytes) return false;
+     if(raw.bytes[0] == MAP_VERSION){
+          bool success = load_map_from_bytes_v10(raw.bytes, raw.byte_count, player_start, tilemap, block_array,
+                                                 interactive_array, room_array, exit_array, filepath);
+          add_global_tags_for_map(tilemap, block_array, interactive_array);
+          raw_unmap_file(&raw);
+          return success;
+     }
+     raw_unmap_file(&raw);
+
      FILE* f = fopen(filepath, "rb");
      if(!f){
           LOG("%s(): fopen() failed\n", __FUNCTION__);
@@ -1185,28 +1408,57 @@ bool load_map(const char* filepath, Coord_t* player_start, TileMap_t* tilemap, O
      return success;
 }
 
-bool load_map_thumbnail(const char* filepath, Raw_t* thumbnail){
-     FILE* file = fopen(filepath, "rb");
-     if(!file){
-          LOG("%s(): fopen() failed\n", __FUNCTION__);
+// with the section table we only touch the pages that contain the thumbnail
+static bool load_map_thumbnail_v10(const char* filepath, Raw_t* raw, Raw_t* thumbnail){
+     MapHeaderV1_t header;
+     if(!map_header_from_bytes(raw->bytes, raw->byte_count, &header, filepath)) return false;
+
+     const MapSectionV1_t* section = header.sections + MAP_SECTION_THUMBNAIL;
+     if(section->size == 0){
+          LOG("map does not contain a thumbnail\n");
           return false;
      }
 
-     U8 map_version = 0;
-     fread(&map_version, sizeof(map_version), 1, file);
+     thumbnail->byte_count = section->size;
+     thumbnail->bytes = (U8*)(malloc(section->size));
+     if(!thumbnail->bytes){
+          LOG("Failed to allocate memory for thumbnail of size %" PRIu64 " in file: %s version %d\n", section->size, filepath, header.version);
+          return false;
+     }
 
-     if(map_version < 4){
-         LOG("map version %u does not support thumbnail\n", map_version);
-         return false;
+     memcpy(thumbnail->bytes, raw->bytes + section->offset, section->size);
+     return true;
+}
+
+static bool load_map_tags_v10(const char* filepath, Raw_t* raw, bool* tags){
+     MapHeaderV1_t header;
+     if(!map_header_from_bytes(raw->bytes, raw->byte_count, &header, filepath)) return false;
+
+     const MapSectionV1_t* section = header.sections + MAP_SECTION_TAGS;
+     U64 tag_count = section->size / sizeof(U16);
+
+     if(tag_count > 0){
+          memset(tags, 0, TAG_COUNT * sizeof(*tags));
+          U16 value;
+          for(U64 t = 0; t < tag_count; t++){
+               memcpy(&value, raw->bytes + section->offset + t * sizeof(value), sizeof(value));
+               if(value < TAG_COUNT){
+                    tags[value] = true;
+               }
+          }
      }
 
+     return true;
+}
+
+// skips from after the version byte to the thumbnail size for versions before the section table
+static void skip_to_map_thumbnail(FILE* file, U8 map_version){
      S16 map_width;
      S16 map_height;
      S16 interactive_count;
      S16 block_count;
      S16 room_count;
      S16 exit_count;
-     U64 thumbnail_size;
      Coord_t player_start;
 
      fread(&player_start, sizeof(player_start), 1, file);
@@ -1242,6 +1494,35 @@ bool load_map_thumbnail(const char* filepath, Raw_t* thumbnail){
           }
           destroy(&exits);
      }
+}
+
+bool load_map_thumbnail(const char* filepath, Raw_t* thumbnail){
+     Raw_t raw = raw_map_file(filepath);
+     if(raw.bytes && raw.bytes[0] == MAP_VERSION){
+          bool success = load_map_thumbnail_v10(filepath, &raw, thumbnail);
+          raw_unmap_file(&raw);
+          return success;
+     }
+     raw_unmap_file(&raw);
+
+     FILE* file = fopen(filepath, "rb");
+     if(!file){
+          LOG("%s(): fopen() failed\n", __FUNCTION__);
+          return false;
+     }
+
+     U8 map_version = 0;
+     fread(&map_version, sizeof(map_version), 1, file);
+
+     if(map_version < 4){
+         LOG("map version %u does not support thumbnail\n", map_version);
+         fclose(file);
+         return false;
+     }
+
+     U64 thumbnail_size;
+
+     skip_to_map_thumbnail(file, map_version);
 
      fread(&thumbnail_size, sizeof(thumbnail_size), 1, file);
 
@@ -1250,11 +1531,13 @@ bool load_map_thumbnail(const char* filepath, Raw_t* thumbnail){
          thumbnail->bytes = (U8*)(malloc(thumbnail_size));
          if(!thumbnail->bytes){
              LOG("Failed to allocate memory for thumbnail of size %lu in file: %s version %d\n", thumbnail_size, filepath, map_version);
+             fclose(file);
              return false;
          }
          fread(thumbnail->bytes, thumbnail_size, 1, file);
      }else{
          LOG("map does not contain a thumbnail\n");
+         fclose(file);
          return false;
      }
 
@@ -1262,7 +1545,20 @@ bool load_map_thumbnail(const char* filepath, Raw_t* thumbnail){
      return true;
 }
 
-bool load_map_tags(const char* filepath, bool* tags){
+bool load_map_thumbnail_location(const char* filepath, U64* offset, U64* size){
+     Raw_t raw = raw_map_file(filepath);
+     if(raw.bytes && raw.bytes[0] == MAP_VERSION){
+          MapHeaderV1_t header;
+          bool success = map_header_from_bytes(raw.bytes, raw.byte_count, &header, filepath);
+          if(success){
+               *offset = header.sections[MAP_SECTION_THUMBNAIL].offset;
+               *size = header.sections[MAP_SECTION_THUMBNAIL].size;
+          }
+          raw_unmap_file(&raw);
+          return success && *size > 0;
+     }
+     raw_unmap_file(&raw);
+
      FILE* file = fopen(filepath, "rb");
      if(!file){
           LOG("%s(): fopen() failed\n", __FUNCTION__);
@@ -1272,55 +1568,51 @@ bool load_map_tags(const char* filepath, bool* tags){
      U8 map_version = 0;
      fread(&map_version, sizeof(map_version), 1, file);
 
-     if(map_version < 5){
-         LOG("warning: map version %u on map %s does not support tags\n", map_version, filepath);
+     if(map_version < 4){
+         fclose(file);
          return false;
      }
 
-     S16 map_width;
-     S16 map_height;
-     S16 interactive_count;
-     S16 block_count;
-     U64 thumbnail_size;
-     U16 tag_count;
-     S16 room_count;
-     S16 exit_count;
-     Coord_t player_start;
+     skip_to_map_thumbnail(file, map_version);
 
-     fread(&player_start, sizeof(player_start), 1, file);
-     fread(&map_width, sizeof(map_width), 1, file);
-     fread(&map_height, sizeof(map_height), 1, file);
-     fread(&block_count, sizeof(block_count), 1, file);
-     fread(&interactive_count, sizeof(interactive_count), 1, file);
+     U64 thumbnail_size = 0;
+     fread(&thumbnail_size, sizeof(thumbnail_size), 1, file);
+     *offset = (U64)(ftell(file));
+     *size = thumbnail_size;
 
-     if(map_version <= 7){
-          fseek(file, sizeof(MapTileV1_t) * map_width * map_height, SEEK_CUR);
-          fseek(file, sizeof(MapBlockV3_t) * block_count, SEEK_CUR);
-          fseek(file, sizeof(MapInteractiveV1_t) * interactive_count, SEEK_CUR);
-     }else if(map_version == 8){
-          fread(&room_count, sizeof(room_count), 1, file);
+     fclose(file);
+     return thumbnail_size > 0;
+}
 
-          fseek(file, sizeof(MapTileV2_t) * map_width * map_height, SEEK_CUR);
-          fseek(file, sizeof(MapBlockV3_t) * block_count, SEEK_CUR);
-          fseek(file, sizeof(MapInteractiveV3_t) * interactive_count, SEEK_CUR);
-          fseek(file, sizeof(Rect_t) * room_count, SEEK_CUR);
-     }else if(map_version == 9){
-          fread(&room_count, sizeof(room_count), 1, file);
-          fread(&exit_count, sizeof(exit_count), 1, file);
+bool load_map_tags(const char* filepath, bool* tags){
+     Raw_t raw = raw_map_file(filepath);
+     if(raw.bytes && raw.bytes[0] == MAP_VERSION){
+          bool success = load_map_tags_v10(filepath, &raw, tags);
+          raw_unmap_file(&raw);
+          return success;
+     }
+     raw_unmap_file(&raw);
 
-          fseek(file, sizeof(MapTileV2_t) * map_width * map_height, SEEK_CUR);
-          fseek(file, sizeof(MapBlockV3_t) * block_count, SEEK_CUR);
-          fseek(file, sizeof(MapInteractiveV4_t) * interactive_count, SEEK_CUR);
-          fseek(file, sizeof(Rect_t) * room_count, SEEK_CUR);
+     FILE* file = fopen(filepath, "rb");
+     if(!file){
+          LOG("%s(): fopen() failed\n", __FUNCTION__);
+          return false;
+     }
 
-          ObjectArray_t<Exit_t> exits{};
-          init(&exits, exit_count);
-          for(S16 i = 0; i < exit_count; i++){
-               read_exit(file, exits.elements + i);
-          }
-          destroy(&exits);
+     U8 map_version = 0;
+     fread(&map_version, sizeof(map_version), 1, file);
+
+     if(map_version < 5){
+         LOG("warning: map version %u on map %s does not support tags\n", map_version, filepath);
+         fclose(file);
+         return false;
      }
 
+     U64 thumbnail_size;
+     U16 tag_count;
+
+     skip_to_map_thumbnail(file, map_version);
+
      fread(&thumbnail_size, sizeof(thumbnail_size), 1, file);
      fseek(file, thumbnail_size, SEEK_CUR);
 
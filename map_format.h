@@ -14,7 +14,19 @@
 // version 7 adds the iced flag to the pit
 // version 8 adds rooms, also we changed TILE_FLAG_CHECKPOINT to TILE_FLAG_SOLID, and adds rotation to tiles
 // version 9 adds stairs that reference the exit and a list of exits for the map
-#define MAP_VERSION 9
+// version 10 adds a header with a section offset table, the thumbnail and tags are stored without their counts
+#define MAP_VERSION 10
+
+enum MapSection_t{
+     MAP_SECTION_TILES,
+     MAP_SECTION_BLOCKS,
+     MAP_SECTION_INTERACTIVES,
+     MAP_SECTION_ROOMS,
+     MAP_SECTION_EXITS,
+     MAP_SECTION_THUMBNAIL,
+     MAP_SECTION_TAGS,
+     MAP_SECTION_COUNT,
+};
 
 #pragma pack(push, 1)
 struct MapTileV1_t{
@@ -155,6 +167,22 @@ struct MapInteractiveV4_t{
           PitV2_t pit;
      };
 };
+struct MapSectionV1_t{
+     U64 offset; // relative to the version byte, maps may be embedded in other files like demos
+     U64 size;
+};
+
+struct MapHeaderV1_t{
+     U8 version;
+     Coord_t player_start;
+     S16 width;
+     S16 height;
+     S16 block_count;
+     S16 interactive_count;
+     S16 room_count;
+     S16 exit_count;
+     MapSectionV1_t sections[MAP_SECTION_COUNT];
+};
 #pragma pack(pop)
 
 bool save_map_to_file(FILE* file, Coord_t player_start, const TileMap_t* tilemap, ObjectArray_t<Block_t>* block_array,
@@ -174,6 +202,7 @@ bool load_map(const char* filepath, Coord_t* player_start, TileMap_t* tilemap, O
               ObjectArray_t<Exit_t>* exit_array);
 
 bool load_map_thumbnail(const char* filepath, Raw_t* thumbnail);
+bool load_map_thumbnail_location(const char* filepath, U64* offset, U64* size);
 bool load_map_tags(const char* filepath, bool* tags);
 
 void build_map_interactive_from_interactive(MapInteractiveV4_t* map_interactive, const Interactive_t* interactive);
@@ -0,0 +1,290 @@
+#include "map_index.h"
+#include "map_format.h"
+#include "tags.h"
+#include "log.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+// linux specific
+#include <dirent.h>
+
+static_assert(TAG_COUNT <= 64, "map index tags no longer fit in a U64");
+
+int get_numbered_map(const char* path){
+    char number_str[4];
+    memset(number_str, 0, 4);
+
+    U32 digits_left = 3;
+    while(*path){
+         if(digits_left > 0){
+              if(!isdigit(*path)) return -1;
+              number_str[3 - digits_left] = *path;
+              digits_left--;
+         }else{
+              if(*path == '_') break;
+              return -1;
+         }
+         path++;
+    }
+
+    return atoi(number_str);
+}
+
+FindAllMapsResult_t find_all_maps(){
+     FindAllMapsResult_t result;
+     U32 map_count = 0;
+
+     {
+          DIR* d = opendir("content");
+          if(!d) return result;
+          struct dirent* dir;
+          while((dir = readdir(d)) != nullptr){
+               if(strstr(dir->d_name, ".bm") && get_numbered_map(dir->d_name) >= 0){
+                    map_count++;
+               }
+          }
+          closedir(d);
+     }
+
+     result.count = map_count;
+     result.entries = (FindMapResult_t*)(malloc(map_count * sizeof(*result.entries)));
+
+     map_count = 0;
+     {
+          DIR* d = opendir("content");
+          if(!d) return result;
+          struct dirent* dir;
+          char full_path[MAP_INDEX_MAX_PATH_SIZE];
+          while((dir = readdir(d)) != nullptr){
+               int map_number = get_numbered_map(dir->d_name);
+               if(strstr(dir->d_name, ".bm") && map_number >= 0){
+                    snprintf(full_path, MAP_INDEX_MAX_PATH_SIZE, "content/%s", dir->d_name);
+                    result.entries[map_count].path = strdup(full_path);
+                    result.entries[map_count].map_number = map_number;
+                    map_count++;
+               }
+          }
+          closedir(d);
+     }
+
+     return result;
+}
+
+static bool get_map_mtime(const char* filepath, S64* mtime){
+     struct stat file_stat;
+     if(stat(filepath, &file_stat) != 0) return false;
+     *mtime = (S64)(file_stat.st_mtime);
+     return true;
+}
+
+static bool build_map_index_entry(MapIndexEntry_t* entry, const char* filepath, S32 map_number){
+     // a truncated path would never match the map again and could not be loaded from the browser
+     size_t path_length = strlen(filepath);
+     if(path_length >= MAP_INDEX_MAX_PATH_SIZE){
+          LOG("%s(): not indexing %s, its path is longer than %d characters\n", __FUNCTION__, filepath, MAP_INDEX_MAX_PATH_SIZE - 1);
+          return false;
+     }
+
+     memset(entry, 0, sizeof(*entry));
+     entry->map_number = map_number;
+     memcpy(entry->path, filepath, path_length + 1);
+
+     // the entry is packed, so read into locals rather than pointing at its members
+     S64 mtime = 0;
+     if(!get_map_mtime(filepath, &mtime)){
+          LOG("%s(): failed to stat %s\n", __FUNCTION__, filepath);
+          return false;
+     }
+     entry->mtime = mtime;
+
+     bool tags[TAG_COUNT] = {};
+     if(load_map_tags(filepath, tags)){
+          for(S16 t = 0; t < TAG_COUNT; t++){
+               if(tags[t]) entry->tags |= ((U64)(1) << t);
+          }
+     }
+
+     U64 thumbnail_offset = 0;
+     U64 thumbnail_size = 0;
+     if(load_map_thumbnail_location(filepath, &thumbnail_offset, &thumbnail_size)){
+          entry->thumbnail_offset = thumbnail_offset;
+          entry->thumbnail_size = thumbnail_size;
+     }
+
+     return true;
+}
+
+static S16 find_map_index_entry(ObjectArray_t<MapIndexEntry_t>* index, const char* filepath){
+     for(S16 i = 0; i < index->count; i++){
+          if(strcmp(index->elements[i].path, filepath) == 0) return i;
+     }
+     return -1;
+}
+
+bool map_index_read(ObjectArray_t<MapIndexEntry_t>* index){
+     FILE* file = fopen(MAP_INDEX_FILEPATH, "rb");
+     if(!file) return false;
+
+     S32 version = 0;
+     S16 count = 0;
+     fread(&version, sizeof(version), 1, file);
+     fread(&count, sizeof(count), 1, file);
+
+     if(version != MAP_INDEX_VERSION || count < 0){
+          LOG("%s(): ignoring %s with version %d, expected %d\n", __FUNCTION__, MAP_INDEX_FILEPATH, version, MAP_INDEX_VERSION);
+          fclose(file);
+          return false;
+     }
+
+     destroy(index);
+     if(count > 0 && !init(index, count)){
+          fclose(file);
+          return false;
+     }
+
+     if(count > 0 && fread(index->elements, sizeof(*index->elements), (size_t)(count), file) != (size_t)(count)){
+          LOG("%s(): %s is truncated\n", __FUNCTION__, MAP_INDEX_FILEPATH);
+          destroy(index);
+          fclose(file);
+          return false;
+     }
+
+     // the paths are compared as strings, so don't trust the file to terminate them
+     for(S16 i = 0; i < count; i++){
+          index->elements[i].path[MAP_INDEX_MAX_PATH_SIZE - 1] = 0;
+     }
+
+     fclose(file);
+     return true;
+}
+
+bool map_index_write(ObjectArray_t<MapIndexEntry_t>* index){
+     FILE* file = fopen(MAP_INDEX_FILEPATH, "wb");
+     if(!file){
+          LOG("%s(): failed to open %s for writing\n", __FUNCTION__, MAP_INDEX_FILEPATH);
+          return false;
+     }
+
+     S32 version = MAP_INDEX_VERSION;
+     fwrite(&version, sizeof(version), 1, file);
+     fwrite(&index->count, sizeof(index->count), 1, file);
+     fwrite(index->elements, sizeof(*index->elements), (size_t)(index->count), file);
+     fclose(file);
+     return true;
+}
+
+// reuse any cached entries whose map hasn't been modified, only opening new or changed maps
+bool map_index_refresh(ObjectArray_t<MapIndexEntry_t>* index){
+     ObjectArray_t<MapIndexEntry_t> cached_index = {};
+     map_index_read(&cached_index);
+
+     auto all_maps = find_all_maps();
+
+     destroy(index);
+     if(all_maps.count > 0 && !init(index, (S16)(all_maps.count))){
+          destroy(&cached_index);
+          return false;
+     }
+
+     bool changed = (cached_index.count != index->count);
+     S16 entry_count = 0;
+
+     for(U32 m = 0; m < all_maps.count; m++){
+          auto* found_map = all_maps.entries + m;
+          auto* entry = index->elements + entry_count;
+
+          S16 cached_entry_index = find_map_index_entry(&cached_index, found_map->path);
+          S64 mtime = 0;
+          if(cached_entry_index >= 0 && get_map_mtime(found_map->path, &mtime) &&
+             cached_index.elements[cached_entry_index].mtime == mtime){
+               *entry = cached_index.elements[cached_entry_index];
+               entry_count++;
+          }else{
+               changed = true;
+               if(build_map_index_entry(entry, found_map->path, found_map->map_number)) entry_count++;
+          }
+
+          free(found_map->path);
+     }
+
+     free(all_maps.entries);
+     destroy(&cached_index);
+
+     index->count = entry_count;
+
+     if(changed){
+          LOG("rebuilt stale entries in %s for %d maps\n", MAP_INDEX_FILEPATH, index->count);
+          map_index_write(index);
+     }
+
+     return true;
+}
+
+bool map_index_update_map(const char* filepath){
+     // only numbered maps in the content directory are indexed
+     const char* content_dir = "content/";
+     size_t content_dir_length = strlen(content_dir);
+     if(strncmp(filepath, content_dir, content_dir_length) != 0) return false;
+
+     S32 map_number = get_numbered_map(filepath + content_dir_length);
+     if(map_number < 0) return false;
+
+     // if there is no index yet, it will be fully built the next time the map browser is opened
+     ObjectArray_t<MapIndexEntry_t> index = {};
+     if(!map_index_read(&index)) return false;
+
+     S16 entry_index = find_map_index_entry(&index, filepath);
+     if(entry_index < 0){
+          entry_index = index.count;
+          if(!resize(&index, index.count + (S16)(1))){
+               destroy(&index);
+               return false;
+          }
+     }
+
+     bool success = build_map_index_entry(index.elements + entry_index, filepath, map_number);
+     if(success) success = map_index_write(&index);
+
+     destroy(&index);
+     return success;
+}
+
+void map_index_entry_get_tags(const MapIndexEntry_t* entry, bool* tags){
+     for(S16 t = 0; t < TAG_COUNT; t++){
+          tags[t] = (entry->tags & ((U64)(1) << t)) != 0;
+     }
+}
+
+bool map_index_load_thumbnail(const char* filepath, U64 thumbnail_offset, U64 thumbnail_size, Raw_t* thumbnail){
+     if(thumbnail_size == 0) return false;
+
+     FILE* file = fopen(filepath, "rb");
+     if(!file){
+          LOG("%s(): failed to open %s\n", __FUNCTION__, filepath);
+          return false;
+     }
+
+     thumbnail->bytes = (U8*)(malloc(thumbnail_size));
+     if(!thumbnail->bytes){
+          LOG("%s(): failed to allocate %" PRIu64 " bytes for the thumbnail of %s\n", __FUNCTION__, thumbnail_size, filepath);
+          fclose(file);
+          return false;
+     }
+
+     thumbnail->byte_count = thumbnail_size;
+     fseek(file, (long)(thumbnail_offset), SEEK_SET);
+     if(fread(thumbnail->bytes, thumbnail->byte_count, 1, file) != 1){
+          LOG("%s(): failed to read the thumbnail of %s\n", __FUNCTION__, filepath);
+          free(thumbnail->bytes);
+          thumbnail->bytes = nullptr;
+          thumbnail->byte_count = 0;
+          fclose(file);
+          return false;
+     }
+
+     fclose(file);
+     return true;
+}
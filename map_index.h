@@ -0,0 +1,42 @@
+#pragma once
+
+#include "types.h"
+#include "object_array.h"
+#include "raw.h"
+
+#define MAP_INDEX_FILEPATH "content/index"
+#define MAP_INDEX_VERSION 2
+#define MAP_INDEX_MAX_PATH_SIZE 256 // as long as the paths find_all_maps() builds
+
+struct FindMapResult_t{
+     char* path = NULL;
+     int map_number = 0;
+};
+
+struct FindAllMapsResult_t{
+     FindMapResult_t* entries = NULL;
+     U32 count = 0;
+};
+
+#pragma pack(push, 1)
+// what the map browser needs to know about a map without opening it
+struct MapIndexEntry_t{
+     S32 map_number;
+     char path[MAP_INDEX_MAX_PATH_SIZE];
+     U64 tags; // a bit per Tag_t
+     U64 thumbnail_offset;
+     U64 thumbnail_size; // 0 if the map has no thumbnail
+     S64 mtime;
+};
+#pragma pack(pop)
+
+int get_numbered_map(const char* path);
+FindAllMapsResult_t find_all_maps();
+
+bool map_index_read(ObjectArray_t<MapIndexEntry_t>* index);
+bool map_index_write(ObjectArray_t<MapIndexEntry_t>* index);
+bool map_index_refresh(ObjectArray_t<MapIndexEntry_t>* index);
+bool map_index_update_map(const char* filepath);
+
+void map_index_entry_get_tags(const MapIndexEntry_t* entry, bool* tags);
+bool map_index_load_thumbnail(const char* filepath, U64 thumbnail_offset, U64 thumbnail_size, Raw_t* thumbnail);
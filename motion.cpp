@@ -128,7 +128,12 @@ F32 calc_accel_component_move(Move_t move, F32 accel){
 }
 
 F32 calc_position_motion(F32 v, F32 a, F32 dt){
+#ifdef FIXED_POINT_POSITIONS
+     // deltas on the same grid as positions compare exactly, so blocks moving together stay together
+     return position_fixed_snap((v * dt) + (0.5f * a * dt * dt));
+#else
      return (v * dt) + (0.5f * a * dt * dt);
+#endif
 }
 
 F32 calc_velocity_motion(F32 v, F32 a, F32 dt){
@@ -1,24 +1,45 @@
 #pragma once
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "types.h"
 #include "log.h"
 
+#define OBJECT_ARRAY_MAX_COUNT 0x7FFF
+
 template <typename T>
 struct ObjectArray_t{
      T* elements;
      S16 count;
+     S16 capacity; // elements allocated, count can grow up to this without reallocating
+     U16* generations; // per element, bumped when the element at that index goes away
+};
+
+// refers to an element by index, the generation detects if the element at that index was removed or replaced since
+// the handle was made. Elements are kept packed, so this is not a stable id: remove() moves the last element into the
+// hole and that invalidates the moved element's handles as well. Handles don't survive destroy() or resize() to 0
+struct ObjectHandle_t{
+     S16 index = -1;
+     U16 generation = 0;
 };
 
 template <typename T>
 bool init(ObjectArray_t<T>* object_array, S16 count){
      object_array->elements = (T*)(calloc(count, sizeof(*object_array->elements)));
-     if(!object_array->elements){
+     object_array->generations = (U16*)(calloc(count, sizeof(*object_array->generations)));
+     if(!object_array->elements || !object_array->generations){
           LOG("%s() failed to calloc %d objects\n", __FUNCTION__, count);
+          free(object_array->elements);
+          free(object_array->generations);
+          object_array->elements = nullptr;
+          object_array->generations = nullptr;
+          object_array->count = 0;
+          object_array->capacity = 0;
           return false;
      }
      object_array->count = count;
+     object_array->capacity = count;
      return true;
 }
 
@@ -29,20 +50,53 @@ void deep_copy(ObjectArray_t<T>* a, ObjectArray_t<T>* b){
      init(b, a->count);
      for(S16 i = 0; i < a->count; i++){
           b->elements[i] = a->elements[i];
+          b->generations[i] = a->generations[i];
+     }
+}
+
+template <typename T>
+bool reserve(ObjectArray_t<T>* object_array, S16 new_capacity){
+     if(new_capacity <= object_array->capacity) return true;
+
+     T* new_elements = (T*)(realloc(object_array->elements, new_capacity * sizeof(*object_array->elements)));
+     if(!new_elements){
+          LOG("%s() failed to realloc %d objects\n", __FUNCTION__, new_capacity);
+          return false;
      }
+     object_array->elements = new_elements;
+
+     U16* new_generations = (U16*)(realloc(object_array->generations, new_capacity * sizeof(*object_array->generations)));
+     if(!new_generations){
+          LOG("%s() failed to realloc %d object generations\n", __FUNCTION__, new_capacity);
+          return false;
+     }
+     memset(new_generations + object_array->capacity, 0, (new_capacity - object_array->capacity) * sizeof(*new_generations));
+     object_array->generations = new_generations;
+
+     object_array->capacity = new_capacity;
+     return true;
 }
 
+// growing doubles the capacity, so adding one element at a time is amortized O(1). Shrinking keeps the allocation,
+// except for shrinking to 0 which frees it like destroy()
 template <typename T>
 bool resize(ObjectArray_t<T>* object_array, S16 new_count){
      if(new_count == 0){
           destroy(object_array);
           return true;
      }
-     object_array->elements = (T*)(realloc(object_array->elements, new_count * sizeof(*object_array->elements)));
-     if(!object_array->elements){
-          LOG("%s() failed to realloc %d objects\n", __FUNCTION__, new_count);
-          return false;
+
+     if(new_count > object_array->capacity){
+          S32 new_capacity = (S32)(object_array->capacity) * 2;
+          if(new_capacity < new_count) new_capacity = new_count;
+          if(new_capacity > OBJECT_ARRAY_MAX_COUNT) new_capacity = OBJECT_ARRAY_MAX_COUNT;
+          if(!reserve(object_array, (S16)(new_capacity))) return false;
+     }
+
+     for(S16 i = new_count; i < object_array->count; i++){
+          object_array->generations[i]++;
      }
+
      object_array->count = new_count;
      return true;
 }
@@ -50,33 +104,57 @@ bool resize(ObjectArray_t<T>* object_array, S16 new_count){
 template <typename T>
 bool remove(ObjectArray_t<T>* object_array, S16 index){
      if(index < 0 || index >= object_array->count) return false;
-     if(object_array->count > 1){
-          // move the last element to the index of the element that we want to remove
-          object_array->elements[index] = object_array->elements[object_array->count - 1];
-          resize(object_array, object_array->count - (S16)(1));
-     }else if(object_array->count == 1){
-          destroy(object_array);
-     }
+
+     // move the last element to the index of the element that we want to remove, handles to it can't follow it there,
+     // so its old index is invalidated too, otherwise they would find whatever gets added there next
+     S16 last_index = object_array->count - 1;
+     object_array->elements[index] = object_array->elements[last_index];
+     object_array->generations[index]++;
+     if(last_index != index) object_array->generations[last_index]++;
+     object_array->count--;
      return true;
 }
 
 template <typename T>
 void destroy(ObjectArray_t<T>* object_array){
      free(object_array->elements);
+     free(object_array->generations);
      object_array->elements = nullptr;
+     object_array->generations = nullptr;
      object_array->count = 0;
+     object_array->capacity = 0;
 }
 
 template <typename T>
 bool shallow_copy(ObjectArray_t<T>* a, ObjectArray_t<T>* b){
      b->elements = (T*)(malloc(a->count * sizeof(*b->elements)));
-     if(!b->elements){
+     b->generations = (U16*)(malloc(a->count * sizeof(*b->generations)));
+     if(!b->elements || !b->generations){
           LOG("%s() failed to realloc %d objects\n", __FUNCTION__, a->count);
           return false;
      }
      for(S16 i = 0; i < a->count; i++){
           b->elements[i] = a->elements[i];
+          b->generations[i] = a->generations[i];
      }
      b->count = a->count;
+     b->capacity = a->count;
      return true;
 }
+
+template <typename T>
+ObjectHandle_t object_handle(ObjectArray_t<T>* object_array, S16 index){
+     ObjectHandle_t handle;
+     if(index < 0 || index >= object_array->count) return handle;
+     handle.index = index;
+     handle.generation = object_array->generations[index];
+     return handle;
+}
+
+// returns nullptr if the element the handle refers to is gone
+template <typename T>
+T* object_from_handle(ObjectArray_t<T>* object_array, ObjectHandle_t handle){
+     if(handle.index < 0 || handle.index >= object_array->count) return nullptr;
+     if(object_array->generations[handle.index] != handle.generation) return nullptr;
+     return object_array->elements + handle.index;
+}
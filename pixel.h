@@ -2,15 +2,24 @@
 
 #include "types.h"
 
+#include <cmath>
+
 struct Pixel_t{
      S16 x;
      S16 y;
 };
 
-Pixel_t operator+(Pixel_t a, Pixel_t b);
-Pixel_t operator-(Pixel_t a, Pixel_t b);
-void operator+=(Pixel_t& a, Pixel_t b);
-void operator-=(Pixel_t& a, Pixel_t b);
-bool operator!=(Pixel_t a, Pixel_t b);
-bool operator==(Pixel_t a, Pixel_t b);
-F64 pixel_distance_between(Pixel_t a, Pixel_t b);
+constexpr Pixel_t operator+(Pixel_t a, Pixel_t b){return Pixel_t{(S16)(a.x + b.x), (S16)(a.y + b.y)};}
+constexpr Pixel_t operator-(Pixel_t a, Pixel_t b){return Pixel_t{(S16)(a.x - b.x), (S16)(a.y - b.y)};}
+
+inline void operator+=(Pixel_t& a, Pixel_t b){a.x += b.x; a.y += b.y;}
+inline void operator-=(Pixel_t& a, Pixel_t b){a.x -= b.x; a.y -= b.y;}
+
+constexpr bool operator!=(Pixel_t a, Pixel_t b){return (a.x != b.x || a.y != b.y);}
+constexpr bool operator==(Pixel_t a, Pixel_t b){return (a.x == b.x && a.y == b.y);}
+
+inline F64 pixel_distance_between(Pixel_t a, Pixel_t b){
+     S16 diff_x = a.x - b.x;
+     S16 diff_y = a.y - b.y;
+     return sqrt(diff_x * diff_x + diff_y * diff_y);
+}
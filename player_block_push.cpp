@@ -1,9 +1,9 @@
 #include "player_block_push.h"
 #include "block_utils.h"
 
-bool player_block_push_add_ordered_physical_reqs(PlayerBlockPush_t* player_block_push, ObjectArray_t<PlayerBlockPush_t>* player_block_pushes,
-                                                 World_t* world, ObjectArray_t<PlayerBlockPush_t*>* ordered_player_block_pushes,
-                                                 ObjectArray_t<RestoreBlock_t>* restore_blocks){
+bool player_block_push_add_ordered_physical_reqs(PlayerBlockPush_t* player_block_push, FrameArray_t<PlayerBlockPush_t>* player_block_pushes,
+                                                 World_t* world, FrameArray_t<PlayerBlockPush_t*>* ordered_player_block_pushes,
+                                                 FrameArray_t<RestoreBlock_t>* restore_blocks){
      auto* block = world->blocks.elements + player_block_push->block_index;
      auto block_pos = block_get_position(block);
      auto block_pos_delta = block_get_pos_delta(block);
@@ -15,7 +15,7 @@ bool player_block_push_add_ordered_physical_reqs(PlayerBlockPush_t* player_block
      if(against_block){
           U32 against_block_index = against_block - world->blocks.elements;
           for(S16 i = 0; i < player_block_pushes->count; i++){
-               auto* itr = player_block_pushes->elements + i;
+               auto* itr = player_block_pushes->objects + i;
                if(itr->block_index == against_block_index &&
                   itr->direction == player_block_push->direction){
                     if(!player_block_push_add_ordered_physical_reqs(itr, player_block_pushes, world, ordered_player_block_pushes, restore_blocks)){
@@ -51,17 +51,11 @@ bool player_block_push_add_ordered_physical_reqs(PlayerBlockPush_t* player_block
      }
 
      if(would_push || against_block == nullptr){
-          if(resize(ordered_player_block_pushes, ordered_player_block_pushes->count + 1)){
-               auto* ordered_player_block_push = ordered_player_block_pushes->elements + (ordered_player_block_pushes->count - 1);
-               *ordered_player_block_push = player_block_push;
-          }else{
+          if(!ordered_player_block_pushes->insert(&player_block_push)){
                LOG("ran out of memory trying to allocate %d ordered block pushes\n", ordered_player_block_pushes->count + 1);
           }
 
-          if(resize(restore_blocks, restore_blocks->count + 1)){
-               auto* new_restore_block = restore_blocks->elements + (restore_blocks->count - 1);
-               *new_restore_block = restore_block;
-          }else{
+          if(!restore_blocks->insert(&restore_block)){
                LOG("ran out of memory trying to allocate %d restore blocks\n", restore_blocks->count + 1);
           }
      }
@@ -69,11 +63,11 @@ bool player_block_push_add_ordered_physical_reqs(PlayerBlockPush_t* player_block
 }
 
 bool player_block_push_add_ordered_entangled_reqs(PlayerBlockPush_t* player_block_push,
-                                                  ObjectArray_t<PlayerBlockPush_t>* player_block_pushes,
-                                                  World_t* world, ObjectArray_t<PlayerBlockPush_t*>* ordered_player_block_pushes,
-                                                  ObjectArray_t<RestoreBlock_t>* restore_blocks){
+                                                  FrameArray_t<PlayerBlockPush_t>* player_block_pushes,
+                                                  World_t* world, FrameArray_t<PlayerBlockPush_t*>* ordered_player_block_pushes,
+                                                  FrameArray_t<RestoreBlock_t>* restore_blocks){
      if(player_block_push->is_entangled()){
-          auto* entangled_player_block_push = player_block_pushes->elements + player_block_push->entangled_push_index;
+          auto* entangled_player_block_push = player_block_pushes->objects + player_block_push->entangled_push_index;
           if(!player_block_push_add_ordered_physical_reqs(entangled_player_block_push, player_block_pushes, world,
                                                           ordered_player_block_pushes, restore_blocks)){
                return false;
@@ -82,29 +76,31 @@ bool player_block_push_add_ordered_entangled_reqs(PlayerBlockPush_t* player_bloc
 
      return true;
 }
-void add_pushes_for_against_results(BlockPushResult_t* push_result, ObjectArray_t<PlayerBlockPush_t>* player_block_pushes,
+
+void add_pushes_for_against_results(BlockPushResult_t* push_result, FrameArray_t<PlayerBlockPush_t>* player_block_pushes,
                                     S16 player_index, AllowedToPushResult_t* allowed_to_push_result, World_t* world){
      for(S16 a = 0; a < push_result->againsts_pushed.count; a++){
-          if(!resize(player_block_pushes, player_block_pushes->count + 1)){
+          if(!player_block_pushes->resize(player_block_pushes->count + 1)){
                LOG("%d: Ran out of memory trying to do player %d block pushes...\n", __LINE__, player_block_pushes->count + 1);
           }else{
                S16 against_entangled_push_index = (player_block_pushes->count - 1);
-               auto* player_block_push = player_block_pushes->elements + against_entangled_push_index;
+               auto* player_block_push = player_block_pushes->objects + against_entangled_push_index;
                player_block_push->performed = false;
                player_block_push->entangled_push_index = -1;
                player_block_push->player_index = player_index;
-               player_block_push->block_index = push_result->againsts_pushed.objects[a].block - world->blocks.elements;
+               player_block_push->block_index = push_result->againsts_pushed.objects[a].block.index;
                player_block_push->direction = push_result->againsts_pushed.objects[a].direction;
                player_block_push->allowed_to_push = *allowed_to_push_result;
 
-               add_entangled_player_block_pushes(player_block_pushes, push_result->againsts_pushed.objects[a].block,
+               add_entangled_player_block_pushes(player_block_pushes,
+                                                 block_from_handle(&world->blocks, push_result->againsts_pushed.objects[a].block),
                                                  push_result->againsts_pushed.objects[a].direction, allowed_to_push_result,
                                                  player_index, against_entangled_push_index, world);
           }
      }
 }
 
-void add_entangled_player_block_pushes(ObjectArray_t<PlayerBlockPush_t>* player_block_pushes,
+void add_entangled_player_block_pushes(FrameArray_t<PlayerBlockPush_t>* player_block_pushes,
                                        Block_t* block_to_push, Direction_t push_direction,
                                        AllowedToPushResult_t* allowed_to_push_result, S16 player_index,
                                        S16 entangled_push_index, World_t* world){
@@ -126,7 +122,7 @@ void add_entangled_player_block_pushes(ObjectArray_t<PlayerBlockPush_t>* player_
           S16 entangle_index = block_to_push->entangle_index;
           while(entangle_index != (S16)(original_block_index) && entangle_index >= 0){
                Block_t* entangled_block = world->blocks.elements + entangle_index;
-               bool held_down = block_held_down_by_another_block(entangled_block, world->block_qt, world->interactive_qt, &world->tilemap).held();
+               bool held_down = block_held_down_by_another_block(entangled_block, world->block_qt, &world->blocks, world->interactive_qt, &world->tilemap).held();
                bool on_frictionless = block_on_frictionless(entangled_block, &world->tilemap, world->interactive_qt, world->block_qt);
                if(!held_down || on_frictionless){
                     auto rotations_between = direction_rotations_between((Direction_t)(entangled_block->rotation), (Direction_t)(block_to_push->rotation));
@@ -137,13 +133,13 @@ void add_entangled_player_block_pushes(ObjectArray_t<PlayerBlockPush_t>* player_
 
                     auto entangle_allowed_result = allowed_to_push(world, entangled_block, rotated_dir, entangled_mass_ratio);
                     if(entangle_allowed_result.push){
-                         if(!resize(player_block_pushes, player_block_pushes->count + 1)){
+                         if(!player_block_pushes->resize(player_block_pushes->count + 1)){
                               LOG("%d: Ran out of memory trying to do player %d block pushes...\n", __LINE__, player_block_pushes->count + 1);
                          }else{
                               // update entangled allowed result mass ratio because that is the force we are going to be using for our push
                               entangle_allowed_result.mass_ratio = allowed_to_push_result->mass_ratio * entangled_mass_ratio * entangle_allowed_result.mass_ratio;
 
-                              auto* player_block_push = player_block_pushes->elements + (player_block_pushes->count - 1);
+                              auto* player_block_push = player_block_pushes->objects + (player_block_pushes->count - 1);
                               player_block_push->performed = false;
                               player_block_push->entangled_push_index = entangled_push_index;
                               player_block_push->player_index = player_index;
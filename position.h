@@ -2,6 +2,7 @@
 
 #include "pixel.h"
 #include "vec.h"
+#include "defines.h"
 
 struct Position_t{
      Pixel_t pixel;
@@ -9,26 +10,177 @@ struct Position_t{
      S8 z; // TODO: rename to height
 };
 
-Position_t pixel_pos(Pixel_t pixel);
-void canonicalize(Position_t* position);
-void negate(Position_t* position);
-Position_t operator+(Position_t p, Vec_t v);
-Position_t operator-(Position_t p, Vec_t v);
-Position_t operator+(Position_t p, Pixel_t i);
-Position_t operator-(Position_t p, Pixel_t i);
-void operator+=(Position_t& p, Vec_t v);
-void operator-=(Position_t& p, Vec_t v);
-Position_t operator+(Position_t a, Position_t b);
-Position_t operator-(Position_t a, Position_t b);
-void operator+=(Position_t& a, Position_t b);
-void operator-=(Position_t& a, Position_t b);
-bool operator==(Position_t a, Position_t b);
-Position_t operator*(Position_t p, float scale);
-F32 pos_x_unit(Position_t p);
-F32 pos_y_unit(Position_t p);
-F32 distance_between(Position_t a, Position_t b);
-
-bool position_x_less_than(Position_t a, Position_t b);
-bool position_x_greater_than(Position_t a, Position_t b);
-bool position_y_less_than(Position_t a, Position_t b);
-bool position_y_greater_than(Position_t a, Position_t b);
+// building with FIXED_POINT_POSITIONS rounds the sub pixel part of positions to the nearest of 2^POSITION_FIXED_SHIFT
+// steps per pixel and carries whole pixels with integer math. The steps are still F32 and PIXEL_SIZE / 65536 is not
+// exactly representable, and velocity and acceleration stay plain floats, so this only narrows drift, it does not
+// make replays bit exact across compilers or optimization levels. Demos recorded in a FIXED build do not replay in
+// the default build and the other way around.
+#define POSITION_FIXED_SHIFT 16
+#define POSITION_FIXED_STEPS (1 << POSITION_FIXED_SHIFT)
+#define POSITION_FIXED_STEP (PIXEL_SIZE / (F32)(POSITION_FIXED_STEPS))
+#define POSITION_FIXED_STEPS_PER_UNIT ((F32)(POSITION_FIXED_STEPS) / PIXEL_SIZE)
+
+constexpr Position_t pixel_pos(Pixel_t pixel){return Position_t{pixel, Vec_t{0.0f, 0.0f}, 0};}
+
+#ifdef FIXED_POINT_POSITIONS
+
+// the masked off steps are the non-negative remainder, even for negative decimals, so there is nothing to fix up.
+// The remainder is turned back into an F32, which is the closest float to that step, not the step itself
+inline void canonicalize_axis(S16* pixel, F32* decimal){
+     S64 steps = llrintf(*decimal * POSITION_FIXED_STEPS_PER_UNIT);
+     S64 remainder = steps & (POSITION_FIXED_STEPS - 1);
+     *pixel += (S16)((steps - remainder) / POSITION_FIXED_STEPS);
+     *decimal = (F32)(remainder) * POSITION_FIXED_STEP;
+}
+
+// rounds to the float closest to the nearest step of the fixed grid
+inline F32 position_fixed_snap(F32 value){
+     return (F32)(llrintf(value * POSITION_FIXED_STEPS_PER_UNIT)) * POSITION_FIXED_STEP;
+}
+
+#else
+
+// almost every decimal is already in range, so that is the one branch we normally take. Past it, a decimal at or past
+// PIXEL_SIZE leaves fmod() with a non-negative remainder that the fix ups below leave alone
+inline void canonicalize_axis(S16* pixel, F32* decimal){
+     if(!(*decimal >= PIXEL_SIZE || *decimal < 0.0f)) return;
+
+     F32 pixels = (F32)(floor(*decimal / PIXEL_SIZE));
+     *pixel += (S16)(pixels);
+     *decimal = (F32)(fmod(*decimal, PIXEL_SIZE));
+     if(*decimal < 0.0f) *decimal += PIXEL_SIZE;
+     else if(*decimal == -0.0f) *decimal = 0.0f;
+}
+
+inline F32 position_fixed_snap(F32 value){
+     return value;
+}
+
+#endif
+
+inline void canonicalize(Position_t* position){
+     canonicalize_axis(&position->pixel.x, &position->decimal.x);
+     canonicalize_axis(&position->pixel.y, &position->decimal.y);
+}
+
+inline void negate(Position_t* position){
+     position->pixel.x = -position->pixel.x;
+     position->pixel.y = -position->pixel.y;
+     position->decimal.x = -position->decimal.x;
+     position->decimal.y = -position->decimal.y;
+     canonicalize(position);
+}
+
+inline Position_t operator+(Position_t p, Vec_t v){
+     p.decimal += v;
+     canonicalize(&p);
+     return p;
+}
+
+inline Position_t operator-(Position_t p, Vec_t v){
+     p.decimal -= v;
+     canonicalize(&p);
+     return p;
+}
+
+constexpr Position_t operator+(Position_t p, Pixel_t i){return Position_t{p.pixel + i, p.decimal, p.z};}
+constexpr Position_t operator-(Position_t p, Pixel_t i){return Position_t{p.pixel - i, p.decimal, p.z};}
+
+inline void operator+=(Position_t& p, Vec_t v){
+     p.decimal += v;
+     canonicalize(&p);
+}
+
+inline void operator-=(Position_t& p, Vec_t v){
+     p.decimal -= v;
+     canonicalize(&p);
+}
+
+inline Position_t operator+(Position_t a, Position_t b){
+     Position_t p {};
+
+     p.pixel = a.pixel + b.pixel;
+     p.decimal = a.decimal + b.decimal;
+     p.z = a.z + b.z;
+
+     canonicalize(&p);
+     return p;
+}
+
+inline Position_t operator-(Position_t a, Position_t b){
+     Position_t p {};
+
+     p.pixel = a.pixel - b.pixel;
+     p.decimal = a.decimal - b.decimal;
+     p.z = a.z - b.z;
+
+     canonicalize(&p);
+     return p;
+}
+
+inline void operator+=(Position_t& a, Position_t b){
+     a.pixel += b.pixel;
+     a.decimal += b.decimal;
+     canonicalize(&a);
+}
+
+inline void operator-=(Position_t& a, Position_t b){
+     a.pixel -= b.pixel;
+     a.decimal -= b.decimal;
+     canonicalize(&a);
+}
+
+constexpr bool operator==(Position_t a, Position_t b){
+     return a.pixel == b.pixel && a.decimal == b.decimal && a.z == b.z;
+}
+
+// NOTE: only call with small positions < 1
+inline Position_t operator*(Position_t p, float scale){
+     float x_value = (float)(p.pixel.x) * PIXEL_SIZE + p.decimal.x;
+     x_value *= scale;
+     p.pixel.x = 0;
+     p.decimal.x = x_value;
+
+     float y_value = (float)(p.pixel.y) * PIXEL_SIZE + p.decimal.y;
+     y_value *= scale;
+     p.pixel.y = 0;
+     p.decimal.y = y_value;
+
+     canonicalize(&p);
+     return p;
+}
+
+constexpr F32 pos_x_unit(Position_t p){return (F32)(p.pixel.x) * PIXEL_SIZE + p.decimal.x;}
+constexpr F32 pos_y_unit(Position_t p){return (F32)(p.pixel.y) * PIXEL_SIZE + p.decimal.y;}
+
+inline F32 distance_between(Position_t a, Position_t b){
+     Position_t diff = b - a;
+     F32 x_diff = (diff.pixel.x) * PIXEL_SIZE + diff.decimal.x;
+     F32 y_diff = (diff.pixel.y) * PIXEL_SIZE + diff.decimal.y;
+     return sqrt((x_diff * x_diff) + (y_diff * y_diff));
+}
+
+constexpr bool position_x_less_than(Position_t a, Position_t b){
+     return a.pixel.x < b.pixel.x || (a.pixel.x == b.pixel.x && a.decimal.x < b.decimal.x);
+}
+
+constexpr bool position_x_greater_than(Position_t a, Position_t b){
+     return a.pixel.x > b.pixel.x || (a.pixel.x == b.pixel.x && a.decimal.x > b.decimal.x);
+}
+
+constexpr bool position_y_less_than(Position_t a, Position_t b){
+     return a.pixel.y < b.pixel.y || (a.pixel.y == b.pixel.y && a.decimal.y < b.decimal.y);
+}
+
+constexpr bool position_y_greater_than(Position_t a, Position_t b){
+     return a.pixel.y > b.pixel.y || (a.pixel.y == b.pixel.y && a.decimal.y > b.decimal.y);
+}
+
+// batched versions for arrays of positions, the same as calling the single versions on each element
+inline void canonicalize(Position_t* positions, S32 count){
+     for(S32 i = 0; i < count; i++) canonicalize(positions + i);
+}
+
+inline void positions_add(Position_t* positions, const Vec_t* deltas, S32 count){
+     for(S32 i = 0; i < count; i++) positions[i] += deltas[i];
+}
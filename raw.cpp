@@ -5,6 +5,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 Raw_t raw_load_file(const char* filename)
 {
@@ -50,3 +54,38 @@ bool raw_save_file(Raw_t* raw, const char* filepath){
     fclose(file);
     return true;
 }
+
+Raw_t raw_map_file(const char* filename){
+     Raw_t raw {};
+
+     int fd = open(filename, O_RDONLY);
+     if(fd < 0){
+          LOG("%s() failed to open '%s': %s\n", __FUNCTION__, filename, strerror(errno));
+          return raw;
+     }
+
+     struct stat file_stat;
+     if(fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0){
+          LOG("%s() failed to stat '%s': %s\n", __FUNCTION__, filename, strerror(errno));
+          close(fd);
+          return raw;
+     }
+
+     void* bytes = mmap(nullptr, (size_t)(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+     close(fd); // the mapping keeps the file alive
+
+     if(bytes == MAP_FAILED){
+          LOG("%s() failed to mmap '%s': %s\n", __FUNCTION__, filename, strerror(errno));
+          return raw;
+     }
+
+     raw.bytes = (U8*)(bytes);
+     raw.byte_count = (U64)(file_stat.st_size);
+     return raw;
+}
+
+void raw_unmap_file(Raw_t* raw){
+     if(raw->bytes) munmap(raw->bytes, (size_t)(raw->byte_count));
+     raw->bytes = nullptr;
+     raw->byte_count = 0;
+}
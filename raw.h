@@ -9,3 +9,7 @@ struct Raw_t{
 
 Raw_t raw_load_file(const char* filename);
 bool raw_save_file(Raw_t* raw, const char* filename);
+
+// map the file read only into memory rather than reading it, must be released with raw_unmap_file()
+Raw_t raw_map_file(const char* filename);
+void raw_unmap_file(Raw_t* raw);
@@ -0,0 +1,113 @@
+#!/usr/bin/python
+
+# batch runner: runs ./game -solve over every map in content/ on all cores, one headless process per map, and prints
+# the results in map order so runs can be diffed regardless of which map finished first. The cores are only shared
+# between maps, the search for a single map is still one thread inside the game, so a batch takes at least as long as
+# its slowest map
+
+import argparse
+import multiprocessing
+import multiprocessing.pool
+import os
+import re
+import subprocess
+import sys
+
+SOLUTION_RE = re.compile(r"solver: found a solution of (\d+) actions across (\d+) frames after exploring (\d+) states")
+REFERENCE_RE = re.compile(r"solver: (shortcut, )?the recorded demo takes (\d+) frames")
+STATES_RE = re.compile(r"after exploring (\d+) states")
+
+def find_maps(first, last):
+    maps = []
+    all_files = os.listdir("content")
+    i = first
+    while i <= last:
+         map_number = "%03d" % i
+         for f in all_files:
+              if f.startswith(map_number) and f.endswith(".bm"):
+                   maps.append(i)
+                   break
+         i = i + 1
+    return maps
+
+# the recorded demo length is the best guess we have at how long a map takes to solve, start the slowest first so
+# one long map doesn't end up running alone at the end
+def estimated_cost(map_number):
+    demo = "content/%03d.bd" % map_number
+    if os.path.exists(demo):
+         return os.path.getsize(demo)
+    return 0
+
+def solve(job):
+    map_number, args = job
+    solution = os.path.join(args.out, "%03d.bd" % map_number)
+    log = os.path.join(args.out, "%03d.log" % map_number)
+    cmd = [args.game, "-solve", "-map", str(map_number), "-record", solution, "-log", log,
+           "-solvemaxnodes", str(args.maxnodes), "-solvedepth", str(args.depth)]
+    if args.bfs:
+         cmd.append("-solvebfs")
+
+    process = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    output = process.communicate()[0].decode("utf-8", "replace")
+
+    result = {"map": map_number, "solved": process.returncode == 0, "actions": "-", "frames": "-", "states": "-",
+              "reference": "-", "shortcut": False}
+    match = SOLUTION_RE.search(output)
+    if match:
+         result["actions"] = match.group(1)
+         result["frames"] = match.group(2)
+         result["states"] = match.group(3)
+    else:
+         match = STATES_RE.search(output)
+         if match:
+              result["states"] = match.group(1)
+    match = REFERENCE_RE.search(output)
+    if match:
+         result["shortcut"] = match.group(1) is not None
+         result["reference"] = match.group(2)
+    return result
+
+def main():
+    parser = argparse.ArgumentParser(description="solve every map headless, one single threaded solver process per map")
+    parser.add_argument("-j", type=int, default=multiprocessing.cpu_count(), help="how many maps to solve at once")
+    parser.add_argument("-first", type=int, default=1)
+    parser.add_argument("-last", type=int, default=249)
+    parser.add_argument("-maxnodes", type=int, default=200000)
+    parser.add_argument("-depth", type=int, default=400)
+    parser.add_argument("-bfs", action="store_true")
+    parser.add_argument("-out", default="solutions", help="directory for the solution demos and logs")
+    parser.add_argument("-game", default="./game")
+    args = parser.parse_args()
+
+    if not os.path.isdir(args.out):
+         os.makedirs(args.out)
+
+    maps = find_maps(args.first, args.last)
+    maps.sort(key=estimated_cost, reverse=True)
+
+    # each worker pulls the next map as soon as it is done, so fast maps never wait behind slow ones
+    pool = multiprocessing.pool.ThreadPool(args.j)
+    results = []
+    for result in pool.imap_unordered(solve, [(m, args) for m in maps], 1):
+         results.append(result)
+         sys.stderr.write("%d/%d\r" % (len(results), len(maps)))
+    pool.close()
+    pool.join()
+
+    results.sort(key=lambda r: r["map"])
+    print("map solved actions frames demo_frames states")
+    solved_count = 0
+    shortcut_count = 0
+    for r in results:
+         if r["solved"]:
+              solved_count = solved_count + 1
+         if r["shortcut"]:
+              shortcut_count = shortcut_count + 1
+         print("%03d %s %s %s %s %s%s" % (r["map"], "yes" if r["solved"] else "no", r["actions"], r["frames"],
+                                        r["reference"], r["states"], " shortcut" if r["shortcut"] else ""))
+    print("solved %d of %d maps, %d shorter than their recorded demo" % (solved_count, len(results), shortcut_count))
+
+    if solved_count != len(results):
+         sys.exit(1)
+
+main()
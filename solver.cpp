@@ -0,0 +1,641 @@
+#include "solver.h"
+#include "defines.h"
+#include "conversion.h"
+#include "utils.h"
+#include "log.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#define SOLVER_SHOOT_HOLD_FRAMES ((S32)(PLAYER_BOW_DRAW_DELAY / FRAME_TIME) + 2)
+#define SOLVER_VISITED_MIN_CAPACITY 4096
+#define SOLVER_HASH_PRIME 1099511628211ULL
+
+// stands in for the record demo while searching, its mode is never DEMO_MODE_RECORD so nothing gets written
+static Demo_t solver_no_demo;
+
+// fnv-1a like the demo checksums, but 64 bits wide since we compare hundreds of thousands of states
+static U64 solver_hash_bytes(U64 hash, const void* data, size_t size){
+     const U8* bytes = (const U8*)(data);
+     for(size_t i = 0; i < size; i++){
+          hash ^= bytes[i];
+          hash *= SOLVER_HASH_PRIME;
+     }
+     return hash;
+}
+
+#define SOLVER_HASH_VALUE(hash, value) hash = solver_hash_bytes(hash, &(value), sizeof(value))
+#define SOLVER_HASH_START 14695981039346656037ULL
+
+// only what can change the outcome of the puzzle goes in, the player is reduced to the tile it is standing on so
+// arriving at the same tile a few pixels apart is the same state
+U64 solver_hash_world(World_t* world){
+     U64 hash = SOLVER_HASH_START;
+
+     // only the flags that change during play, 64 tiles at a time, the planes after solid are contiguous
+     U64* dynamic_planes = tilemap_flag_plane(&world->tilemap, TILE_FLAG_PLANE_ICED);
+     S32 dynamic_words = tilemap_flag_plane_words(&world->tilemap) * (TILE_FLAG_PLANE_COUNT - TILE_FLAG_PLANE_ICED);
+     for(S32 i = 0; i < dynamic_words; i++){
+          hash = (hash ^ dynamic_planes[i]) * SOLVER_HASH_PRIME;
+          hash ^= hash >> 32;
+     }
+
+     for(S16 i = 0; i < world->interactives.count; i++){
+          Interactive_t* interactive = world->interactives.elements + i;
+          switch(interactive->type){
+          default:
+               break;
+          case INTERACTIVE_TYPE_PRESSURE_PLATE:
+               SOLVER_HASH_VALUE(hash, interactive->pressure_plate.down);
+               break;
+          case INTERACTIVE_TYPE_ICE_DETECTOR:
+          case INTERACTIVE_TYPE_LIGHT_DETECTOR:
+               SOLVER_HASH_VALUE(hash, interactive->detector.on);
+               break;
+          case INTERACTIVE_TYPE_POPUP:
+               SOLVER_HASH_VALUE(hash, interactive->popup.iced);
+               SOLVER_HASH_VALUE(hash, interactive->popup.lift.up);
+               break;
+          case INTERACTIVE_TYPE_DOOR:
+               SOLVER_HASH_VALUE(hash, interactive->door.lift.up);
+               break;
+          case INTERACTIVE_TYPE_PORTAL:
+               SOLVER_HASH_VALUE(hash, interactive->portal.on);
+               break;
+          case INTERACTIVE_TYPE_PIT:
+               SOLVER_HASH_VALUE(hash, interactive->pit.iced);
+               break;
+          }
+     }
+
+     // blocks are summed so the hash doesn't depend on their order in the array
+     U64 block_sum = 0;
+     for(S16 i = 0; i < world->blocks.count; i++){
+          Block_t* block = world->blocks.elements + i;
+          U64 block_hash = SOLVER_HASH_START;
+          SOLVER_HASH_VALUE(block_hash, block->pos.pixel.x);
+          SOLVER_HASH_VALUE(block_hash, block->pos.pixel.y);
+          SOLVER_HASH_VALUE(block_hash, block->pos.z);
+          SOLVER_HASH_VALUE(block_hash, block->element);
+          SOLVER_HASH_VALUE(block_hash, block->cut);
+          block_sum += block_hash;
+     }
+     SOLVER_HASH_VALUE(hash, block_sum);
+     SOLVER_HASH_VALUE(hash, world->blocks.count);
+
+     SOLVER_HASH_VALUE(hash, world->players.count);
+     for(S16 i = 0; i < world->players.count; i++){
+          Player_t* player = world->players.elements + i;
+          Coord_t coord = pos_to_coord(player->pos);
+          SOLVER_HASH_VALUE(hash, coord.x);
+          SOLVER_HASH_VALUE(hash, coord.y);
+          SOLVER_HASH_VALUE(hash, player->pos.z);
+          SOLVER_HASH_VALUE(hash, player->face);
+          SOLVER_HASH_VALUE(hash, player->has_bow);
+     }
+
+     // 0 marks an empty slot in the visited set
+     if(hash == 0) hash = 1;
+     return hash;
+}
+
+static bool solver_visited_grow(SolverVisited_t* visited){
+     S64 new_capacity = visited->capacity ? visited->capacity * 2 : SOLVER_VISITED_MIN_CAPACITY;
+     U64* new_hashes = (U64*)(calloc(new_capacity, sizeof(*new_hashes)));
+     if(!new_hashes){
+          LOG("%s() failed to allocate %" PRId64 " state hashes\n", __FUNCTION__, new_capacity);
+          return false;
+     }
+
+     for(S64 i = 0; i < visited->capacity; i++){
+          U64 hash = visited->hashes[i];
+          if(!hash) continue;
+          S64 slot = (S64)(hash & (U64)(new_capacity - 1));
+          while(new_hashes[slot]) slot = (slot + 1) & (new_capacity - 1);
+          new_hashes[slot] = hash;
+     }
+
+     free(visited->hashes);
+     visited->hashes = new_hashes;
+     visited->capacity = new_capacity;
+     return true;
+}
+
+enum SolverVisitedInsert_t{
+     SOLVER_VISITED_INSERT_NEW,
+     SOLVER_VISITED_INSERT_SEEN,
+     SOLVER_VISITED_INSERT_FAILED, // the set couldn't grow, so we can't tell, which must not be mistaken for seen
+};
+
+static SolverVisitedInsert_t solver_visited_insert(SolverVisited_t* visited, U64 hash){
+     if((visited->count + 1) * 2 > visited->capacity){
+          if(!solver_visited_grow(visited)) return SOLVER_VISITED_INSERT_FAILED;
+     }
+
+     S64 slot = (S64)(hash & (U64)(visited->capacity - 1));
+     while(visited->hashes[slot]){
+          if(visited->hashes[slot] == hash) return SOLVER_VISITED_INSERT_SEEN;
+          slot = (slot + 1) & (visited->capacity - 1);
+     }
+
+     visited->hashes[slot] = hash;
+     visited->count++;
+     return SOLVER_VISITED_INSERT_NEW;
+}
+
+static WorldSnapshot_t* solver_snapshot_take(World_t* world){
+     WorldSnapshot_t* snapshot = (WorldSnapshot_t*)(malloc(sizeof(*snapshot)));
+     if(!snapshot){
+          LOG("%s() failed to allocate snapshot\n", __FUNCTION__);
+          return nullptr;
+     }
+
+     *snapshot = WorldSnapshot_t{};
+     if(!world_snapshot(world, snapshot)){
+          free(snapshot);
+          return nullptr;
+     }
+     return snapshot;
+}
+
+static void solver_snapshot_free(WorldSnapshot_t* snapshot){
+     if(!snapshot) return;
+     destroy(snapshot);
+     free(snapshot);
+}
+
+static bool solver_open_less(const SolverOpen_t* a, const SolverOpen_t* b){
+     if(a->priority != b->priority) return a->priority < b->priority;
+     return a->order < b->order;
+}
+
+static bool solver_open_push(Solver_t* solver, S32 node, S32 priority){
+     if(solver->open_count >= solver->open_capacity){
+          S32 new_capacity = solver->open_capacity ? solver->open_capacity * 2 : SOLVER_VISITED_MIN_CAPACITY;
+          SolverOpen_t* new_open = (SolverOpen_t*)(realloc(solver->open, new_capacity * sizeof(*new_open)));
+          if(!new_open){
+               LOG("%s() failed to realloc %d open nodes\n", __FUNCTION__, new_capacity);
+               return false;
+          }
+          solver->open = new_open;
+          solver->open_capacity = new_capacity;
+     }
+
+     S32 index = solver->open_count++;
+     solver->open[index] = SolverOpen_t{priority, solver->open_order++, node};
+
+     // sift up
+     while(index > 0){
+          S32 parent = (index - 1) / 2;
+          if(!solver_open_less(solver->open + index, solver->open + parent)) break;
+          SolverOpen_t tmp = solver->open[parent];
+          solver->open[parent] = solver->open[index];
+          solver->open[index] = tmp;
+          index = parent;
+     }
+     return true;
+}
+
+static S32 solver_open_pop(Solver_t* solver){
+     S32 node = solver->open[0].node;
+     solver->open_count--;
+     solver->open[0] = solver->open[solver->open_count];
+
+     // sift down
+     S32 index = 0;
+     while(true){
+          S32 smallest = index;
+          S32 left = index * 2 + 1;
+          S32 right = left + 1;
+          if(left < solver->open_count && solver_open_less(solver->open + left, solver->open + smallest)) smallest = left;
+          if(right < solver->open_count && solver_open_less(solver->open + right, solver->open + smallest)) smallest = right;
+          if(smallest == index) break;
+          SolverOpen_t tmp = solver->open[smallest];
+          solver->open[smallest] = solver->open[index];
+          solver->open[index] = tmp;
+          index = smallest;
+     }
+     return node;
+}
+
+static S32 solver_add_node(Solver_t* solver, S32 parent, SolverAction_t action, S32 depth, S64 frames,
+                           WorldSnapshot_t* snapshot){
+     if(solver->node_count >= solver->node_capacity){
+          S32 new_capacity = solver->node_capacity ? solver->node_capacity * 2 : SOLVER_VISITED_MIN_CAPACITY;
+          SolverNode_t* new_nodes = (SolverNode_t*)(realloc(solver->nodes, new_capacity * sizeof(*new_nodes)));
+          if(!new_nodes){
+               LOG("%s() failed to realloc %d nodes\n", __FUNCTION__, new_capacity);
+               return -1;
+          }
+          solver->nodes = new_nodes;
+          solver->node_capacity = new_capacity;
+     }
+
+     S32 index = solver->node_count++;
+     solver->nodes[index] = SolverNode_t{parent, action, depth, frames, snapshot};
+     return index;
+}
+
+// manhattan distance from the player to the closest stairs, each move only takes us a tile so this rarely overestimates
+static S32 solver_heuristic(Solver_t* solver, World_t* world){
+     if(solver->breadth_first || world->players.count == 0) return 0;
+
+     Coord_t player_coord = pos_to_coord(world->players.elements[0].pos);
+     S32 closest = 0x7FFFFFFF;
+     for(S16 i = 0; i < solver->stairs.count; i++){
+          Coord_t stairs = solver->stairs.elements[i];
+          S32 distance = abs(stairs.x - player_coord.x) + abs(stairs.y - player_coord.y);
+          if(distance < closest) closest = distance;
+     }
+     return closest;
+}
+
+static bool solver_world_at_rest(World_t* world){
+     for(S16 i = 0; i < world->players.count; i++){
+          Player_t* player = world->players.elements + i;
+          if(player->vel.x != 0 || player->vel.y != 0) return false;
+          if(player->pos_delta.x != 0 || player->pos_delta.y != 0) return false;
+          if(player->teleport) return false;
+     }
+
+     for(S16 i = 0; i < world->blocks.count; i++){
+          if(!block_at_rest(world->blocks.elements + i)) return false;
+     }
+
+     for(S16 i = 0; i < ARROW_ARRAY_MAX; i++){
+          Arrow_t* arrow = world->arrows.arrows + i;
+          if(arrow->alive && arrow->stuck_type == STUCK_NONE) return false;
+     }
+
+     // same as what undo_commit() waits for
+     for(S16 i = 0; i < world->interactives.count; i++){
+          Interactive_t* interactive = world->interactives.elements + i;
+          if(interactive->type == INTERACTIVE_TYPE_DOOR){
+               if(interactive->door.lift.up){
+                    if(interactive->door.lift.ticks < DOOR_MAX_HEIGHT) return false;
+               }else{
+                    if(interactive->door.lift.ticks > 0) return false;
+               }
+          }else if(interactive->type == INTERACTIVE_TYPE_POPUP){
+               if(interactive->popup.lift.up){
+                    if(interactive->popup.lift.ticks < (HEIGHT_INTERVAL + 1)) return false;
+               }else{
+                    if(interactive->popup.lift.ticks > 1) return false;
+               }
+          }
+     }
+
+     return true;
+}
+
+// skip actions that can't do anything from here so we don't have to simulate them to find out
+static bool solver_action_possible(SolverAction_t action, World_t* world){
+     if(world->players.count == 0) return false;
+     Player_t* player = world->players.elements;
+
+     switch(action){
+     default:
+          break;
+     case SOLVER_ACTION_ACTIVATE:
+     {
+          Interactive_t* interactive = quad_tree_interactive_find_at(world->interactive_qt,
+                                                                     pos_to_coord(player->pos) + player->face);
+          return interactive && interactive->type == INTERACTIVE_TYPE_LEVER;
+     }
+     case SOLVER_ACTION_SHOOT:
+          return player->has_bow;
+     }
+
+     return true;
+}
+
+static PlayerActionType_t solver_action_start(SolverAction_t action){
+     switch(action){
+     default:
+          break;
+     case SOLVER_ACTION_MOVE_LEFT:
+          return PLAYER_ACTION_TYPE_MOVE_LEFT_START;
+     case SOLVER_ACTION_MOVE_UP:
+          return PLAYER_ACTION_TYPE_MOVE_UP_START;
+     case SOLVER_ACTION_MOVE_RIGHT:
+          return PLAYER_ACTION_TYPE_MOVE_RIGHT_START;
+     case SOLVER_ACTION_MOVE_DOWN:
+          return PLAYER_ACTION_TYPE_MOVE_DOWN_START;
+     case SOLVER_ACTION_ACTIVATE:
+          return PLAYER_ACTION_TYPE_ACTIVATE_START;
+     }
+     return PLAYER_ACTION_TYPE_SHOOT_START;
+}
+
+// every stop action directly follows its start action
+static PlayerActionType_t solver_action_stop(SolverAction_t action){
+     return (PlayerActionType_t)(solver_action_start(action) + 1);
+}
+
+static const char* solver_action_to_string(SolverAction_t action){
+     switch(action){
+     default:
+          break;
+     case SOLVER_ACTION_MOVE_LEFT:
+          return "left";
+     case SOLVER_ACTION_MOVE_UP:
+          return "up";
+     case SOLVER_ACTION_MOVE_RIGHT:
+          return "right";
+     case SOLVER_ACTION_MOVE_DOWN:
+          return "down";
+     case SOLVER_ACTION_ACTIVATE:
+          return "activate";
+     case SOLVER_ACTION_SHOOT:
+          return "shoot";
+     }
+     return "unknown";
+}
+
+static void solver_start_action(Solver_t* solver, SolverAction_t action, World_t* world){
+     solver->action = action;
+     solver->phase = SOLVER_PHASE_HOLD;
+     solver->phase_frames = 0;
+     solver->action_frames = 0;
+     solver->action_start_coord = world->players.count ? pos_to_coord(world->players.elements[0].pos) : Coord_t{-1, -1};
+}
+
+// let go of a move once the player has crossed into the next tile and will coast to a stop near its center
+static bool solver_move_should_release(Solver_t* solver, World_t* world){
+     if(solver->phase_frames >= SOLVER_MAX_HOLD_FRAMES) return true;
+     if(world->players.count == 0) return true;
+
+     Player_t* player = world->players.elements;
+     Coord_t coord = pos_to_coord(player->pos);
+     if(coord == solver->action_start_coord) return false;
+
+     Vec_t to_center = pos_to_vec(coord_to_pos_at_tile_center(coord) - player->pos);
+     Vec_t move = direction_to_vec((Direction_t)(solver->action));
+     F32 remaining = to_center.x * move.x + to_center.y * move.y;
+     return remaining <= PLAYER_ACCEL_DISTANCE;
+}
+
+// moves on to the next action to simulate, restoring the world to the decision point it starts from
+static SolverStatus_t solver_next_work(Solver_t* solver, World_t* world, PlayerAction_t* player_action){
+     while(true){
+          if(solver->expanding_node >= 0){
+               SolverNode_t* node = solver->nodes + solver->expanding_node;
+               while(solver->action_index < SOLVER_ACTION_COUNT){
+                    SolverAction_t action = (SolverAction_t)(solver->action_index++);
+                    world_restore(node->snapshot, world);
+                    if(!solver_action_possible(action, world)) continue;
+
+                    *player_action = {};
+                    solver_start_action(solver, action, world);
+                    return SOLVER_STATUS_RESTORED;
+               }
+
+               solver_snapshot_free(node->snapshot);
+               node->snapshot = nullptr;
+               solver->expanding_node = -1;
+          }
+
+          if(solver->open_count == 0){
+               LOG("solver: no solution after exploring %d states over %" PRId64 " simulated frames\n",
+                   solver->node_count, solver->simulated_frames);
+               return SOLVER_STATUS_FAILED;
+          }
+
+          S32 node_index = solver_open_pop(solver);
+          SolverNode_t* node = solver->nodes + node_index;
+          if(node->depth >= solver->max_depth){
+               solver_snapshot_free(node->snapshot);
+               node->snapshot = nullptr;
+               continue;
+          }
+
+          solver->expanding_node = node_index;
+          solver->action_index = 0;
+     }
+}
+
+static bool solver_build_solution(Solver_t* solver){
+     S32 count = 1;
+     for(S32 n = solver->expanding_node; solver->nodes[n].parent >= 0; n = solver->nodes[n].parent) count++;
+
+     solver->solution = (SolverAction_t*)(malloc(count * sizeof(*solver->solution)));
+     if(!solver->solution){
+          LOG("%s() failed to allocate %d actions\n", __FUNCTION__, count);
+          return false;
+     }
+
+     solver->solution_count = count;
+     solver->solution[count - 1] = solver->action;
+     S32 index = count - 2;
+     for(S32 n = solver->expanding_node; solver->nodes[n].parent >= 0; n = solver->nodes[n].parent){
+          solver->solution[index--] = solver->nodes[n].action;
+     }
+
+     solver->solution_frames = solver->nodes[solver->expanding_node].frames + solver->action_frames;
+     return true;
+}
+
+static void solver_log_solution(Solver_t* solver){
+     LOG("solver: found a solution of %d actions across %" PRId64 " frames after exploring %d states over %" PRId64
+         " simulated frames\n", solver->solution_count, solver->solution_frames, solver->node_count,
+         solver->simulated_frames);
+     for(S32 i = 0; i < solver->solution_count; i++){
+          LOG("  %d: %s\n", i, solver_action_to_string(solver->solution[i]));
+     }
+
+     if(solver->reference_frames >= 0){
+          if(solver->solution_frames < solver->reference_frames){
+               LOG("solver: shortcut, the recorded demo takes %" PRId64 " frames\n", solver->reference_frames);
+          }else{
+               LOG("solver: the recorded demo takes %" PRId64 " frames\n", solver->reference_frames);
+          }
+     }
+}
+
+static void solver_load_reference_frames(Solver_t* solver, S16 map_number){
+     const char* demo_filepath = nullptr;
+     FILE* file = load_demo_number(map_number, &demo_filepath);
+     free((void*)(demo_filepath));
+     if(!file) return;
+
+     S32 version = 0;
+     if(fread(&version, sizeof(version), 1, file) == 1){
+          DemoEntries_t entries = demo_entries_get(file, version);
+          if(entries.count > 0) solver->reference_frames = entries.entries[entries.count - 1].frame;
+          free(entries.entries);
+     }
+     fclose(file);
+}
+
+bool solver_begin(Solver_t* solver, World_t* world, S16 map_number){
+     S16 stairs_count = 0;
+     for(S16 i = 0; i < world->interactives.count; i++){
+          if(world->interactives.elements[i].type == INTERACTIVE_TYPE_STAIRS) stairs_count++;
+     }
+
+     if(stairs_count == 0){
+          LOG("solver: the map has no stairs to exit through\n");
+          return false;
+     }
+
+     init(&solver->stairs, stairs_count);
+     stairs_count = 0;
+     for(S16 i = 0; i < world->interactives.count; i++){
+          Interactive_t* interactive = world->interactives.elements + i;
+          if(interactive->type == INTERACTIVE_TYPE_STAIRS) solver->stairs.elements[stairs_count++] = interactive->coord;
+     }
+
+     if(map_number > 0) solver_load_reference_frames(solver, map_number);
+
+     WorldSnapshot_t* snapshot = solver_snapshot_take(world);
+     if(!snapshot) return false;
+
+     S32 root = solver_add_node(solver, -1, SOLVER_ACTION_COUNT, 0, 0, snapshot);
+     if(root < 0){
+          solver_snapshot_free(snapshot);
+          return false;
+     }
+
+     // from here on the node owns the snapshot and destroy() frees it
+     if(solver_visited_insert(&solver->visited, solver_hash_world(world)) == SOLVER_VISITED_INSERT_FAILED) return false;
+     if(!solver_open_push(solver, root, solver_heuristic(solver, world))) return false;
+
+     LOG("solver: searching with %s for one of %d stairs\n", solver->breadth_first ? "bfs" : "a*", solver->stairs.count);
+
+     PlayerAction_t player_action {};
+     return solver_next_work(solver, world, &player_action) == SOLVER_STATUS_RESTORED;
+}
+
+void solver_frame_input(Solver_t* solver, PlayerAction_t* player_action, World_t* world, Demo_t* record_demo,
+                        S64 frame_count){
+     Demo_t* demo = (solver->mode == SOLVER_MODE_RECORDING) ? record_demo : &solver_no_demo;
+
+     switch(solver->phase){
+     default:
+          break;
+     case SOLVER_PHASE_HOLD:
+          if(solver->phase_frames == 0){
+               player_action_perform(player_action, &world->players, solver_action_start(solver->action), demo,
+                                     frame_count);
+          }
+          break;
+     case SOLVER_PHASE_RELEASE:
+          player_action_perform(player_action, &world->players, solver_action_stop(solver->action), demo, frame_count);
+          solver->phase = SOLVER_PHASE_SETTLE;
+          solver->phase_frames = 0;
+          break;
+     }
+}
+
+SolverStatus_t solver_frame_end(Solver_t* solver, World_t* world, PlayerAction_t* player_action, bool reached_exit){
+     solver->simulated_frames++;
+     solver->action_frames++;
+     solver->phase_frames++;
+
+     if(reached_exit){
+          if(solver->mode == SOLVER_MODE_RECORDING){
+               LOG("solver: wrote solution to %s\n", solver->solution_filepath);
+               return SOLVER_STATUS_SOLVED;
+          }
+
+          if(!solver_build_solution(solver)) return SOLVER_STATUS_FAILED;
+          solver_log_solution(solver);
+
+          // replay it from the start so the demo records the inputs along with checksums of the world
+          solver->mode = SOLVER_MODE_RECORDING;
+          solver->solution_index = 0;
+          world_restore(solver->nodes[0].snapshot, world);
+          *player_action = {};
+          solver_start_action(solver, solver->solution[0], world);
+          return SOLVER_STATUS_RECORD;
+     }
+
+     switch(solver->phase){
+     default:
+          break;
+     case SOLVER_PHASE_HOLD:
+     {
+          bool release = false;
+          switch(solver->action){
+          default:
+               release = solver_move_should_release(solver, world);
+               break;
+          case SOLVER_ACTION_ACTIVATE:
+               release = true;
+               break;
+          case SOLVER_ACTION_SHOOT:
+               release = solver->phase_frames >= SOLVER_SHOOT_HOLD_FRAMES;
+               break;
+          }
+          if(release) solver->phase = SOLVER_PHASE_RELEASE;
+          return SOLVER_STATUS_RUNNING;
+     }
+     case SOLVER_PHASE_SETTLE:
+          if(!solver_world_at_rest(world) && solver->phase_frames < SOLVER_MAX_SETTLE_FRAMES) return SOLVER_STATUS_RUNNING;
+          break;
+     }
+
+     // the action is done and the world is at a new decision point
+     if(solver->mode == SOLVER_MODE_RECORDING){
+          solver->solution_index++;
+          if(solver->solution_index >= solver->solution_count){
+               LOG("solver: replaying the solution did not reach the exit\n");
+               return SOLVER_STATUS_FAILED;
+          }
+          solver_start_action(solver, solver->solution[solver->solution_index], world);
+          return SOLVER_STATUS_RUNNING;
+     }
+
+     SolverVisitedInsert_t visited_insert = solver_visited_insert(&solver->visited, solver_hash_world(world));
+     if(visited_insert == SOLVER_VISITED_INSERT_FAILED){
+          LOG("solver: failed to remember state %d, giving up instead of pruning states we haven't seen\n", solver->node_count);
+          return SOLVER_STATUS_FAILED;
+     }
+
+     if(visited_insert == SOLVER_VISITED_INSERT_NEW){
+          if(solver->node_count >= solver->max_nodes){
+               LOG("solver: gave up after exploring %d states over %" PRId64 " simulated frames\n", solver->node_count,
+                   solver->simulated_frames);
+               return SOLVER_STATUS_FAILED;
+          }
+
+          SolverNode_t* parent = solver->nodes + solver->expanding_node;
+          S32 depth = parent->depth + 1;
+          S64 frames = parent->frames + solver->action_frames;
+          WorldSnapshot_t* snapshot = solver_snapshot_take(world);
+          if(!snapshot) return SOLVER_STATUS_FAILED;
+
+          S32 node = solver_add_node(solver, solver->expanding_node, solver->action, depth, frames, snapshot);
+          if(node < 0){
+               solver_snapshot_free(snapshot);
+               return SOLVER_STATUS_FAILED;
+          }
+
+          // the node owns the snapshot now, destroy() frees it
+          if(!solver_open_push(solver, node, depth + solver_heuristic(solver, world))) return SOLVER_STATUS_FAILED;
+     }
+
+     return solver_next_work(solver, world, player_action);
+}
+
+void destroy(Solver_t* solver){
+     for(S32 i = 0; i < solver->node_count; i++){
+          solver_snapshot_free(solver->nodes[i].snapshot);
+     }
+     free(solver->nodes);
+     free(solver->open);
+     free(solver->visited.hashes);
+     free(solver->solution);
+     destroy(&solver->stairs);
+
+     solver->nodes = nullptr;
+     solver->node_count = 0;
+     solver->node_capacity = 0;
+     solver->open = nullptr;
+     solver->open_count = 0;
+     solver->open_capacity = 0;
+     solver->visited = SolverVisited_t{};
+     solver->solution = nullptr;
+     solver->solution_count = 0;
+}
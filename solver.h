@@ -0,0 +1,108 @@
+#pragma once
+
+#include "world.h"
+#include "demo.h"
+
+#define SOLVER_DEFAULT_MAX_NODES 200000
+#define SOLVER_DEFAULT_MAX_DEPTH 400
+#define SOLVER_MAX_HOLD_FRAMES 90 // long enough to push the heaviest block we can a tile
+#define SOLVER_MAX_SETTLE_FRAMES 600
+#define SOLVER_DEFAULT_SOLUTION_FILEPATH "solution.bd"
+
+// the inputs we try at every decision point, moves are held until the player reaches the next tile
+enum SolverAction_t : U8{
+     SOLVER_ACTION_MOVE_LEFT,
+     SOLVER_ACTION_MOVE_UP,
+     SOLVER_ACTION_MOVE_RIGHT,
+     SOLVER_ACTION_MOVE_DOWN,
+     SOLVER_ACTION_ACTIVATE,
+     SOLVER_ACTION_SHOOT,
+     SOLVER_ACTION_COUNT,
+};
+
+enum SolverPhase_t{
+     SOLVER_PHASE_HOLD,
+     SOLVER_PHASE_RELEASE,
+     SOLVER_PHASE_SETTLE,
+};
+
+enum SolverMode_t{
+     SOLVER_MODE_SEARCHING,
+     SOLVER_MODE_RECORDING, // replaying the solution from the start while the demo records it
+};
+
+enum SolverStatus_t{
+     SOLVER_STATUS_RUNNING,
+     SOLVER_STATUS_RESTORED, // the world was put back to an earlier decision point
+     SOLVER_STATUS_RECORD, // the world is back at the start, begin recording the solution
+     SOLVER_STATUS_SOLVED, // the recording reached the exit
+     SOLVER_STATUS_FAILED,
+};
+
+struct SolverNode_t{
+     S32 parent;
+     SolverAction_t action; // that got us here from the parent
+     S32 depth;
+     S64 frames; // since the start
+     WorldSnapshot_t* snapshot; // the world at rest at this decision point, freed once every action has been tried from here
+};
+
+struct SolverOpen_t{
+     S32 priority;
+     S32 order; // ties go to whoever was found first, which keeps the search deterministic
+     S32 node;
+};
+
+// open addressing set of canonical state hashes, 0 marks an empty slot
+struct SolverVisited_t{
+     U64* hashes = nullptr;
+     S64 count = 0;
+     S64 capacity = 0;
+};
+
+struct Solver_t{
+     const char* solution_filepath = SOLVER_DEFAULT_SOLUTION_FILEPATH;
+     S32 max_nodes = SOLVER_DEFAULT_MAX_NODES;
+     S32 max_depth = SOLVER_DEFAULT_MAX_DEPTH;
+     bool breadth_first = false; // otherwise A* guided by the distance to the closest stairs
+
+     SolverMode_t mode = SOLVER_MODE_SEARCHING;
+
+     SolverNode_t* nodes = nullptr;
+     S32 node_count = 0;
+     S32 node_capacity = 0;
+
+     SolverOpen_t* open = nullptr;
+     S32 open_count = 0;
+     S32 open_capacity = 0;
+     S32 open_order = 0;
+
+     SolverVisited_t visited;
+
+     ObjectArray_t<Coord_t> stairs = {};
+
+     // the action being simulated
+     S32 expanding_node = -1;
+     S32 action_index = 0;
+     SolverAction_t action = SOLVER_ACTION_MOVE_LEFT;
+     SolverPhase_t phase = SOLVER_PHASE_HOLD;
+     S32 phase_frames = 0;
+     S64 action_frames = 0;
+     Coord_t action_start_coord;
+
+     // the path from the start to the exit
+     SolverAction_t* solution = nullptr;
+     S32 solution_count = 0;
+     S32 solution_index = 0;
+     S64 solution_frames = 0;
+
+     S64 reference_frames = -1; // how long the map's recorded demo takes, if it has one
+     S64 simulated_frames = 0;
+};
+
+bool solver_begin(Solver_t* solver, World_t* world, S16 map_number);
+void solver_frame_input(Solver_t* solver, PlayerAction_t* player_action, World_t* world, Demo_t* record_demo,
+                        S64 frame_count);
+SolverStatus_t solver_frame_end(Solver_t* solver, World_t* world, PlayerAction_t* player_action, bool reached_exit);
+U64 solver_hash_world(World_t* world);
+void destroy(Solver_t* solver);
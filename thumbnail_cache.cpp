@@ -0,0 +1,168 @@
+#include "thumbnail_cache.h"
+#include "map_index.h"
+#include "draw.h"
+
+#include <cstring>
+
+static void thumbnail_cache_decode_loop(ThumbnailCache_t* cache){
+     while(true){
+          ThumbnailDecode_t decode;
+
+          {
+               std::unique_lock<std::mutex> lock(cache->mutex);
+               cache->condition.wait(lock, [cache]{return cache->quit || cache->pending_count > 0;});
+               if(cache->quit) return;
+
+               // the newest request is most likely still on screen
+               cache->pending_count--;
+               decode = cache->pending[cache->pending_count];
+               cache->decoding_count++;
+          }
+
+          Raw_t raw {};
+          if(map_index_load_thumbnail(decode.map_filepath, decode.thumbnail_offset, decode.thumbnail_size, &raw)){
+               Bitmap_t bitmap = bitmap_load_raw(raw.bytes, raw.byte_count);
+               if(bitmap.raw.byte_count > 0){
+                    decode.bitmap = bitmap_to_alpha_bitmap(&bitmap, BitmapPixel_t{255, 0, 255});
+                    free(bitmap.raw.bytes);
+               }
+               free(raw.bytes);
+          }
+
+          {
+               std::unique_lock<std::mutex> lock(cache->mutex);
+               cache->decoding_count--;
+               cache->decoded[cache->decoded_count] = decode;
+               cache->decoded_count++;
+          }
+     }
+}
+
+bool thumbnail_in_view(MapThumbnail_t* map_thumbnail, Vec_t scroll){
+     // include a row above and below so thumbnails are ready by the time they scroll in
+     F32 y = map_thumbnail->pos.y + scroll.y;
+     return y > -THUMBNAIL_UI_DIMENSION && y < 1.0f + THUMBNAIL_UI_DIMENSION;
+}
+
+bool thumbnail_cache_request(ThumbnailCache_t* cache, MapThumbnail_t* map_thumbnail, S16 map_thumbnail_index){
+     if(map_thumbnail->thumbnail_size == 0){
+          map_thumbnail->texture_state = THUMBNAIL_TEXTURE_STATE_FAILED;
+          return false;
+     }
+
+     {
+          std::unique_lock<std::mutex> lock(cache->mutex);
+
+          // every request needs a slot in the decoded list when it finishes, try again next frame
+          if(cache->pending_count + cache->decoding_count + cache->decoded_count >= THUMBNAIL_CACHE_SIZE) return false;
+
+          auto* decode = cache->pending + cache->pending_count;
+          *decode = ThumbnailDecode_t{};
+          decode->map_thumbnail_index = map_thumbnail_index;
+          decode->map_filepath = map_thumbnail->map_filepath;
+          decode->thumbnail_offset = map_thumbnail->thumbnail_offset;
+          decode->thumbnail_size = map_thumbnail->thumbnail_size;
+          cache->pending_count++;
+     }
+
+     if(!cache->worker.joinable()) cache->worker = std::thread(thumbnail_cache_decode_loop, cache);
+
+     cache->condition.notify_one();
+     map_thumbnail->texture_state = THUMBNAIL_TEXTURE_STATE_DECODING;
+     return true;
+}
+
+static void thumbnail_cache_evict_least_recently_used(ThumbnailCache_t* cache, ObjectArray_t<MapThumbnail_t>* map_thumbnails){
+     S16 oldest = 0;
+     for(S16 t = 1; t < cache->textured_count; t++){
+          auto* map_thumbnail = map_thumbnails->elements + cache->textured[t];
+          auto* oldest_map_thumbnail = map_thumbnails->elements + cache->textured[oldest];
+          if(map_thumbnail->texture_last_used_frame < oldest_map_thumbnail->texture_last_used_frame) oldest = t;
+     }
+
+     auto* map_thumbnail = map_thumbnails->elements + cache->textured[oldest];
+     glDeleteTextures(1, &map_thumbnail->texture);
+     map_thumbnail->texture = 0;
+     map_thumbnail->texture_state = THUMBNAIL_TEXTURE_STATE_NONE;
+
+     cache->textured_count--;
+     cache->textured[oldest] = cache->textured[cache->textured_count];
+}
+
+void thumbnail_cache_update(ThumbnailCache_t* cache, ObjectArray_t<MapThumbnail_t>* map_thumbnails, Vec_t scroll){
+     cache->frame++;
+
+     ThumbnailDecode_t decoded[THUMBNAIL_CACHE_SIZE];
+     S16 decoded_count = 0;
+
+     {
+          std::unique_lock<std::mutex> lock(cache->mutex);
+
+          // drop requests that scrolled out of view before the worker got to them
+          S16 kept_count = 0;
+          for(S16 p = 0; p < cache->pending_count; p++){
+               auto* decode = cache->pending + p;
+               auto* map_thumbnail = map_thumbnails->elements + decode->map_thumbnail_index;
+               if(thumbnail_in_view(map_thumbnail, scroll)){
+                    cache->pending[kept_count] = *decode;
+                    kept_count++;
+               }else{
+                    map_thumbnail->texture_state = THUMBNAIL_TEXTURE_STATE_NONE;
+               }
+          }
+          cache->pending_count = kept_count;
+
+          decoded_count = cache->decoded_count;
+          memcpy(decoded, cache->decoded, decoded_count * sizeof(decoded[0]));
+          cache->decoded_count = 0;
+     }
+
+     for(S16 d = 0; d < decoded_count; d++){
+          auto* decode = decoded + d;
+          auto* map_thumbnail = map_thumbnails->elements + decode->map_thumbnail_index;
+
+          if(!decode->bitmap.pixels){
+               map_thumbnail->texture_state = THUMBNAIL_TEXTURE_STATE_FAILED;
+               continue;
+          }
+
+          if(cache->textured_count >= THUMBNAIL_CACHE_SIZE) thumbnail_cache_evict_least_recently_used(cache, map_thumbnails);
+
+          map_thumbnail->texture = create_texture_from_bitmap(&decode->bitmap);
+          map_thumbnail->texture_state = THUMBNAIL_TEXTURE_STATE_LOADED;
+          map_thumbnail->texture_last_used_frame = cache->frame;
+          free(decode->bitmap.pixels);
+
+          cache->textured[cache->textured_count] = decode->map_thumbnail_index;
+          cache->textured_count++;
+     }
+}
+
+void thumbnail_cache_stop_worker(ThumbnailCache_t* cache){
+     if(!cache->worker.joinable()) return;
+
+     {
+          std::unique_lock<std::mutex> lock(cache->mutex);
+          cache->quit = true;
+     }
+     cache->condition.notify_all();
+     cache->worker.join();
+}
+
+void thumbnail_cache_destroy(ThumbnailCache_t* cache, ObjectArray_t<MapThumbnail_t>* map_thumbnails){
+     thumbnail_cache_stop_worker(cache);
+
+     for(S16 d = 0; d < cache->decoded_count; d++){
+          free(cache->decoded[d].bitmap.pixels);
+     }
+     cache->decoded_count = 0;
+     cache->pending_count = 0;
+
+     for(S16 t = 0; t < cache->textured_count; t++){
+          auto* map_thumbnail = map_thumbnails->elements + cache->textured[t];
+          glDeleteTextures(1, &map_thumbnail->texture);
+          map_thumbnail->texture = 0;
+          map_thumbnail->texture_state = THUMBNAIL_TEXTURE_STATE_NONE;
+     }
+     cache->textured_count = 0;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "object_array.h"
+#include "bitmap.h"
+#include "thumbnail.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// about 8 rows of thumbnails fit on screen, the extra rows cover prefetching and scrolling back a bit
+#define THUMBNAIL_CACHE_ROWS 12
+#define THUMBNAIL_CACHE_SIZE (THUMBNAIL_CACHE_ROWS * THUMBNAILS_PER_ROW)
+
+struct ThumbnailDecode_t{
+     S16 map_thumbnail_index = -1;
+     const char* map_filepath = NULL;
+     U64 thumbnail_offset = 0;
+     U64 thumbnail_size = 0;
+     AlphaBitmap_t bitmap {};
+};
+
+struct ThumbnailCache_t;
+void thumbnail_cache_stop_worker(ThumbnailCache_t* cache);
+
+// decoding happens on a worker thread, the GL upload has to happen on the main thread
+struct ThumbnailCache_t{
+     // map thumbnails that currently own a texture, least recently drawn gets evicted first
+     S16 textured[THUMBNAIL_CACHE_SIZE];
+     S16 textured_count = 0;
+     U64 frame = 0;
+
+     // everything below is guarded by the mutex
+     ThumbnailDecode_t pending[THUMBNAIL_CACHE_SIZE];
+     S16 pending_count = 0;
+     S16 decoding_count = 0;
+     ThumbnailDecode_t decoded[THUMBNAIL_CACHE_SIZE];
+     S16 decoded_count = 0;
+     bool quit = false;
+
+     std::thread worker;
+     std::mutex mutex;
+     std::condition_variable condition;
+
+     // a joinable std::thread terminates the program when destroyed, so stop the worker even on early returns
+     ~ThumbnailCache_t(){
+          thumbnail_cache_stop_worker(this);
+     }
+};
+
+bool thumbnail_in_view(MapThumbnail_t* map_thumbnail, Vec_t scroll);
+bool thumbnail_cache_request(ThumbnailCache_t* cache, MapThumbnail_t* map_thumbnail, S16 map_thumbnail_index);
+void thumbnail_cache_update(ThumbnailCache_t* cache, ObjectArray_t<MapThumbnail_t>* map_thumbnails, Vec_t scroll);
+void thumbnail_cache_destroy(ThumbnailCache_t* cache, ObjectArray_t<MapThumbnail_t>* map_thumbnails);
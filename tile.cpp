@@ -5,16 +5,19 @@
 #include <cstring>
 
 bool init(TileMap_t* tilemap, S16 width, S16 height){
-     tilemap->tiles = (Tile_t**)calloc((size_t)(height), sizeof(*tilemap->tiles));
-     if(!tilemap->tiles) return false;
-
-     for(S16 i = 0; i < height; i++){
-          tilemap->tiles[i] = (Tile_t*)calloc((size_t)(width), sizeof(*tilemap->tiles[i]));
-          if(!tilemap->tiles[i]) return false;
+     S16 row_words = (S16)((width + TILE_FLAG_PLANE_WORD_BITS - 1) / TILE_FLAG_PLANE_WORD_BITS);
+     tilemap->tiles = (Tile_t*)calloc((size_t)(width) * (size_t)(height), sizeof(*tilemap->tiles));
+     tilemap->flag_planes = (U64*)calloc((size_t)(row_words) * (size_t)(height) * TILE_FLAG_PLANE_COUNT, sizeof(*tilemap->flag_planes));
+     if(!tilemap->tiles || !tilemap->flag_planes){
+          free(tilemap->tiles);
+          free(tilemap->flag_planes);
+          memset(tilemap, 0, sizeof(*tilemap));
+          return false;
      }
 
      tilemap->width = width;
      tilemap->height = height;
+     tilemap->flag_plane_row_words = row_words;
 
      return true;
 }
@@ -22,19 +25,13 @@ bool init(TileMap_t* tilemap, S16 width, S16 height){
 void deep_copy(TileMap_t* a, TileMap_t* b){
      destroy(b);
      init(b, a->width, a->height);
-     for(S16 i = 0; i < a->height; i++){
-          for(S16 j = 0; j < a->width; j++){
-               b->tiles[i][j] = a->tiles[i][j];
-          }
-     }
+     memcpy(b->tiles, a->tiles, tilemap_tile_count(a) * sizeof(*a->tiles));
+     memcpy(b->flag_planes, a->flag_planes, tilemap_flag_plane_words(a) * TILE_FLAG_PLANE_COUNT * sizeof(*a->flag_planes));
 }
 
 void destroy(TileMap_t* tilemap){
-     for(S16 i = 0; i < tilemap->height; i++){
-          free(tilemap->tiles[i]);
-     }
-
      free(tilemap->tiles);
+     free(tilemap->flag_planes);
      memset(tilemap, 0, sizeof(*tilemap));
 }
 
@@ -50,7 +47,7 @@ Tile_t* tilemap_get_tile(TileMap_t* tilemap, Coord_t coord){
      if(coord.x < 0 || coord.x >= tilemap->width) return nullptr;
      if(coord.y < 0 || coord.y >= tilemap->height) return nullptr;
 
-     return tilemap->tiles[coord.y] + coord.x;
+     return tilemap_tile(tilemap, coord.x, coord.y);
 }
 
 bool tilemap_is_solid(TileMap_t* tilemap, Coord_t coord){
@@ -246,3 +243,69 @@ U8 tile_flip_solid_id_horizontally_rotation(U8 id, U8 current_rotation){
 
      return current_rotation;
 }
+
+static const U16 tile_flag_plane_flags[TILE_FLAG_PLANE_COUNT] = {
+     TILE_FLAG_SOLID,
+     TILE_FLAG_ICED,
+     TILE_FLAG_WIRE_STATE,
+     TILE_FLAG_WIRE_CLUSTER_LEFT_ON,
+     TILE_FLAG_WIRE_CLUSTER_MID_ON,
+     TILE_FLAG_WIRE_CLUSTER_RIGHT_ON,
+};
+
+void tilemap_build_flag_planes(TileMap_t* tilemap){
+     if(!tilemap->flag_planes) return;
+
+     S32 plane_words = tilemap_flag_plane_words(tilemap);
+     const Tile_t* tile = tilemap->tiles;
+     for(S16 y = 0; y < tilemap->height; y++){
+          for(S16 w = 0; w < tilemap->flag_plane_row_words; w++){
+               U64 words[TILE_FLAG_PLANE_COUNT] = {};
+               S16 x_end = (S16)((w + 1) * TILE_FLAG_PLANE_WORD_BITS);
+               if(x_end > tilemap->width) x_end = tilemap->width;
+
+               U64 bit = 1;
+               for(S16 x = (S16)(w * TILE_FLAG_PLANE_WORD_BITS); x < x_end; x++){
+                    U16 flags = tile->flags;
+                    for(S32 p = 0; p < TILE_FLAG_PLANE_COUNT; p++){
+                         if(flags & tile_flag_plane_flags[p]) words[p] |= bit;
+                    }
+                    bit <<= 1;
+                    tile++;
+               }
+
+               S32 index = (S32)(y) * tilemap->flag_plane_row_words + w;
+               for(S32 p = 0; p < TILE_FLAG_PLANE_COUNT; p++){
+                    tilemap->flag_planes[p * plane_words + index] = words[p];
+               }
+          }
+     }
+}
+
+void tilemap_sync_flag_planes(TileMap_t* tilemap, Tile_t* tile){
+     if(!tilemap->flag_planes) return;
+
+     S32 tile_index = (S32)(tile - tilemap->tiles);
+     S16 x = (S16)(tile_index % tilemap->width);
+     S16 y = (S16)(tile_index / tilemap->width);
+     S32 index = (S32)(y) * tilemap->flag_plane_row_words + x / TILE_FLAG_PLANE_WORD_BITS;
+     U64 bit = (U64)(1) << (x % TILE_FLAG_PLANE_WORD_BITS);
+
+     S32 plane_words = tilemap_flag_plane_words(tilemap);
+     for(S32 p = 0; p < TILE_FLAG_PLANE_COUNT; p++){
+          U64* word = tilemap->flag_planes + p * plane_words + index;
+          if(tile->flags & tile_flag_plane_flags[p]){
+               *word |= bit;
+          }else{
+               *word &= ~bit;
+          }
+     }
+}
+
+S32 tilemap_flag_plane_words(const TileMap_t* tilemap){
+     return (S32)(tilemap->flag_plane_row_words) * tilemap->height;
+}
+
+U64* tilemap_flag_plane(TileMap_t* tilemap, TileFlagPlane_t plane){
+     return tilemap->flag_planes + plane * tilemap_flag_plane_words(tilemap);
+}
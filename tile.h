@@ -39,12 +39,44 @@ struct Tile_t{
      U8 rotation;
 };
 
+// the flags that get their own bit plane, the ones after solid are the ones that change during play and are contiguous
+enum TileFlagPlane_t{
+     TILE_FLAG_PLANE_SOLID,
+     TILE_FLAG_PLANE_ICED,
+     TILE_FLAG_PLANE_WIRE_STATE,
+     TILE_FLAG_PLANE_WIRE_CLUSTER_LEFT_ON,
+     TILE_FLAG_PLANE_WIRE_CLUSTER_MID_ON,
+     TILE_FLAG_PLANE_WIRE_CLUSTER_RIGHT_ON,
+     TILE_FLAG_PLANE_COUNT,
+};
+
+#define TILE_FLAG_PLANE_WORD_BITS 64
+
+// tiles are stored row by row in one allocation, so whole map passes are a single sweep
 struct TileMap_t{
      S16 width;
      S16 height;
-     Tile_t** tiles;
+     Tile_t* tiles;
+
+     // one bit per tile for each TileFlagPlane_t, rows padded to whole words. Anything that writes tile flags has to
+     // call tilemap_sync_flag_planes() for that tile, or tilemap_build_flag_planes() after writing a lot of them
+     U64* flag_planes;
+     S16 flag_plane_row_words;
 };
 
+// no bounds checking, use tilemap_get_tile() for coords that may be off the map
+inline Tile_t* tilemap_tile(TileMap_t* tilemap, S16 x, S16 y){
+     return tilemap->tiles + (S32)(y) * tilemap->width + x;
+}
+
+inline const Tile_t* tilemap_tile(const TileMap_t* tilemap, S16 x, S16 y){
+     return tilemap->tiles + (S32)(y) * tilemap->width + x;
+}
+
+inline S32 tilemap_tile_count(const TileMap_t* tilemap){
+     return (S32)(tilemap->width) * tilemap->height;
+}
+
 bool init(TileMap_t* tilemap, S16 width, S16 height);
 void deep_copy(TileMap_t* a, TileMap_t* b);
 void destroy(TileMap_t* tilemap);
@@ -60,5 +92,10 @@ void tile_toggle_wire_activated(Tile_t* tile);
 DirectionMask_t tile_existing_wires(U16 flags);
 U16 tile_set_existing_wires(DirectionMask_t direction_mask, U16 current_flags);
 
+void tilemap_build_flag_planes(TileMap_t* tilemap);
+void tilemap_sync_flag_planes(TileMap_t* tilemap, Tile_t* tile);
+S32 tilemap_flag_plane_words(const TileMap_t* tilemap);
+U64* tilemap_flag_plane(TileMap_t* tilemap, TileFlagPlane_t plane);
+
 U8 tile_flip_solid_id_vertically_rotation(U8 id, U8 current_rotation);
 U8 tile_flip_solid_id_horizontally_rotation(U8 id, U8 current_rotation);
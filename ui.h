@@ -15,6 +15,13 @@
 #define CHECKBOX_DIMENSION (8.0 * PIXEL_SIZE)
 #define THUMBNAIL_UI_DIMENSION (0.1375f)
 
+enum ThumbnailTextureState_t{
+     THUMBNAIL_TEXTURE_STATE_NONE,
+     THUMBNAIL_TEXTURE_STATE_DECODING,
+     THUMBNAIL_TEXTURE_STATE_LOADED,
+     THUMBNAIL_TEXTURE_STATE_FAILED,
+};
+
 enum CheckBoxState_t{
      CHECKBOX_STATE_EMPTY,
      CHECKBOX_STATE_CHECKED,
@@ -38,6 +45,12 @@ struct MapThumbnail_t{
     Vec_t pos;
     GLuint texture = 0;
 
+    // where the thumbnail lives in the map file, the texture is streamed in while it is visible
+    U64 thumbnail_offset = 0;
+    U64 thumbnail_size = 0;
+    ThumbnailTextureState_t texture_state = THUMBNAIL_TEXTURE_STATE_NONE;
+    U64 texture_last_used_frame = 0;
+
     Quad_t get_area(Vec_t scroll){
         Vec_t final = pos + scroll;
         return Quad_t{final.x, final.y, (F32)(final.x + THUMBNAIL_UI_DIMENSION), (F32)(final.y + THUMBNAIL_UI_DIMENSION)};
@@ -154,7 +154,7 @@ void undo_snapshot(Undo_t* undo, ObjectArray_t<Player_t>* players, TileMap_t* ti
 
      for(S16 y = 0; y < tilemap->height; y++){
           for(S16 x = 0; x < tilemap->width; x++){
-               undo->tile_flags[y][x] = tilemap->tiles[y][x].flags;
+               undo->tile_flags[y][x] = tilemap_tile(tilemap, x, y)->flags;
           }
      }
 
@@ -287,7 +287,7 @@ void undo_commit(Undo_t* undo, ObjectArray_t<Player_t>* players, TileMap_t* tile
      // tile flags
      for(S16 y = 0; y < tilemap->height; y++){
           for(S16 x = 0; x < tilemap->width; x++){
-               if(undo->tile_flags[y][x] != tilemap->tiles[y][x].flags){
+               if(undo->tile_flags[y][x] != tilemap_tile(tilemap, x, y)->flags){
                     auto* undo_tile_flags = (U16*)(undo->history.current);
                     *undo_tile_flags = undo->tile_flags[y][x];
                     undo_history_add(&undo->history, UNDO_DIFF_TYPE_TILE_FLAGS, y * tilemap->width + x);
@@ -492,7 +492,8 @@ void undo_revert(Undo_t* undo, ObjectArray_t<Player_t>* players, TileMap_t* tile
 
                ptr -= sizeof(U16);
                auto* tile_flags_entry = (U16*)(ptr);
-               tilemap->tiles[y][x].flags = *tile_flags_entry;
+               tilemap_tile(tilemap, x, y)->flags = *tile_flags_entry;
+               tilemap_sync_flag_planes(tilemap, tilemap_tile(tilemap, x, y));
           } break;
           case UNDO_DIFF_TYPE_BLOCK:
           {
@@ -592,9 +593,10 @@ void undo_revert(Undo_t* undo, ObjectArray_t<Player_t>* players, TileMap_t* tile
 
                     for(S16 h = 0; h < map_copy.height; h++){
                          for(S16 w = 0; w < lower_width; w++){
-                              tilemap->tiles[h][w] = map_copy.tiles[h][w];
+                              *tilemap_tile(tilemap, w, h) = *tilemap_tile(&map_copy, w, h);
                          }
                     }
+                    tilemap_build_flag_planes(tilemap);
 
                     destroy(&map_copy);
                     undo_resize_width(undo, map_resize->old_dimension);
@@ -605,9 +607,10 @@ void undo_revert(Undo_t* undo, ObjectArray_t<Player_t>* players, TileMap_t* tile
 
                     for(S16 h = 0; h < lower_height; h++){
                          for(S16 w = 0; w < map_copy.width; w++){
-                              tilemap->tiles[h][w] = map_copy.tiles[h][w];
+                              *tilemap_tile(tilemap, w, h) = *tilemap_tile(&map_copy, w, h);
                          }
                     }
+                    tilemap_build_flag_planes(tilemap);
 
                     destroy(&map_copy);
                     undo_resize_height(undo, map_resize->old_dimension);
@@ -1,47 +0,0 @@
-#include "vec.h"
-
-#include <cmath>
-#include <cfloat>
-
-Vec_t operator+(Vec_t a, Vec_t b){return Vec_t{a.x + b.x, a.y + b.y};}
-Vec_t operator-(Vec_t a, Vec_t b){return Vec_t{a.x - b.x, a.y - b.y};}
-
-void operator+=(Vec_t& a, Vec_t b){a.x += b.x; a.y += b.y;}
-void operator-=(Vec_t& a, Vec_t b){a.x -= b.x; a.y -= b.y;}
-
-Vec_t operator*(Vec_t a, F32 s){return Vec_t{a.x * s, a.y * s};}
-void operator*=(Vec_t& a, F32 s){a.x *= s; a.y *= s;}
-
-Vec_t vec_negate(Vec_t a){return Vec_t{-a.x, -a.y};}
-
-float vec_dot(Vec_t a, Vec_t b){return a.x * b.x + a.y * b.y;}
-
-F32 vec_magnitude(Vec_t v){return (F32)(sqrt((v.x * v.x) + (v.y * v.y)));}
-
-Vec_t vec_normalize(Vec_t a){
-     F32 length = vec_magnitude(a);
-     if(length <= FLT_EPSILON) return a;
-     return Vec_t{a.x / length, a.y / length};
-}
-
-Vec_t vec_zero()  {return Vec_t{ 0.0f,  0.0f};}
-
-Vec_t vec_project_onto(Vec_t a, Vec_t b){
-     // find the perpendicular vector
-     Vec_t b_normal = vec_normalize(b);
-     F32 along_b = vec_dot(a, b_normal);
-
-     // clamp dot
-     F32 b_magnitude = vec_magnitude(b);
-     if(along_b < 0.0f){
-          along_b = 0.0f;
-     }else if(along_b > b_magnitude){
-          along_b = b_magnitude;
-     }
-
-     // find the closest point
-     return b_normal * along_b;
-}
-
-bool operator !=(const Vec_t& a, const Vec_t& b){return (a.x != b.x || a.y != b.y);}
-bool operator ==(const Vec_t& a, const Vec_t& b){return (a.x == b.x && a.y == b.y);}
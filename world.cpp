@@ -149,6 +149,7 @@ void reset_map(Coord_t player_start, World_t* world, Undo_t* undo, Camera_t* cam
 
      quad_tree_free(world->block_qt);
      world->block_qt = quad_tree_build(&world->blocks);
+     world_wake_all_blocks(world);
 
      destroy(undo);
      init(undo, UNDO_MEMORY, world->tilemap.width, world->tilemap.height, world->blocks.count, world->interactives.count);
@@ -173,6 +174,7 @@ static void toggle_electricity(TileMap_t* tilemap, QuadTreeNode_t<Interactive_t>
                interactive->popup.lift.up = !interactive->popup.lift.up;
                if(tile->flags & TILE_FLAG_ICED){
                     tile->flags &= ~TILE_FLAG_ICED;
+                    tilemap_sync_flag_planes(tilemap, tile);
                }
           } break;
           case INTERACTIVE_TYPE_DOOR:
@@ -287,6 +289,8 @@ static void toggle_electricity(TileMap_t* tilemap, QuadTreeNode_t<Interactive_t>
                TOGGLE_BIT_FLAG(tile->flags, TILE_FLAG_WIRE_STATE);
           }
 
+          tilemap_sync_flag_planes(tilemap, tile);
+
           if(wire_cross){
                if(interactive->wire_cross.mask & DIRECTION_MASK_LEFT && direction != DIRECTION_RIGHT){
                     toggle_electricity(tilemap, interactive_qt, adjacent_coord, DIRECTION_LEFT, true, false);
@@ -389,6 +393,8 @@ static void toggle_electricity(TileMap_t* tilemap, QuadTreeNode_t<Interactive_t>
                break;
           }
 
+          tilemap_sync_flag_planes(tilemap, tile);
+
           bool all_on_after = tile_flags_cluster_all_on(tile->flags);
 
           if(all_on_before != all_on_after){
@@ -441,10 +447,10 @@ void slow_block_toward_gridlock(World_t* world, Block_t* block, Direction_t dire
      }
 
      auto against_result = block_against_other_blocks(block->pos + block->pos_delta, block->cut, direction_opposite(direction),
-                                                      world->block_qt, world->interactive_qt, &world->tilemap);
+                                                      world->block_qt, &world->blocks, world->interactive_qt, &world->tilemap);
      for(S16 i = 0; i < against_result.count; i++){
          Direction_t against_result_direction = direction_rotate_clockwise(direction, against_result.objects[i].rotations_through_portal);
-         Block_t* against_result_block = against_result.objects[i].block;
+         Block_t* against_result_block = block_from_handle(&world->blocks, against_result.objects[i].block);
 
          // we don't want to impact a block that is colliding with the block as we are stopping it, but rather a
          // gaggle of blocks sliding together that the player is stopping
@@ -624,10 +630,10 @@ void stop_against_blocks_moving_with_block(World_t* world, Block_t* block, Direc
     }
 
     auto against_result = block_against_other_blocks(block->pos + block->pos_delta, block->cut, direction,
-                                                     world->block_qt, world->interactive_qt, &world->tilemap);
+                                                     world->block_qt, &world->blocks, world->interactive_qt, &world->tilemap);
     for(S16 i = 0; i < against_result.count; i++){
         Direction_t against_direction = direction_rotate_clockwise(direction, against_result.objects[i].rotations_through_portal);
-        Block_t* against_block = against_result.objects[i].block;
+        Block_t* against_block = block_from_handle(&world->blocks, against_result.objects[i].block);
 
         Vec_t rotated_new_pos_delta_vec = vec_rotate_quadrants_clockwise(new_pos_delta_vec, against_result.objects[i].rotations_through_portal);
         F32 rotated_new_pos_delta = direction_is_horizontal(against_direction) ? rotated_new_pos_delta_vec.x : rotated_new_pos_delta_vec.y;
@@ -640,6 +646,7 @@ void stop_against_blocks_moving_with_block(World_t* world, Block_t* block, Direc
          }else{
               block->pos_delta.y = new_pos_delta;
          }
+         world_clear_block_query_cache(world);
     }
 }
 
@@ -789,7 +796,7 @@ MovePlayerThroughWorldResult_t move_player_through_world(Position_t player_pos,
                               F32 new_pos_delta = pos_to_vec(block_new_pos - collision.block->pos).x;
                               stop_against_blocks_moving_with_block(world, collision.block, collision.dir, new_pos_delta);
                          }
-                    }else if(!(collision.block->pos.z > player->pos.z && block_held_up_by_another_block(collision.block, world->block_qt, world->interactive_qt, &world->tilemap).held())){
+                    }else if(!(collision.block->pos.z > player->pos.z && block_held_up_by_another_block(collision.block, world->block_qt, &world->blocks, world->interactive_qt, &world->tilemap).held())){
                          if(relevant_move_state == MOVE_STATE_STARTING && rotated_accel.x < 0){
                               // the player has started pushing the block left while it was coasting right so pass on taking any actions
                          }else{
@@ -846,7 +853,7 @@ MovePlayerThroughWorldResult_t move_player_through_world(Position_t player_pos,
                               F32 new_pos_delta = pos_to_vec(block_new_pos - collision.block->pos).x;
                               stop_against_blocks_moving_with_block(world, collision.block, collision.dir, new_pos_delta);
                          }
-                    }else if(!(collision.block->pos.z > player->pos.z && block_held_up_by_another_block(collision.block, world->block_qt, world->interactive_qt, &world->tilemap).held())){
+                    }else if(!(collision.block->pos.z > player->pos.z && block_held_up_by_another_block(collision.block, world->block_qt, &world->blocks, world->interactive_qt, &world->tilemap).held())){
                          if(relevant_move_state == MOVE_STATE_STARTING && rotated_accel.x > 0){
                               // pass
                          }else{
@@ -901,7 +908,7 @@ MovePlayerThroughWorldResult_t move_player_through_world(Position_t player_pos,
                               F32 new_pos_delta = pos_to_vec(block_new_pos - collision.block->pos).y;
                               stop_against_blocks_moving_with_block(world, collision.block, collision.dir, new_pos_delta);
                          }
-                    }else if(!(collision.block->pos.z > player->pos.z && block_held_up_by_another_block(collision.block, world->block_qt, world->interactive_qt, &world->tilemap).held())){
+                    }else if(!(collision.block->pos.z > player->pos.z && block_held_up_by_another_block(collision.block, world->block_qt, &world->blocks, world->interactive_qt, &world->tilemap).held())){
                          if(relevant_move_state == MOVE_STATE_STARTING && rotated_accel.y > 0){
                               // pass
                          }else{
@@ -957,7 +964,7 @@ MovePlayerThroughWorldResult_t move_player_through_world(Position_t player_pos,
                               F32 new_pos_delta = pos_to_vec(block_new_pos - collision.block->pos).y;
                               stop_against_blocks_moving_with_block(world, collision.block, collision.dir, new_pos_delta);
                          }
-                    }else if(!(collision.block->pos.z > player->pos.z && block_held_up_by_another_block(collision.block, world->block_qt, world->interactive_qt, &world->tilemap).held())){
+                    }else if(!(collision.block->pos.z > player->pos.z && block_held_up_by_another_block(collision.block, world->block_qt, &world->blocks, world->interactive_qt, &world->tilemap).held())){
                          if(relevant_move_state == MOVE_STATE_STARTING && rotated_accel.y < 0){
                               // pass
                          }else{
@@ -984,7 +991,7 @@ MovePlayerThroughWorldResult_t move_player_through_world(Position_t player_pos,
 
           auto rotated_player_face = direction_rotate_counter_clockwise(player_face, collision.portal_rotations);
 
-          bool held_down = block_held_down_by_another_block(collision.block, world->block_qt, world->interactive_qt, &world->tilemap).held();
+          bool held_down = block_held_down_by_another_block(collision.block, world->block_qt, &world->blocks, world->interactive_qt, &world->tilemap).held();
           bool on_ice = block_on_ice(collision.block->pos, collision.block->pos_delta, collision.block->cut,
                                      &world->tilemap, world->interactive_qt, world->block_qt);
           bool pushable = block_pushable(collision.block, rotated_player_face, world, 1.0f);
@@ -1009,7 +1016,7 @@ MovePlayerThroughWorldResult_t move_player_through_world(Position_t player_pos,
      Direction_t collided_tile_dir = DIRECTION_COUNT;
      for(S16 y = min.y; y <= max.y; y++){
           for(S16 x = min.x; x <= max.x; x++){
-               if(tile_is_solid(world->tilemap.tiles[y] + x)){
+               if(tile_is_solid(tilemap_tile(&world->tilemap, x, y))){
                     Coord_t coord {x, y};
                     bool collide_with_tile = false;
                     Rect_t coord_rect = rect_surrounding_coord(coord);
@@ -1282,6 +1289,26 @@ void illuminate(Coord_t coord, U8 value, World_t* world, Coord_t from_portal){
      }
 }
 
+// the parts of an interactive that can hold up, slow down or push blocks without the interactive moving
+static U8 interactive_wake_state(Interactive_t* interactive){
+     switch(interactive->type){
+     default:
+          break;
+     case INTERACTIVE_TYPE_PIT:
+          return interactive->pit.iced;
+     case INTERACTIVE_TYPE_POPUP:
+          return interactive->popup.iced | (interactive->popup.lift.up << 1);
+     case INTERACTIVE_TYPE_DOOR:
+          return interactive->door.lift.up;
+     case INTERACTIVE_TYPE_PRESSURE_PLATE:
+          return interactive->pressure_plate.iced_under | (interactive->pressure_plate.down << 1);
+     case INTERACTIVE_TYPE_PORTAL:
+          return interactive->portal.on;
+     }
+
+     return 0;
+}
+
 static void impact_ice(Coord_t center, S8 height, S16 radius, World_t* world, bool teleported, bool spread_the_ice){
      Coord_t delta {radius, radius};
      Coord_t min = center - delta;
@@ -1293,6 +1320,8 @@ static void impact_ice(Coord_t center, S8 height, S16 radius, World_t* world, bo
                Tile_t* tile = tilemap_get_tile(&world->tilemap, coord);
                if(tile){
                     if(!tile_is_solid(tile)){
+                         bool woke_blocks = false;
+                         U16 tile_flags = tile->flags;
                          Rect_t coord_rect = rect_surrounding_adjacent_coords(coord);
                          S16 block_count = 0;
                          Block_t* blocks[BLOCK_QUAD_TREE_MAX_QUERY];
@@ -1303,7 +1332,11 @@ static void impact_ice(Coord_t center, S8 height, S16 radius, World_t* world, bo
                               Block_t* block = blocks[i];
                               if(block_get_coord(block) == coord && height > block->pos.z &&
                                  height < (block->pos.z + HEIGHT_INTERVAL + MELT_SPREAD_HEIGHT) &&
-                                 !block_held_down_by_another_block(block, world->block_qt, world->interactive_qt, &world->tilemap).held()){
+                                 !block_held_down_by_another_block(block, world->block_qt, &world->blocks, world->interactive_qt, &world->tilemap).held()){
+                                   if(!woke_blocks){
+                                        world_wake_blocks_near(world, coord);
+                                        woke_blocks = true;
+                                   }
                                    if(spread_the_ice){
                                         if(block->element == ELEMENT_NONE) block->element = ELEMENT_ONLY_ICED;
                                         spread_on_block = true;
@@ -1317,6 +1350,7 @@ static void impact_ice(Coord_t center, S8 height, S16 radius, World_t* world, bo
                          }
 
                          Interactive_t* interactive = quad_tree_find_at(world->interactive_qt, coord.x, coord.y);
+                         U8 interactive_state = interactive ? interactive_wake_state(interactive) : 0;
 
                          if(!spread_on_block){
                               if(interactive){
@@ -1377,6 +1411,14 @@ static void impact_ice(Coord_t center, S8 height, S16 radius, World_t* world, bo
                               }
                          }
 
+                         if(tile->flags != tile_flags) tilemap_sync_flag_planes(&world->tilemap, tile);
+
+                         // blocks resting on ice, a pit or a popup that just changed have to notice it this frame
+                         if(!woke_blocks && (((tile->flags ^ tile_flags) & TILE_FLAG_ICED) ||
+                                             (interactive && interactive_wake_state(interactive) != interactive_state))){
+                              world_wake_blocks_near(world, coord);
+                         }
+
                          if(is_active_portal(interactive)){
                               if(!teleported){
                                    auto portal_exits = find_portal_exits(coord, &world->tilemap, world->interactive_qt);
@@ -1588,7 +1630,7 @@ bool apply_push_horizontal(Block_t* block, Position_t pos, World_t* world, Direc
 
                 // LOG("giving block %ld: %f horizontal impact momentum\n", block - world->blocks.elements, pushee_momentum.mass * instant_vel);
 
-                block_add_horizontal_momentum(block, BLOCK_MOMENTUM_TYPE_IMPACT, pushee_momentum.mass * instant_vel);
+                block_add_horizontal_momentum(world, block, BLOCK_MOMENTUM_TYPE_IMPACT, pushee_momentum.mass * instant_vel);
 
                 auto motion = motion_x_component(block);
                 F32 x_pos = pos_to_vec(block->pos).x;
@@ -1701,7 +1743,7 @@ bool apply_push_vertical(Block_t* block, Position_t pos, World_t* world, Directi
 
                 // LOG("giving block %ld: %f vertical impact momentum\n", block - world->blocks.elements, pushee_momentum.mass * instant_vel);
 
-                block_add_vertical_momentum(block, BLOCK_MOMENTUM_TYPE_IMPACT, pushee_momentum.mass * instant_vel);
+                block_add_vertical_momentum(world, block, BLOCK_MOMENTUM_TYPE_IMPACT, pushee_momentum.mass * instant_vel);
 
                 auto motion = motion_y_component(block);
                 F32 y_pos = pos_to_vec(block->pos).y;
@@ -1783,7 +1825,7 @@ bool apply_push_vertical(Block_t* block, Position_t pos, World_t* world, Directi
       return true;
 }
 
-void update_block_momentum_from_push(Block_t* block, Direction_t direction, PushFromEntangler_t* from_entangler, BlockPushResult_t* push_result, BlockPushResult_t* final_result){
+void update_block_momentum_from_push(Block_t* block, World_t* world, Direction_t direction, PushFromEntangler_t* from_entangler, BlockPushResult_t* push_result, BlockPushResult_t* final_result){
      if(direction_is_horizontal(direction)){
          bool transferred_momentum_back = false;
 
@@ -1795,7 +1837,7 @@ void update_block_momentum_from_push(Block_t* block, Direction_t direction, Push
 
                  // TODO: how do we handle multiple collisions transferring momentum back?
                  if(from_entangler){
-                      block_add_horizontal_momentum(block, BLOCK_MOMENTUM_TYPE_IMPACT, collision.pushee_velocity * collision.pushee_mass);
+                      block_add_horizontal_momentum(world, block, BLOCK_MOMENTUM_TYPE_IMPACT, collision.pushee_velocity * collision.pushee_mass);
                       // block->horizontal_move.state = MOVE_STATE_COASTING;
                       // block->horizontal_move.sign = move_sign_from_vel(collision.pushee_velocity);
                       final_result->pushed = true;
@@ -1816,7 +1858,7 @@ void update_block_momentum_from_push(Block_t* block, Direction_t direction, Push
                  transferred_momentum_back = true;
 
                  if(from_entangler){
-                      block_add_vertical_momentum(block, BLOCK_MOMENTUM_TYPE_IMPACT, collision.pushee_velocity * collision.pushee_mass);
+                      block_add_vertical_momentum(world, block, BLOCK_MOMENTUM_TYPE_IMPACT, collision.pushee_velocity * collision.pushee_mass);
                       final_result->pushed = true;
                  }else{
                       final_result->collisions.insert(&collision);
@@ -1896,7 +1938,7 @@ bool resolve_push_against_block(Block_t* block, MoveDirection_t move_direction,
                                 BlockAgainstOther_t* against, S16 against_count, World_t* world,
                                 S16 block_contributing_momentum_to_total_blocks, bool side_effects,
                                 BlockPushResult_t* result, bool* transfers_force){
-     Block_t* against_block = against->block;
+     Block_t* against_block = block_from_handle(&world->blocks, against->block);
      Direction_t first_direction;
      Direction_t second_direction;
 
@@ -2012,22 +2054,22 @@ bool resolve_push_against_block(Block_t* block, MoveDirection_t move_direction,
 
                          if(push_result.horizontal_result.pushed){
                               BlockPushedAgainst_t pushed_against {};
-                              pushed_against.block = against_block;
+                              pushed_against.block = against->block;
                               pushed_against.direction = first_against_block_push_dir;
                               result->againsts_pushed.insert(&pushed_against);
                          }
 
                          if(push_result.vertical_result.pushed){
                               BlockPushedAgainst_t pushed_against {};
-                              pushed_against.block = against_block;
+                              pushed_against.block = against->block;
                               pushed_against.direction = second_against_block_push_dir;
                               result->againsts_pushed.insert(&pushed_against);
                          }
 
-                         update_block_momentum_from_push(block, first_direction, from_entangler, &push_result.horizontal_result, result);
+                         update_block_momentum_from_push(block, world, first_direction, from_entangler, &push_result.horizontal_result, result);
 
                          if(second_direction != DIRECTION_COUNT){
-                              update_block_momentum_from_push(block, second_direction, from_entangler, &push_result.vertical_result, result);
+                              update_block_momentum_from_push(block, world, second_direction, from_entangler, &push_result.vertical_result, result);
                          }
                     }
                }
@@ -2061,7 +2103,7 @@ bool resolve_push_against_block(Block_t* block, MoveDirection_t move_direction,
 
                          if(push_result.horizontal_result.pushed){
                               BlockPushedAgainst_t pushed_against {};
-                              pushed_against.block = against_block;
+                              pushed_against.block = against->block;
                               pushed_against.direction = first_against_block_push_dir;
                               result->againsts_pushed.insert(&pushed_against);
                          }
@@ -2070,7 +2112,7 @@ bool resolve_push_against_block(Block_t* block, MoveDirection_t move_direction,
 
                          if(push_result.vertical_result.pushed){
                               BlockPushedAgainst_t pushed_against {};
-                              pushed_against.block = against_block;
+                              pushed_against.block = against->block;
                               pushed_against.direction = second_against_block_push_dir;
                               result->againsts_pushed.insert(&pushed_against);
                          }
@@ -2108,7 +2150,7 @@ bool resolve_push_against_block(Block_t* block, MoveDirection_t move_direction,
 
               if(push_result.pushed && result){
                    BlockPushedAgainst_t pushed_against {};
-                   pushed_against.block = against_block;
+                   pushed_against.block = against->block;
                    pushed_against.direction = first_against_block_push_dir;
                    result->againsts_pushed.insert(&pushed_against);
               }
@@ -2130,7 +2172,7 @@ bool resolve_push_against_block(Block_t* block, MoveDirection_t move_direction,
 
                    if(push_result.pushed && result){
                         BlockPushedAgainst_t pushed_against {};
-                        pushed_against.block = against_block;
+                        pushed_against.block = against->block;
                         pushed_against.direction = first_against_block_push_dir;
                         result->againsts_pushed.insert(&pushed_against);
                    }
@@ -2174,7 +2216,7 @@ bool block_would_push(Block_t* block, Position_t pos, Vec_t pos_delta, Direction
                       PushFromEntangler_t* from_entangler, S16 block_contributing_momentum_to_total_blocks,
                       bool side_effects, BlockPushResult_t* result)
 {
-     auto against_result = block_against_other_blocks(pos + pos_delta, block->cut, direction, world->block_qt, world->interactive_qt,
+     auto against_result = block_against_other_blocks(pos + pos_delta, block->cut, direction, world->block_qt, &world->blocks, world->interactive_qt,
                                                       &world->tilemap);
      bool pushed_block_on_frictionless = block_on_frictionless(pos, pos_delta, block->cut, &world->tilemap, world->interactive_qt, world->block_qt);
 
@@ -2201,8 +2243,8 @@ bool block_would_push(Block_t* block, Position_t pos, Vec_t pos_delta, Direction
           if(block->vertical_move.state != MOVE_STATE_IDLING && block->accel.y != 0.0f){
                Direction_t vertical_direction = block->accel.y > 0.0f ? DIRECTION_UP : DIRECTION_DOWN;
                DirectionMask_t directions = direction_mask_add(direction_to_direction_mask(direction), vertical_direction);
-               auto against = block_diagonally_against_block(pos + pos_delta, block->cut, directions, &world->tilemap, world->interactive_qt, world->block_qt);
-               if(against.block != NULL){
+               auto against = block_diagonally_against_block(pos + pos_delta, block->cut, directions, &world->tilemap, world->interactive_qt, world->block_qt, &world->blocks);
+               if(block_from_handle(&world->blocks, against.block)){
                     MoveDirection_t move_direction = move_direction_from_directions(direction, vertical_direction);
                     if(!resolve_push_against_block(block, move_direction, pushed_by_ice, pushed_block_on_frictionless, force, instant_momentum,
                                                    from_entangler, &against, 1, world, block_contributing_momentum_to_total_blocks,
@@ -2217,8 +2259,8 @@ bool block_would_push(Block_t* block, Position_t pos, Vec_t pos_delta, Direction
           if(block->horizontal_move.state != MOVE_STATE_IDLING && block->accel.x != 0.0f){
                Direction_t horizontal_direction = block->accel.x > 0.0f ? DIRECTION_RIGHT : DIRECTION_LEFT;
                DirectionMask_t directions = direction_mask_add(direction_to_direction_mask(direction), horizontal_direction);
-               auto against = block_diagonally_against_block(pos + pos_delta, block->cut, directions, &world->tilemap, world->interactive_qt, world->block_qt);
-               if(against.block != NULL){
+               auto against = block_diagonally_against_block(pos + pos_delta, block->cut, directions, &world->tilemap, world->interactive_qt, world->block_qt, &world->blocks);
+               if(block_from_handle(&world->blocks, against.block)){
                     MoveDirection_t move_direction = move_direction_from_directions(horizontal_direction, direction);
                     if(!resolve_push_against_block(block, move_direction, pushed_by_ice, pushed_block_on_frictionless, force, instant_momentum,
                                                    from_entangler, &against, 1, world, block_contributing_momentum_to_total_blocks,
@@ -2302,6 +2344,8 @@ bool block_would_push(Block_t* block, Position_t pos, Vec_t pos_delta, Direction
 void block_do_push(Block_t* block, Position_t pos, Vec_t pos_delta, Direction_t direction, World_t* world,
                    bool pushed_by_ice, BlockPushResult_t* result, F32 force, TransferMomentum_t* instant_momentum,
                    PushFromEntangler_t* from_entangler, S16 block_contributing_momentum_to_total_blocks){
+     world_wake_block(world, get_block_index(world, block));
+
      bool pushed_block_on_frictionless = block_on_frictionless(pos, pos_delta, block->cut, &world->tilemap, world->interactive_qt, world->block_qt);
 
      auto* player = block_against_player(block, direction, &world->players);
@@ -2633,8 +2677,8 @@ bool setup_default_room(World_t* world){
      init(&world->tilemap, ROOM_TILE_SIZE, ROOM_TILE_SIZE);
 
      for(S16 i = 0; i < world->tilemap.width; i++){
-          Tile_t* bottom_wall_top = world->tilemap.tiles[0] + i;
-          Tile_t* bottom_wall_bottom = world->tilemap.tiles[1] + i;
+          Tile_t* bottom_wall_top = tilemap_tile(&world->tilemap, i, 0);
+          Tile_t* bottom_wall_bottom = tilemap_tile(&world->tilemap, i, 1);
 
           bottom_wall_top->id = 0;
           bottom_wall_bottom->id = 1;
@@ -2643,8 +2687,8 @@ bool setup_default_room(World_t* world){
           bottom_wall_top->flags |= TILE_FLAG_SOLID;
           bottom_wall_bottom->flags |= TILE_FLAG_SOLID;
 
-          Tile_t* top_wall_top = world->tilemap.tiles[world->tilemap.height - 1] + i;
-          Tile_t* top_wall_bottom = world->tilemap.tiles[world->tilemap.height - 2] + i;
+          Tile_t* top_wall_top = tilemap_tile(&world->tilemap, i, world->tilemap.height - 1);
+          Tile_t* top_wall_bottom = tilemap_tile(&world->tilemap, i, world->tilemap.height - 2);
 
           top_wall_top->id = 0;
           top_wall_bottom->id = 1;
@@ -2655,8 +2699,8 @@ bool setup_default_room(World_t* world){
      }
 
      for(S16 i = 0; i < world->tilemap.height; i++){
-          Tile_t* bottom_wall_top = world->tilemap.tiles[i] + 0;
-          Tile_t* bottom_wall_bottom = world->tilemap.tiles[i] + 1;
+          Tile_t* bottom_wall_top = tilemap_tile(&world->tilemap, 0, i);
+          Tile_t* bottom_wall_bottom = tilemap_tile(&world->tilemap, 1, i);
 
           bottom_wall_top->id = 0;
           bottom_wall_bottom->id = 1;
@@ -2665,8 +2709,8 @@ bool setup_default_room(World_t* world){
           bottom_wall_top->flags |= TILE_FLAG_SOLID;
           bottom_wall_bottom->flags |= TILE_FLAG_SOLID;
 
-          Tile_t* top_wall_top = world->tilemap.tiles[i] + (world->tilemap.width - 1);
-          Tile_t* top_wall_bottom = world->tilemap.tiles[i] + (world->tilemap.width - 2);
+          Tile_t* top_wall_top = tilemap_tile(&world->tilemap, world->tilemap.width - 1, i);
+          Tile_t* top_wall_bottom = tilemap_tile(&world->tilemap, world->tilemap.width - 2, i);
 
           top_wall_top->id = 0;
           top_wall_bottom->id = 1;
@@ -2676,53 +2720,55 @@ bool setup_default_room(World_t* world){
           top_wall_bottom->flags |= TILE_FLAG_SOLID;
      }
 
-     world->tilemap.tiles[0][0].id = 3;
-     world->tilemap.tiles[0][0].rotation = 0;
+     tilemap_build_flag_planes(&world->tilemap);
+
+     tilemap_tile(&world->tilemap, 0, 0)->id = 3;
+     tilemap_tile(&world->tilemap, 0, 0)->rotation = 0;
 
-     world->tilemap.tiles[0][1].id = 0;
-     world->tilemap.tiles[0][1].rotation = 2;
+     tilemap_tile(&world->tilemap, 1, 0)->id = 0;
+     tilemap_tile(&world->tilemap, 1, 0)->rotation = 2;
 
-     world->tilemap.tiles[1][0].id = 0;
-     world->tilemap.tiles[1][0].rotation = 3;
+     tilemap_tile(&world->tilemap, 0, 1)->id = 0;
+     tilemap_tile(&world->tilemap, 0, 1)->rotation = 3;
 
-     world->tilemap.tiles[1][1].id = 2;
-     world->tilemap.tiles[1][1].rotation = 0;
+     tilemap_tile(&world->tilemap, 1, 1)->id = 2;
+     tilemap_tile(&world->tilemap, 1, 1)->rotation = 0;
 
-     world->tilemap.tiles[0][15].id = 0;
-     world->tilemap.tiles[0][15].rotation = 2;
+     tilemap_tile(&world->tilemap, 15, 0)->id = 0;
+     tilemap_tile(&world->tilemap, 15, 0)->rotation = 2;
 
-     world->tilemap.tiles[0][16].id = 3;
-     world->tilemap.tiles[0][16].rotation = 3;
+     tilemap_tile(&world->tilemap, 16, 0)->id = 3;
+     tilemap_tile(&world->tilemap, 16, 0)->rotation = 3;
 
-     world->tilemap.tiles[1][15].id = 2;
-     world->tilemap.tiles[1][15].rotation = 3;
+     tilemap_tile(&world->tilemap, 15, 1)->id = 2;
+     tilemap_tile(&world->tilemap, 15, 1)->rotation = 3;
 
-     world->tilemap.tiles[1][16].id = 0;
-     world->tilemap.tiles[1][16].rotation = 1;
+     tilemap_tile(&world->tilemap, 16, 1)->id = 0;
+     tilemap_tile(&world->tilemap, 16, 1)->rotation = 1;
 
-     world->tilemap.tiles[15][0].id = 0;
-     world->tilemap.tiles[15][0].rotation = 3;
+     tilemap_tile(&world->tilemap, 0, 15)->id = 0;
+     tilemap_tile(&world->tilemap, 0, 15)->rotation = 3;
 
-     world->tilemap.tiles[15][1].id = 2;
-     world->tilemap.tiles[15][1].rotation = 1;
+     tilemap_tile(&world->tilemap, 1, 15)->id = 2;
+     tilemap_tile(&world->tilemap, 1, 15)->rotation = 1;
 
-     world->tilemap.tiles[16][0].id = 3;
-     world->tilemap.tiles[16][0].rotation = 1;
+     tilemap_tile(&world->tilemap, 0, 16)->id = 3;
+     tilemap_tile(&world->tilemap, 0, 16)->rotation = 1;
 
-     world->tilemap.tiles[16][1].id = 0;
-     world->tilemap.tiles[16][1].rotation = 0;
+     tilemap_tile(&world->tilemap, 1, 16)->id = 0;
+     tilemap_tile(&world->tilemap, 1, 16)->rotation = 0;
 
-     world->tilemap.tiles[15][15].id = 2;
-     world->tilemap.tiles[15][15].rotation = 2;
+     tilemap_tile(&world->tilemap, 15, 15)->id = 2;
+     tilemap_tile(&world->tilemap, 15, 15)->rotation = 2;
 
-     world->tilemap.tiles[15][16].id = 0;
-     world->tilemap.tiles[15][16].rotation = 1;
+     tilemap_tile(&world->tilemap, 16, 15)->id = 0;
+     tilemap_tile(&world->tilemap, 16, 15)->rotation = 1;
 
-     world->tilemap.tiles[16][15].id = 0;
-     world->tilemap.tiles[16][15].rotation = 0;
+     tilemap_tile(&world->tilemap, 15, 16)->id = 0;
+     tilemap_tile(&world->tilemap, 15, 16)->rotation = 0;
 
-     world->tilemap.tiles[16][16].id = 3;
-     world->tilemap.tiles[16][16].rotation = 2;
+     tilemap_tile(&world->tilemap, 16, 16)->id = 3;
+     tilemap_tile(&world->tilemap, 16, 16)->rotation = 2;
 
      if(!init(&world->interactives, 1)){
           return false;
@@ -2741,11 +2787,9 @@ bool setup_default_room(World_t* world){
 }
 
 void reset_tilemap_light(World_t* world){
-     // TODO: this will need to be optimized when the map is much bigger
-     for(S16 j = 0; j < world->tilemap.height; j++){
-          for(S16 i = 0; i < world->tilemap.width; i++){
-               world->tilemap.tiles[j][i].light = BASE_LIGHT;
-          }
+     S32 tile_count = tilemap_tile_count(&world->tilemap);
+     for(S32 i = 0; i < tile_count; i++){
+          world->tilemap.tiles[i].light = BASE_LIGHT;
      }
 }
 
@@ -2778,30 +2822,52 @@ static S16 get_player_mass_on_block(World_t* world, Block_t* block){
      return mass;
 }
 
+static S16* block_mass_cache_stack_entry(World_t* world, Block_t* block){
+     auto* cache = &world->block_query_cache;
+     if(!cache->stack_masses) return NULL;
+     S32 index = block - world->blocks.elements;
+     if(index < 0 || index >= cache->block_count) return NULL;
+     return cache->stack_masses + index;
+}
+
+static S16* block_mass_cache_direction_entry(World_t* world, Block_t* block, Direction_t direction, bool require_on_ice){
+     auto* cache = &world->block_query_cache;
+     if(!cache->direction_masses || direction >= DIRECTION_COUNT) return NULL;
+     S32 index = block - world->blocks.elements;
+     if(index < 0 || index >= cache->block_count) return NULL;
+     return cache->direction_masses + index * BLOCK_MASS_CACHE_DIRECTION_ENTRIES + direction * 2 + (require_on_ice ? 1 : 0);
+}
+
 S16 get_block_stack_mass(World_t* world, Block_t* block){
+     S16* cached_mass = block_mass_cache_stack_entry(world, block);
+     if(cached_mass && *cached_mass >= 0) return *cached_mass;
+
      S16 mass = block_get_mass(block);
      mass += get_player_mass_on_block(world, block);
 
      if(block->element != ELEMENT_ICE && block->element != ELEMENT_ONLY_ICED){
-          auto result = block_held_down_by_another_block(block->pos.pixel, block->pos.z, block->cut, world->block_qt, world->interactive_qt, &world->tilemap, 0, false);
+          auto result = block_held_down_by_another_block(block->pos.pixel, block->pos.z, block->cut, world->block_qt, &world->blocks, world->interactive_qt, &world->tilemap, 0, false);
           for(S16 i = 0; i < result.count; i++){
+               Block_t* held_block = block_from_handle(&world->blocks, result.blocks_held[i].block);
+
                // check earlier blocks we've processed to see if they are currently entangled and cloning of one of them
                bool cloning = false;
                for(S16 j = 0; j < i; j++){
-                    if(blocks_are_entangled(result.blocks_held[i].block, result.blocks_held[j].block, &world->blocks) &&
-                       result.blocks_held[i].block->clone_start.x != 0){
+                    if(blocks_are_entangled(result.blocks_held[i].block.index, result.blocks_held[j].block.index, &world->blocks) &&
+                       held_block->clone_start.x != 0){
                          cloning = true;
                          break;
                     }
                }
 
                if(!cloning){
-                    mass += get_block_stack_mass(world, result.blocks_held[i].block);
-                    mass += get_player_mass_on_block(world, result.blocks_held[i].block);
+                    mass += get_block_stack_mass(world, held_block);
+                    mass += get_player_mass_on_block(world, held_block);
                }
           }
      }
 
+     if(cached_mass) *cached_mass = mass;
      return mass;
 }
 
@@ -2882,12 +2948,12 @@ ElasticCollisionResult_t elastic_transfer_momentum_to_block(TransferMomentum_t*
 
 static void get_touching_blocks_in_direction(World_t* world, Block_t* block, Direction_t direction, BlockList_t* block_list,
                                              bool require_on_ice = true){
-     auto result = block_against_other_blocks(block->pos + block->pos_delta, block->cut, direction, world->block_qt,
+     auto result = block_against_other_blocks(block->pos + block->pos_delta, block->cut, direction, world->block_qt, &world->blocks,
                                               world->interactive_qt, &world->tilemap);
      for(S16 i = 0; i < result.count; i++){
           Direction_t result_direction = direction;
           result_direction = direction_rotate_clockwise(result_direction, result.objects[i].rotations_through_portal);
-          auto result_block = result.objects[i].block;
+          auto result_block = block_from_handle(&world->blocks, result.objects[i].block);
 
           if((require_on_ice && block_on_ice(result_block->pos, result_block->pos_delta, result_block->cut,
                                              &world->tilemap, world->interactive_qt, world->block_qt)) ||
@@ -2899,17 +2965,21 @@ static void get_touching_blocks_in_direction(World_t* world, Block_t* block, Dir
 }
 
 void get_block_stack(World_t* world, Block_t* block, BlockList_t* block_list, S8 rotations_through_portal){
-     block_list->add(block, rotations_through_portal);
+     block_list->add(block_handle(&world->blocks, block), rotations_through_portal);
 
      if(block->element != ELEMENT_ICE && block->element != ELEMENT_ONLY_ICED){
-          auto result = block_held_down_by_another_block(block, world->block_qt, world->interactive_qt, &world->tilemap);
+          auto result = block_held_down_by_another_block(block, world->block_qt, &world->blocks, world->interactive_qt, &world->tilemap);
           for(S16 i = 0; i < result.count; i++){
-               get_block_stack(world, result.blocks_held[i].block, block_list, rotations_through_portal);
+               get_block_stack(world, block_from_handle(&world->blocks, result.blocks_held[i].block), block_list,
+                               rotations_through_portal);
           }
      }
 }
 
 S16 get_block_mass_in_direction(World_t* world, Block_t* block, Direction_t direction, bool require_on_ice){
+     S16* cached_mass = block_mass_cache_direction_entry(world, block, direction, require_on_ice);
+     if(cached_mass && *cached_mass >= 0) return *cached_mass;
+
      BlockList_t block_list;
      get_block_stack(world, block, &block_list, DIRECTION_COUNT);
 
@@ -2922,20 +2992,22 @@ S16 get_block_mass_in_direction(World_t* world, Block_t* block, Direction_t dire
           // TODO: n^2 * m, if we sort the blocks we can speed this up using a binary search bringing it to n log n * m
           for(S16 i = 0; i < block_list.count; i++){
                auto* block_entry = block_list.entries + i;
+               Block_t* entry_block = block_from_handle(&world->blocks, block_entry->block);
 
-               S16 entangle_index = block_entry->block->entangle_index;
+               S16 entangle_index = entry_block->entangle_index;
                S16 prev_entangle_index = -1;
                while(entangle_index != i && prev_entangle_index != entangle_index && entangle_index >= 0){
                     prev_entangle_index = entangle_index;
                     for(S16 j = i + 1; j < block_list.count; j++){
                          auto* block_entry_itr = block_list.entries + j;
-                         if(entangle_index == get_block_index(world, block_entry_itr->block)){
-                              S8 final_rotation = block_entry_itr->block->rotation - block_entry_itr->rotations_through_portal;
-                              S8 rotation_between = direction_rotations_between((Direction_t)(block_entry->block->rotation), (Direction_t)(final_rotation)) % DIRECTION_COUNT;
+                         if(entangle_index == block_entry_itr->block.index){
+                              Block_t* itr_block = block_from_handle(&world->blocks, block_entry_itr->block);
+                              S8 final_rotation = itr_block->rotation - block_entry_itr->rotations_through_portal;
+                              S8 rotation_between = direction_rotations_between((Direction_t)(entry_block->rotation), (Direction_t)(final_rotation)) % DIRECTION_COUNT;
 
                               if(rotation_between == 0){
                                    block_entry_itr->counted = false;
-                                   entangle_index = block_entry_itr->block->entangle_index;
+                                   entangle_index = itr_block->entangle_index;
                               }
                          }
                     }
@@ -2948,15 +3020,17 @@ S16 get_block_mass_in_direction(World_t* world, Block_t* block, Direction_t dire
      for(S16 i = 0; i < block_list.count; i++){
           auto* block_entry = block_list.entries + i;
           if(block_entry->counted){
-               mass += block_get_mass(block_entry->block);
+               Block_t* entry_block = block_from_handle(&world->blocks, block_entry->block);
+               mass += block_get_mass(entry_block);
 
-               auto against_player = block_against_player(block_entry->block, direction, &world->players);
+               auto against_player = block_against_player(entry_block, direction, &world->players);
                if(against_player){
                     mass += PLAYER_MASS;
                }
           }
      }
 
+     if(cached_mass) *cached_mass = mass;
      return mass;
 }
 
@@ -3081,23 +3155,20 @@ Pixel_t block_pos_in_solid_boundary(Position_t pos, BlockCut_t cut, Direction_t
 }
 
 void set_against_blocks_coasting_from_player(Block_t* block, Direction_t direction, World_t* world){
-     auto block_pos = block_get_final_position(block);
-
-     auto against_result = block_against_other_blocks(block_pos,
-                                                      block_get_cut(block),
-                                                      direction, world->block_qt, world->interactive_qt, &world->tilemap);
+     auto against_result = block_against_other_blocks(block, direction, world);
 
      for(S16 a = 0; a < against_result.count; a++){
          auto* against_other = against_result.objects + a;
+         Block_t* against_block = block_from_handle(&world->blocks, against_other->block);
          Direction_t against_direction = direction_rotate_clockwise(direction, against_other->rotations_through_portal);
 
          if(direction_is_horizontal(against_direction)){
-             against_other->block->coast_horizontal = BLOCK_COAST_PLAYER;
+             against_block->coast_horizontal = BLOCK_COAST_PLAYER;
          }else{
-             against_other->block->coast_vertical = BLOCK_COAST_PLAYER;
+             against_block->coast_vertical = BLOCK_COAST_PLAYER;
          }
 
-         set_against_blocks_coasting_from_player(against_other->block, against_direction, world);
+         set_against_blocks_coasting_from_player(against_block, against_direction, world);
      }
 }
 
@@ -3108,7 +3179,7 @@ bool find_and_update_connected_teleported_block(Block_t* block, Direction_t dire
      auto block_cut = block_get_cut(block);
 
      auto against_result = block_against_other_blocks(block_pos + block_pos_delta_vec,
-                                                      block_cut, direction, world->block_qt,
+                                                      block_cut, direction, world->block_qt, &world->blocks,
                                                       world->interactive_qt, &world->tilemap, false);
 
      F32 block_vel = 0;
@@ -3127,8 +3198,9 @@ bool find_and_update_connected_teleported_block(Block_t* block, Direction_t dire
 
          if(!against_other->through_portal && !block->teleport) continue;
 
-         Vec_t against_block_vel_vec = block_get_vel(against_other->block);
-         Vec_t against_block_pos_delta_vec = block_get_pos_delta(against_other->block);
+         Block_t* against_block = block_from_handle(&world->blocks, against_other->block);
+         Vec_t against_block_vel_vec = block_get_vel(against_block);
+         Vec_t against_block_pos_delta_vec = block_get_pos_delta(against_block);
 
          Vec_t rotated_against_vel = vec_rotate_quadrants_counter_clockwise(against_block_vel_vec, against_other->rotations_through_portal);
          Vec_t rotated_against_pos_delta = vec_rotate_quadrants_counter_clockwise(against_block_pos_delta_vec, against_other->rotations_through_portal);
@@ -3146,7 +3218,7 @@ bool find_and_update_connected_teleported_block(Block_t* block, Direction_t dire
 
          if(block_vel != against_block_vel || block_pos_delta != against_block_pos_delta) continue;
 
-         block->connected_teleport.block_index = get_block_index(world, against_other->block);
+         block->connected_teleport.block_index = against_other->block.index;
          block->connected_teleport.direction = direction;
          return true;
      }
@@ -3154,7 +3226,8 @@ bool find_and_update_connected_teleported_block(Block_t* block, Direction_t dire
      return false;
 }
 
-PlayerInBlockRectResult_t player_in_block_rect(Player_t* player, TileMap_t* tilemap, QuadTreeNode_t<Interactive_t>* interactive_qt, QuadTreeNode_t<Block_t>* block_qt){
+PlayerInBlockRectResult_t player_in_block_rect(Player_t* player, TileMap_t* tilemap, QuadTreeNode_t<Interactive_t>* interactive_qt,
+                                               QuadTreeNode_t<Block_t>* block_qt, ObjectArray_t<Block_t>* blocks_array){
      PlayerInBlockRectResult_t result;
 
      auto player_pos = player->teleport ? player->teleport_pos + player->teleport_pos_delta : player->pos + player->pos_delta;
@@ -3171,7 +3244,7 @@ PlayerInBlockRectResult_t player_in_block_rect(Player_t* player, TileMap_t* tile
          auto block_rect = block_get_inclusive_rect(block_pos.pixel, block_get_cut(blocks[b]));
          if(pixel_in_rect(player->pos.pixel, block_rect)){
               PlayerInBlockRectResult_t::Entry_t entry;
-              entry.block = blocks[b];
+              entry.block = block_handle(blocks_array, blocks[b]);
               entry.block_pos = block_pos;
               entry.portal_rotations = 0;
               result.entries.insert(&entry);
@@ -3185,7 +3258,7 @@ PlayerInBlockRectResult_t player_in_block_rect(Player_t* player, TileMap_t* tile
          auto block_rect = block_get_inclusive_rect(found_block->position.pixel, found_block->rotated_cut);
          if(pixel_in_rect(player->pos.pixel, block_rect)){
               PlayerInBlockRectResult_t::Entry_t entry;
-              entry.block = found_block->block;
+              entry.block = block_handle(blocks_array, found_block->block);
               entry.block_pos = found_block->position;
               entry.portal_rotations = found_block->portal_rotations;
               result.entries.insert(&entry);
@@ -3251,3 +3324,403 @@ void world_cache_initial_shallow_world(World_t* world){
      deep_copy(&world->interactives, &world->initial_shallow_world.interactives);
      deep_copy(&world->blocks, &world->initial_shallow_world.blocks);
 }
+
+#define WORLD_SNAPSHOT_ALIGNMENT 16
+
+static size_t world_snapshot_align(size_t offset){
+     return (offset + (WORLD_SNAPSHOT_ALIGNMENT - 1)) & ~(size_t)(WORLD_SNAPSHOT_ALIGNMENT - 1);
+}
+
+template <typename T>
+static void world_snapshot_copy_array(ObjectArray_t<T>* object_array, U8* memory, size_t elements_offset,
+                                      size_t generations_offset){
+     if(object_array->count == 0) return;
+     memcpy(memory + elements_offset, object_array->elements, object_array->count * sizeof(*object_array->elements));
+     memcpy(memory + generations_offset, object_array->generations,
+            object_array->count * sizeof(*object_array->generations));
+}
+
+// keeps the array's allocation when the snapshot fits in it
+template <typename T>
+static bool world_restore_array(ObjectArray_t<T>* object_array, S16 count, U8* memory, size_t elements_offset,
+                                size_t generations_offset){
+     if(!reserve(object_array, count)) return false;
+     object_array->count = count;
+     if(count == 0) return true;
+     memcpy(object_array->elements, memory + elements_offset, count * sizeof(*object_array->elements));
+     memcpy(object_array->generations, memory + generations_offset, count * sizeof(*object_array->generations));
+     return true;
+}
+
+bool world_snapshot(World_t* world, WorldSnapshot_t* snapshot){
+     snapshot->width = world->tilemap.width;
+     snapshot->height = world->tilemap.height;
+     snapshot->player_count = world->players.count;
+     snapshot->block_count = world->blocks.count;
+     snapshot->interactive_count = world->interactives.count;
+
+     size_t size = sizeof(world->arrows);
+     snapshot->tiles_offset = world_snapshot_align(size);
+     size = snapshot->tiles_offset + (size_t)(snapshot->width) * (size_t)(snapshot->height) * sizeof(Tile_t);
+     snapshot->players_offset = world_snapshot_align(size);
+     size = snapshot->players_offset + snapshot->player_count * sizeof(Player_t);
+     snapshot->player_generations_offset = world_snapshot_align(size);
+     size = snapshot->player_generations_offset + snapshot->player_count * sizeof(U16);
+     snapshot->blocks_offset = world_snapshot_align(size);
+     size = snapshot->blocks_offset + snapshot->block_count * sizeof(Block_t);
+     snapshot->block_generations_offset = world_snapshot_align(size);
+     size = snapshot->block_generations_offset + snapshot->block_count * sizeof(U16);
+     snapshot->interactives_offset = world_snapshot_align(size);
+     size = snapshot->interactives_offset + snapshot->interactive_count * sizeof(Interactive_t);
+     snapshot->interactive_generations_offset = world_snapshot_align(size);
+     size = snapshot->interactive_generations_offset + snapshot->interactive_count * sizeof(U16);
+
+     if(size > snapshot->capacity){
+          U8* new_memory = (U8*)(realloc(snapshot->memory, size));
+          if(!new_memory){
+               LOG("%s() failed to realloc %zu bytes\n", __FUNCTION__, size);
+               return false;
+          }
+          snapshot->memory = new_memory;
+          snapshot->capacity = size;
+     }
+
+     memcpy(snapshot->memory, &world->arrows, sizeof(world->arrows));
+
+     memcpy(snapshot->memory + snapshot->tiles_offset, world->tilemap.tiles,
+            tilemap_tile_count(&world->tilemap) * sizeof(Tile_t));
+
+     world_snapshot_copy_array(&world->players, snapshot->memory, snapshot->players_offset,
+                               snapshot->player_generations_offset);
+     world_snapshot_copy_array(&world->blocks, snapshot->memory, snapshot->blocks_offset,
+                               snapshot->block_generations_offset);
+     world_snapshot_copy_array(&world->interactives, snapshot->memory, snapshot->interactives_offset,
+                               snapshot->interactive_generations_offset);
+     return true;
+}
+
+bool world_restore(WorldSnapshot_t* snapshot, World_t* world){
+     if(world->tilemap.width != snapshot->width || world->tilemap.height != snapshot->height){
+          destroy(&world->tilemap);
+          if(!init(&world->tilemap, snapshot->width, snapshot->height)){
+               LOG("%s() failed to allocate %dx%d tilemap\n", __FUNCTION__, snapshot->width, snapshot->height);
+               return false;
+          }
+     }
+
+     // the interactive quad tree only needs rebuilding if the interactives moved in memory or on the map
+     Interactive_t* snapshot_interactives = (Interactive_t*)(snapshot->memory + snapshot->interactives_offset);
+     bool rebuild_interactive_qt = world->interactive_qt == nullptr ||
+                                   world->interactives.count != snapshot->interactive_count ||
+                                   world->interactives.capacity < snapshot->interactive_count;
+     for(S16 i = 0; i < snapshot->interactive_count && !rebuild_interactive_qt; i++){
+          if(world->interactives.elements[i].coord != snapshot_interactives[i].coord) rebuild_interactive_qt = true;
+     }
+
+     memcpy(&world->arrows, snapshot->memory, sizeof(world->arrows));
+
+     memcpy(world->tilemap.tiles, snapshot->memory + snapshot->tiles_offset,
+            tilemap_tile_count(&world->tilemap) * sizeof(Tile_t));
+     tilemap_build_flag_planes(&world->tilemap);
+
+     if(!world_restore_array(&world->players, snapshot->player_count, snapshot->memory, snapshot->players_offset,
+                             snapshot->player_generations_offset)) return false;
+     if(!world_restore_array(&world->blocks, snapshot->block_count, snapshot->memory, snapshot->blocks_offset,
+                             snapshot->block_generations_offset)) return false;
+     if(!world_restore_array(&world->interactives, snapshot->interactive_count, snapshot->memory,
+                             snapshot->interactives_offset, snapshot->interactive_generations_offset)) return false;
+
+     if(rebuild_interactive_qt){
+          quad_tree_free(world->interactive_qt);
+          world->interactive_qt = quad_tree_build(&world->interactives);
+     }
+
+     // blocks are expected to have moved
+     quad_tree_free(world->block_qt);
+     world->block_qt = quad_tree_build(&world->blocks);
+     world_wake_all_blocks(world);
+     return true;
+}
+
+void destroy(WorldSnapshot_t* snapshot){
+     free(snapshot->memory);
+     *snapshot = WorldSnapshot_t{};
+}
+
+// momentum is turned into velocity after the push pass, so whoever receives it has to be simulated for the rest of the frame
+void block_add_horizontal_momentum(World_t* world, Block_t* block, BlockMomentumType_t type, F32 momentum){
+     world_wake_block(world, get_block_index(world, block));
+
+     if(block->horizontal_momentum == BLOCK_MOMENTUM_NONE){
+          block->horizontal_momentum = BLOCK_MOMENTUM_SUM;
+     }
+
+     if(type == BLOCK_MOMENTUM_TYPE_IMPACT){
+          block->impact_momentum.x += momentum;
+     }else if(type == BLOCK_MOMENTUM_TYPE_KICKBACK){
+          block->kickback_momentum.x += momentum;
+     }
+}
+
+void block_add_vertical_momentum(World_t* world, Block_t* block, BlockMomentumType_t type, F32 momentum){
+     world_wake_block(world, get_block_index(world, block));
+
+     if(block->vertical_momentum == BLOCK_MOMENTUM_NONE){
+          block->vertical_momentum = BLOCK_MOMENTUM_SUM;
+     }
+
+     if(type == BLOCK_MOMENTUM_TYPE_IMPACT){
+          block->impact_momentum.y += momentum;
+     }else if(type == BLOCK_MOMENTUM_TYPE_KICKBACK){
+          block->kickback_momentum.y += momentum;
+     }
+}
+
+void world_wake_all_blocks(World_t* world){
+     world->wake_all_blocks = true;
+}
+
+void world_wake_block(World_t* world, S16 block_index){
+     Block_t* block = world->blocks.elements + block_index;
+     if(!block->asleep) return;
+
+     block->asleep = false;
+     block->rest_frames = 0;
+
+     // when everything is simulated, world_settle_blocks() rebuilds the list
+     if(world->all_blocks_awake) return;
+     if(world->awake_block_count >= world->awake_blocks.count) return;
+
+     world->awake_blocks.elements[world->awake_block_count] = block_index;
+     world->awake_block_count++;
+     world->awake_blocks_unsorted = true;
+}
+
+static Rect_t block_wake_rect(Pixel_t pixel){
+     S16 reach = TILE_SIZE_IN_PIXELS + BLOCK_WAKE_DISTANCE_IN_PIXELS;
+     return Rect_t{(S16)(pixel.x - reach), (S16)(pixel.y - reach), (S16)(pixel.x + reach), (S16)(pixel.y + reach)};
+}
+
+// returns how many blocks were found in the rect, disturbing them keeps them awake even if they are at rest
+static S16 wake_blocks_in_rect(World_t* world, Rect_t rect, bool disturb){
+     if(!world->block_qt) return 0;
+
+     S16 block_count = 0;
+     Block_t* blocks[BLOCK_WAKE_MAX_QUERY];
+     quad_tree_find_in(world->block_qt, rect, blocks, &block_count, BLOCK_WAKE_MAX_QUERY);
+
+     for(S16 b = 0; b < block_count; b++){
+          S16 block_index = get_block_index(world, blocks[b]);
+          world_wake_block(world, block_index);
+          if(disturb) blocks[b]->rest_frames = 0;
+     }
+
+     return block_count;
+}
+
+// for things that change what the blocks on or next to a tile are standing on without anything moving
+void world_wake_blocks_near(World_t* world, Coord_t coord){
+     wake_blocks_in_rect(world, block_wake_rect(coord_to_pixel(coord)), true);
+}
+
+static bool lift_is_moving(Lift_t* lift, S8 min_tick, S8 max_tick){
+     if(lift->up) return lift->ticks < max_tick;
+     return lift->ticks > min_tick;
+}
+
+static int awake_block_comparor(const void* a, const void* b){
+     return *(const S16*)(a) - *(const S16*)(b);
+}
+
+void world_update_awake_blocks(World_t* world){
+     world->all_blocks_awake = false;
+     world->blocks_near_portals = false;
+
+     if(world->wake_all_blocks || world->awake_blocks.count != world->blocks.count){
+          resize(&world->awake_blocks, world->blocks.count);
+          for(S16 i = 0; i < world->blocks.count; i++){
+               world->blocks.elements[i].asleep = false;
+               world->blocks.elements[i].rest_frames = 0;
+               world->awake_blocks.elements[i] = i;
+          }
+          world->awake_block_count = world->blocks.count;
+          world->wake_all_blocks = false;
+     }
+
+     // things that are not blocks can disturb blocks at rest
+     for(S16 i = 0; i < world->players.count; i++){
+          Player_t* player = world->players.elements + i;
+          wake_blocks_in_rect(world, block_wake_rect(player->pos.pixel), true);
+          if(player->pushing_block >= 0 && player->pushing_block < world->blocks.count){
+               world_wake_block(world, player->pushing_block);
+          }
+          if(player->prev_pushing_block >= 0 && player->prev_pushing_block < world->blocks.count){
+               world_wake_block(world, player->prev_pushing_block);
+          }
+     }
+
+     for(S16 i = 0; i < ARROW_ARRAY_MAX; i++){
+          Arrow_t* arrow = world->arrows.arrows + i;
+          if(!arrow->alive) continue;
+          wake_blocks_in_rect(world, block_wake_rect(arrow->pos.pixel), true);
+     }
+
+     // anything that changed since last frame without going through impact_ice(), like a wire toggling a popup or portal
+     bool compare_interactive_states = (world->interactive_wake_states.count == world->interactives.count);
+     if(!compare_interactive_states) resize(&world->interactive_wake_states, world->interactives.count);
+
+     for(S16 i = 0; i < world->interactives.count; i++){
+          Interactive_t* interactive = world->interactives.elements + i;
+          Rect_t rect = block_wake_rect(coord_to_pixel(interactive->coord));
+
+          U8 wake_state = interactive_wake_state(interactive);
+          if(compare_interactive_states && world->interactive_wake_states.elements[i] != wake_state){
+               wake_blocks_in_rect(world, rect, true);
+          }
+          if(world->interactive_wake_states.count == world->interactives.count){
+               world->interactive_wake_states.elements[i] = wake_state;
+          }
+
+          if(interactive->type == INTERACTIVE_TYPE_POPUP){
+               if(lift_is_moving(&interactive->popup.lift, 1, POPUP_MAX_LIFT_TICKS)) wake_blocks_in_rect(world, rect, true);
+          }else if(interactive->type == INTERACTIVE_TYPE_DOOR){
+               if(lift_is_moving(&interactive->door.lift, 0, DOOR_MAX_HEIGHT)) wake_blocks_in_rect(world, rect, true);
+          }else if(interactive->type == INTERACTIVE_TYPE_PORTAL && interactive->portal.on){
+               // blocks get cloned and split across portals mid frame, so be safe and simulate everything like we used to
+               if(wake_blocks_in_rect(world, rect, true) > 0) world->blocks_near_portals = true;
+          }
+     }
+
+     // blocks that are mid clone get removed or completed without a portal nearby
+     for(S16 a = 0; a < world->awake_block_count && !world->blocks_near_portals; a++){
+          Block_t* block = world->blocks.elements + world->awake_blocks.elements[a];
+          if(block->clone_start.x > 0) world->blocks_near_portals = true;
+     }
+
+     world->all_blocks_awake = world->blocks_near_portals;
+
+     if(!world->all_blocks_awake){
+          // anything a moving or disturbed block could run into this frame needs to be awake, and so does anything it is
+          // entangled with. Blocks that are awake but were at rest last frame don't wake their neighbors, otherwise
+          // neighbors would keep each other awake forever
+          for(S16 a = 0; a < world->awake_block_count; a++){
+               S16 block_index = world->awake_blocks.elements[a];
+               Block_t* block = world->blocks.elements + block_index;
+               if(block->rest_frames > 0) continue;
+
+               wake_blocks_in_rect(world, block_wake_rect(block->pos.pixel), false);
+
+               S16 entangle_index = block->entangle_index;
+               while(entangle_index != block_index && entangle_index >= 0 && entangle_index < world->blocks.count){
+                    world_wake_block(world, entangle_index);
+                    entangle_index = world->blocks.elements[entangle_index].entangle_index;
+               }
+          }
+
+          world_sort_awake_blocks(world);
+
+          if(world->awake_block_count == world->blocks.count) world->all_blocks_awake = true;
+     }
+}
+
+// keep the order the passes have always seen blocks in. Only call this between passes, never while walking the list
+void world_sort_awake_blocks(World_t* world){
+     if(!world->awake_blocks_unsorted) return;
+     world->awake_blocks_unsorted = false;
+     if(world->all_blocks_awake) return;
+     qsort(world->awake_blocks.elements, world->awake_block_count, sizeof(world->awake_blocks.elements[0]), awake_block_comparor);
+}
+
+bool block_at_rest(Block_t* block){
+     if(block->teleport) return false;
+     if(block->clone_start.x > 0) return false;
+     if(block->vel.x != 0 || block->vel.y != 0) return false;
+     if(block->accel.x != 0 || block->accel.y != 0) return false;
+     if(block->pos_delta.x != 0 || block->pos_delta.y != 0) return false;
+     if(block->horizontal_move.state != MOVE_STATE_IDLING || block->vertical_move.state != MOVE_STATE_IDLING) return false;
+     if(block->stop_on_pixel_x != 0 || block->stop_on_pixel_y != 0) return false;
+     if(block->cur_push_mask != DIRECTION_MASK_NONE || block->prev_push_mask != DIRECTION_MASK_NONE) return false;
+     if(block->horizontal_momentum != BLOCK_MOMENTUM_NONE || block->vertical_momentum != BLOCK_MOMENTUM_NONE) return false;
+
+     // blocks that aren't held up are falling, unless they are already at the bottom of a pit
+     if(!block->held_up && block->pos.z > -HEIGHT_INTERVAL) return false;
+
+     return true;
+}
+
+static void settle_block(Block_t* block){
+     if(block_at_rest(block)){
+          if(block->rest_frames < BLOCK_SLEEP_FRAMES) block->rest_frames++;
+     }else{
+          block->rest_frames = 0;
+     }
+
+     block->asleep = block->rest_frames >= BLOCK_SLEEP_FRAMES;
+}
+
+void world_settle_blocks(World_t* world){
+     if(world->all_blocks_awake){
+          // if blocks were added or removed this frame, everything is woken up next frame anyways
+          if(world->awake_blocks.count != world->blocks.count) return;
+
+          world->awake_block_count = 0;
+          for(S16 i = 0; i < world->blocks.count; i++){
+               Block_t* block = world->blocks.elements + i;
+               settle_block(block);
+               if(block->asleep) continue;
+               world->awake_blocks.elements[world->awake_block_count] = i;
+               world->awake_block_count++;
+          }
+          return;
+     }
+
+     S16 kept_count = 0;
+     for(S16 a = 0; a < world->awake_block_count; a++){
+          S16 block_index = world->awake_blocks.elements[a];
+          Block_t* block = world->blocks.elements + block_index;
+          settle_block(block);
+          if(block->asleep) continue;
+          world->awake_blocks.elements[kept_count] = block_index;
+          kept_count++;
+     }
+     world->awake_block_count = kept_count;
+}
+
+// blocks woken by a pass are counted right away, so the passes after it in the same frame include them
+S16 world_awake_block_count(World_t* world){
+     if(world->all_blocks_awake) return world->blocks.count;
+     return world->awake_block_count;
+}
+
+S16 world_awake_block_index(World_t* world, S16 awake_index){
+     if(world->all_blocks_awake) return awake_index;
+     return world->awake_blocks.elements[awake_index];
+}
+
+// the results depend on where the blocks and players are, so only cache while nothing is being moved, anything that does
+// move them in between needs to call world_clear_block_query_cache()
+void world_begin_block_query_cache(World_t* world){
+     auto* cache = &world->block_query_cache;
+     cache->block_count = world->blocks.count;
+     cache->stack_masses = frame_arena_alloc_array<S16>(cache->block_count);
+     cache->direction_masses = frame_arena_alloc_array<S16>(cache->block_count * BLOCK_MASS_CACHE_DIRECTION_ENTRIES);
+     cache->against_counts = frame_arena_alloc_array<S8>(cache->block_count * DIRECTION_COUNT);
+     cache->againsts = frame_arena_alloc_array<BlockAgainstOther_t>(cache->block_count * DIRECTION_COUNT * MAX_BLOCKS_AGAINST_BLOCK);
+     if(!cache->stack_masses || !cache->direction_masses || !cache->against_counts || !cache->againsts){
+          world_end_block_query_cache(world);
+          return;
+     }
+     world_clear_block_query_cache(world);
+}
+
+void world_clear_block_query_cache(World_t* world){
+     auto* cache = &world->block_query_cache;
+     if(!cache->stack_masses) return;
+     memset(cache->stack_masses, 0xFF, cache->block_count * sizeof(*cache->stack_masses));
+     memset(cache->direction_masses, 0xFF, cache->block_count * BLOCK_MASS_CACHE_DIRECTION_ENTRIES * sizeof(*cache->direction_masses));
+     memset(cache->against_counts, 0xFF, cache->block_count * DIRECTION_COUNT * sizeof(*cache->against_counts));
+}
+
+void world_end_block_query_cache(World_t* world){
+     world->block_query_cache = BlockQueryCache_t{};
+}
@@ -12,12 +12,52 @@
 #include "exit.h"
 #include "static_object_array.h"
 
+#define BLOCK_MASS_CACHE_DIRECTION_ENTRIES (DIRECTION_COUNT * 2)
+
+struct BlockAgainstOther_t;
+
+// memoized block queries, -1 means not calculated yet. The storage comes from the frame arena and only exists between
+// world_begin_block_query_cache() and world_end_block_query_cache()
+struct BlockQueryCache_t{
+     S16* stack_masses = NULL;     // [block]
+     S16* direction_masses = NULL; // [block][direction][require_on_ice]
+
+     // graph of touching blocks, including through portals, filled in as block_against_other_blocks() visits blocks. It is
+     // only a memo for the span of one cache scope, nothing is carried over to the next one or the next frame
+     S8* against_counts = NULL;            // [block][direction]
+     BlockAgainstOther_t* againsts = NULL; // [block][direction][MAX_BLOCKS_AGAINST_BLOCK]
+
+     S16 block_count = 0;
+};
+
 struct ShallowWorld_t{
      TileMap_t tilemap = {};
      ObjectArray_t<Interactive_t> interactives = {};
      ObjectArray_t<Block_t> blocks = {};
 };
 
+// the parts of a world the simulation changes, packed into one allocation so copying a world is a memcpy per part. The
+// allocation is kept and reused by later snapshots that fit in it
+struct WorldSnapshot_t{
+     U8* memory = nullptr;
+     size_t capacity = 0;
+
+     S16 width = 0;
+     S16 height = 0;
+     S16 player_count = 0;
+     S16 block_count = 0;
+     S16 interactive_count = 0;
+
+     // byte offsets into memory, the arrows are at the start
+     size_t tiles_offset = 0;
+     size_t players_offset = 0;
+     size_t player_generations_offset = 0;
+     size_t blocks_offset = 0;
+     size_t block_generations_offset = 0;
+     size_t interactives_offset = 0;
+     size_t interactive_generations_offset = 0;
+};
+
 struct World_t{
      TileMap_t tilemap = {};
      ObjectArray_t<Player_t> players = {};
@@ -35,6 +75,19 @@ struct World_t{
      // TODO: do we still need this ?
      S32 clone_instance = 0;
 
+     // indices of blocks that are not asleep, sorted by world_sort_awake_blocks(). Blocks woken mid frame are appended so
+     // a pass that is walking the list never has its entries shift under it. awake_blocks.count tracks blocks.count so we
+     // know to wake everything when blocks are added or removed
+     ObjectArray_t<S16> awake_blocks = {};
+     S16 awake_block_count = 0;
+     bool awake_blocks_unsorted = false;
+     bool wake_all_blocks = true;
+     bool all_blocks_awake = true;
+     bool blocks_near_portals = false; // blocks may be cloned or split this frame
+     ObjectArray_t<U8> interactive_wake_states = {}; // what each interactive last looked like to the blocks around it
+
+     BlockQueryCache_t block_query_cache;
+
      // These aren't really the world, more like the game, but we put them here for convenience.
      S16 current_room = -1;
      S16 previous_room = -1;
@@ -46,6 +99,10 @@ struct World_t{
 
 #define MAX_TELEPORT_POSITION_RESULTS 4
 
+#define BLOCK_SLEEP_FRAMES 2
+#define BLOCK_WAKE_DISTANCE_IN_PIXELS TILE_SIZE_IN_PIXELS
+#define BLOCK_WAKE_MAX_QUERY 256
+
 struct TeleportPosition_t{
      Position_t pos;
      Vec_t delta;
@@ -102,7 +159,7 @@ struct BlockElasticCollision_t{
 #define BLOCK_PUSH_MAX_AGAINSTS 8
 
 struct BlockPushedAgainst_t{
-     Block_t* block = NULL;
+     BlockHandle_t block;
      Direction_t direction = DIRECTION_COUNT;
 };
 
@@ -140,7 +197,7 @@ struct LogMapNumberResult_t{
 
 struct PlayerInBlockRectResult_t{
      struct Entry_t{
-          Block_t* block = nullptr;
+          BlockHandle_t block;
           Position_t block_pos;
           S8 portal_rotations = 0;
      };
@@ -224,7 +281,8 @@ Pixel_t block_pos_in_solid_boundary(Position_t pos, BlockCut_t cut, Direction_t
 void set_against_blocks_coasting_from_player(Block_t* block, Direction_t direction, World_t* world);
 bool find_and_update_connected_teleported_block(Block_t* block, Direction_t direction, World_t* world);
 
-PlayerInBlockRectResult_t player_in_block_rect(Player_t* player, TileMap_t* tilemap, QuadTreeNode_t<Interactive_t>* interactive_qt, QuadTreeNode_t<Block_t>* block_qt);
+PlayerInBlockRectResult_t player_in_block_rect(Player_t* player, TileMap_t* tilemap, QuadTreeNode_t<Interactive_t>* interactive_qt,
+                                               QuadTreeNode_t<Block_t>* block_qt, ObjectArray_t<Block_t>* blocks_array);
 
 void world_expand_editor_camera(World_t* world);
 void world_shrink_editor_camera(World_t* world);
@@ -232,3 +290,23 @@ void world_move_editor_camera(World_t* world, Direction_t direction);
 void world_recalculate_camera_on_world_bounds(World_t* world);
 
 void world_cache_initial_shallow_world(World_t* world);
+
+bool world_snapshot(World_t* world, WorldSnapshot_t* snapshot);
+bool world_restore(WorldSnapshot_t* snapshot, World_t* world);
+void destroy(WorldSnapshot_t* snapshot);
+
+void world_wake_all_blocks(World_t* world);
+void world_wake_block(World_t* world, S16 block_index);
+void world_wake_blocks_near(World_t* world, Coord_t coord);
+void block_add_horizontal_momentum(World_t* world, Block_t* block, BlockMomentumType_t type, F32 momentum);
+void block_add_vertical_momentum(World_t* world, Block_t* block, BlockMomentumType_t type, F32 momentum);
+void world_update_awake_blocks(World_t* world);
+void world_sort_awake_blocks(World_t* world);
+void world_settle_blocks(World_t* world);
+bool block_at_rest(Block_t* block);
+S16 world_awake_block_count(World_t* world);
+S16 world_awake_block_index(World_t* world, S16 awake_index);
+
+void world_begin_block_query_cache(World_t* world);
+void world_clear_block_query_cache(World_t* world);
+void world_end_block_query_cache(World_t* world);